@@ -0,0 +1,179 @@
+/*
+	DiscordCoreAPI, A bot library for Discord, written in C++, and featuring explicit multithreading through the usage of custom, asynchronous C++ CoRoutines.
+
+	Copyright 2021, 2022 Chris M. (RealTimeChris)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 2.1 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+	USA
+*/
+/// ClusterCoordinator.hpp - Header for sharing one bot's shards between several processes.
+/// Oct 17, 2022
+/// https://discordcoreapi.com
+/// \file ClusterCoordinator.hpp
+
+#pragma once
+
+#include <discordcoreapi/WebSocketEntities.hpp>
+
+#ifdef __linux__
+	#include <sys/un.h>
+#endif
+
+namespace DiscordCoreInternal {
+
+	/// \brief One end of a connection between the coordinator and a worker, over which each message is a single line of text.
+	class DiscordCoreAPI_Dll ClusterConnection {
+	  public:
+		ClusterConnection(SOCKET socketNew) noexcept;
+
+		bool sendMessage(const std::string& message) noexcept;
+
+		/// \brief Reads whatever has arrived, and appends the complete messages among it. Returns false once the other end is gone.
+		bool receiveMessages(std::vector<std::string>& messages) noexcept;
+
+		SOCKET getSocket() noexcept;
+
+	  protected:
+		static constexpr uint64_t maxMessageSize{ 4096 };
+
+		std::string inputBuffer{};
+		std::mutex writeMutex{};
+		SOCKETWrapper socket{};
+	};
+
+	struct DiscordCoreAPI_Dll ShardRange {
+		uint32_t startingShard{};
+		uint32_t shardCount{};
+	};
+
+	/// \brief Hands out shard ranges and identify windows to the worker processes that connect to it over a Unix domain socket,
+	/// and hands the ranges of the workers that disconnect, or go silent, to the ones that remain. A worker holds its ranges on a lease
+	/// that each of its pings renews, so a silent worker's ranges are only handed on once its lease has run out, and it has stopped them.
+	class DiscordCoreAPI_Dll ClusterCoordinator {
+	  public:
+		ClusterCoordinator(DiscordCoreAPI::ConfigManager* configManagerNew, uint32_t maxConcurrencyNew) noexcept;
+
+		/// \brief Serves the workers until doWeQuit is set. Returns false if the socket could not be listened on.
+		bool run(std::atomic_bool* doWeQuit) noexcept;
+
+	  protected:
+		struct Worker {
+			std::unique_ptr<ClusterConnection> connection{};
+			DiscordCoreAPI::StopWatch<Milliseconds> stopWatch{ 0ms };///< Time since the worker was last heard from.
+			std::vector<ShardRange> shardRanges{};
+			bool haveWeRegistered{};
+			uint32_t shardCount{};
+			int32_t processId{};
+		};
+
+		/// \brief An identify bucket shared by every worker, which a single shard at a time may hold for its identify.
+		struct ClusterIdentifyBucket : public IdentifyBucket {
+			std::deque<std::pair<uint32_t, uint32_t>> waitingShards{};///< The worker, and the shard, of each identify waiting its turn.
+			DiscordCoreAPI::StopWatch<Milliseconds> heldStopWatch{ 30000ms };
+			uint32_t holderWorkerId{};
+			uint32_t holderShardId{};
+			bool isItHeld{};
+		};
+
+		/// \brief The ranges of a worker that went silent, held back until that worker's lease has run out.
+		struct FencedRanges {
+			DiscordCoreAPI::StopWatch<Milliseconds> stopWatch{ 0ms };
+			std::vector<ShardRange> shardRanges{};
+		};
+
+		std::unique_ptr<ClusterIdentifyBucket[]> identifyBuckets{};
+		std::deque<FencedRanges> fencedRanges{};
+		std::unordered_map<uint32_t, Worker> workers{};
+		DiscordCoreAPI::ConfigManager* configManager{};
+		std::deque<ShardRange> orphanedRanges{};///< Ranges whose workers are gone.
+		std::deque<ShardRange> initialRanges{};///< Ranges that no worker has run yet.
+		uint32_t maxConcurrency{ 1 };
+		uint32_t workerCount{};
+
+		void onMessage(uint32_t workerId, const std::string& message) noexcept;
+
+		void removeWorker(uint32_t workerId, const std::string& reason, bool doWeFence = false) noexcept;
+
+		void releaseFencedRanges() noexcept;
+
+		bool assignShardRange(uint32_t workerId, const ShardRange& shardRange) noexcept;
+
+		void assignOrphanedRanges() noexcept;
+
+		void grantIdentifyWindows() noexcept;
+	};
+
+	/// \brief A worker's end of the cluster: it registers with the coordinator, keeps telling it that the worker lives, starts the shard ranges
+	/// it is handed, and asks it for the identify windows of those shards. It quits once the coordinator stops renewing its lease.
+	class DiscordCoreAPI_Dll ClusterClient {
+	  public:
+		ClusterClient(DiscordCoreAPI::DiscordCoreClient* discordCoreClientNew, std::atomic_bool* doWeQuitNew) noexcept;
+
+		/// \brief Registers with the coordinator. Returns the bot's total shard count, or 0 if the coordinator could not be reached.
+		uint32_t connect() noexcept;
+
+		/// \brief Starts taking on the shard ranges that the coordinator hands over, once the client is ready to run them.
+		void start() noexcept;
+
+		/// \brief Asks the coordinator for a shard's identify window, unless it has been asked already. Returns false if the coordinator is gone.
+		bool requestIdentifyWindow(uint32_t shardId) noexcept;
+
+		/// \brief Takes the shard's identify window if the coordinator has granted it, without waiting for it.
+		bool takeIdentifyWindow(uint32_t shardId) noexcept;
+
+		/// \brief Lets the coordinator start the bucket's next window, once the shard has identified or given up on it.
+		void releaseIdentifyWindow(uint32_t shardId) noexcept;
+
+		~ClusterClient() noexcept;
+
+	  protected:
+		DiscordCoreAPI::DiscordCoreClient* discordCoreClient{ nullptr };
+		std::unique_ptr<ClusterConnection> connection{ nullptr };
+		std::unique_ptr<std::jthread> taskThread{ nullptr };
+		std::unordered_set<uint32_t> requestedShards{};
+		std::unordered_set<uint32_t> grantedShards{};
+		std::vector<std::string> pendingMessages{};
+		std::atomic_bool* doWeQuit{ nullptr };
+		std::mutex accessMutex{};
+		bool areWeConnected{};
+
+		void onMessage(const std::string& message) noexcept;
+
+		void onDisconnected(const std::string& reason) noexcept;
+
+		void run(std::stop_token token) noexcept;
+	};
+
+	/// \brief Holds a shard's cluster-wide identify window for as long as it lives, if the coordinator has granted it, and otherwise asks
+	/// for it, so that the shard can try again later. Does nothing outside of a cluster.
+	class DiscordCoreAPI_Dll ClusterIdentifyLock {
+	  public:
+		ClusterIdentifyLock(ClusterClient* clusterClientNew, uint32_t shardIdNew) noexcept;
+
+		/// \brief Whether the shard may go ahead and identify.
+		operator bool() noexcept;
+
+		/// \brief Hands the window over to the caller, who is then to release it through the returned client, if there is one.
+		ClusterClient* release() noexcept;
+
+		~ClusterIdentifyLock() noexcept;
+
+	  protected:
+		ClusterClient* clusterClient{ nullptr };
+		bool haveWeAcquired{};
+		uint32_t shardId{};
+	};
+
+}// namespace DiscordCoreInternal
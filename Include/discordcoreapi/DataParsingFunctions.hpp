@@ -26,7 +26,9 @@
 #pragma once
 
 #include <simdjson.h>
+#include <charconv>
 #include <map>
+#include <bit>
 
 namespace DiscordCoreAPI {
 
@@ -40,6 +42,80 @@ namespace DiscordCoreAPI {
 		bool didItSucceed{};
 	};
 
+	/// \brief A non-owning cursor over a single ETF term, for reading entities straight out of a gateway payload.
+	class DiscordCoreAPI_Dll EtfValue {
+	  public:
+		EtfValue() noexcept = default;
+
+		EtfValue(std::string_view dataNew, uint64_t offSetNew) noexcept;
+
+		/// \brief Calls function(key, value) for every pair of a map, in the order they were sent.
+		template<typename FTy> void forEachField(FTy&& function) const {
+			if (this->getType() != EtfType::Map_Ext) {
+				return;
+			}
+			uint64_t offSetNew{ this->offSet + 1 };
+			uint32_t length = this->readBits<uint32_t>(offSetNew);
+			for (uint32_t x = 0; x < length; ++x) {
+				EtfValue key{ this->dataBuffer, offSetNew };
+				EtfValue value{ this->dataBuffer, key.getEndOffset() };
+				offSetNew = value.getEndOffset();
+				function(key.getStringView(), value);
+			}
+		}
+
+		/// \brief Calls function(value) for every element of a list.
+		template<typename FTy> void forEachElement(FTy&& function) const {
+			if (this->getType() != EtfType::List_Ext) {
+				return;
+			}
+			uint64_t offSetNew{ this->offSet + 1 };
+			uint32_t length = this->readBits<uint32_t>(offSetNew);
+			for (uint32_t x = 0; x < length; ++x) {
+				EtfValue value{ this->dataBuffer, offSetNew };
+				offSetNew = value.getEndOffset();
+				function(value);
+			}
+		}
+
+		EtfValue operator[](std::string_view key) const;
+
+		std::string_view getStringView() const;
+
+		uint64_t getEndOffset() const;
+
+		std::string getString() const;
+
+		uint64_t getUint64() const;
+
+		EtfType getType() const;
+
+		int64_t getInt64() const;
+
+		double getFloat() const;
+
+		Snowflake getId() const;
+
+		bool getBool() const;
+
+		bool isNull() const;
+
+	  protected:
+		std::string_view dataBuffer{};
+		uint64_t offSet{};
+
+		template<typename RTy> RTy readBits(uint64_t& offSetNew) const {
+			if (offSetNew + sizeof(RTy) > this->dataBuffer.size()) {
+				throw DCAException{ "EtfValue::readBits() Error: Read past end of ETF buffer." };
+			}
+			RTy newValue{};
+			std::memcpy(&newValue, this->dataBuffer.data() + offSetNew, sizeof(RTy));
+			offSetNew += sizeof(RTy);
+			reverseByteOrder<RTy>(newValue);
+			return newValue;
+		}
+	};
+
 	bool getObject(simdjson::ondemand::value& object, const char* key, simdjson::ondemand::value jsonObjectData);
 
 	bool getArray(simdjson::ondemand::array& array, const char* key, simdjson::ondemand::value jsonObjectData);
@@ -29,10 +29,12 @@
 #include <discordcoreapi/ApplicationCommandEntities.hpp>
 #include <discordcoreapi/AutoModerationEntities.hpp>
 #include <discordcoreapi/ChannelEntities.hpp>
+#include <discordcoreapi/ClusterCoordinator.hpp>
 #include <discordcoreapi/CoRoutine.hpp>
 #include <discordcoreapi/CommandController.hpp>
 #include <discordcoreapi/EventEntities.hpp>
 #include <discordcoreapi/EventManager.hpp>
+#include <discordcoreapi/GatewayProxy.hpp>
 #include <discordcoreapi/GuildEntities.hpp>
 #include <discordcoreapi/GuildMemberEntities.hpp>
 #include <discordcoreapi/GuildScheduledEventEntities.hpp>
@@ -104,6 +106,8 @@ namespace DiscordCoreAPI {
 	  public:
 		friend class DiscordCoreInternal::WebSocketClient;
 		friend class DiscordCoreInternal::BaseSocketAgent;
+		friend class DiscordCoreInternal::GatewayProxyConsumer;
+		friend class DiscordCoreInternal::ClusterClient;
 		friend class DiscordCoreInternal::WebSocketCore;
 		friend class VoiceConnection;
 		friend class GuildData;
@@ -146,6 +150,42 @@ namespace DiscordCoreAPI {
 		/// \returns Milliseconds A count, in milliseconds, since the bot has come online.
 		Milliseconds getTotalUpTime();
 
+		/// \brief For collecting the startup timings of each of this process's shards.
+		/// \returns std::vector<ShardStartupData> One entry for each shard that has connected at least once.
+		std::vector<ShardStartupData> getShardStartupData();
+
+		/// \brief For collecting how many TLS handshakes, gateway and REST alike, resumed a cached session.
+		/// \returns TlsSessionCacheData The hit and miss counts since startup.
+		static TlsSessionCacheData getTlsSessionCacheData();
+
+		/// \brief For collecting the depth, drop and write counts of each shard's outbound gateway queue.
+		/// \returns std::vector<GatewaySendQueueData> One entry for each shard run by this process.
+		std::vector<GatewaySendQueueData> getGatewaySendQueueData();
+
+		/// \brief For collecting the heartbeat round trip, dispatch latency, and frame parse time percentiles of each shard.
+		/// \returns std::vector<ShardLatencyData> One entry for each shard run by this process.
+		std::vector<ShardLatencyData> getShardLatencyData();
+
+		/// \brief For collecting how much work each shard has cost the thread that runs it.
+		/// \returns std::vector<ShardLoadData> One entry for each shard run by this process.
+		std::vector<ShardLoadData> getShardLoadData();
+
+		/// \brief For collecting how many events each shard has kept from the handlers under DiscordCoreClientConfig::eventBudgets.
+		/// \returns std::vector<EventShedData> One entry for each budgeted event type of each shard run by this process.
+		std::vector<EventShedData> getEventShedData();
+
+		/// \brief For moving a live shard onto another of this process's shard threads, without reconnecting it.
+		/// \param shardId The shard to move.
+		/// \param baseSocketAgent The thread to move it onto, as in ShardLoadData::baseSocketAgent.
+		/// \returns bool Whether the move was queued. A shard that has yet to authenticate stays where it is.
+		bool migrateShard(uint32_t shardId, uint32_t baseSocketAgent);
+
+		/// \brief For handing the dispatches that a shard journaled before this process started back to the EventManager, oldest first.
+		/// \param shardId The shard whose journal to replay.
+		/// \param receivedAfter Only the dispatches received after this, in milliseconds since the epoch, are handed over.
+		/// \returns uint64_t The number of dispatches handed over.
+		uint64_t replayEventJournal(uint32_t shardId, Milliseconds receivedAfter);
+
 		/// \brief For collecting a copy of the current bot's User.
 		/// \returns BotUser An instance of BotUser.
 		static BotUser getBotUser();
@@ -156,18 +196,39 @@ namespace DiscordCoreAPI {
 		~DiscordCoreClient() noexcept;
 
 	  protected:
+		/// \brief A gateway session read from the session store, waiting for its shard to be handed to this process.
+		struct StoredSession {
+			std::string sessionId{};
+			std::string resumeUrl{};
+			uint32_t lastNumberReceived{};
+		};
+
 		static BotUser currentUser;
 
-		std::unordered_map<uint32_t, std::unique_ptr<DiscordCoreInternal::BaseSocketAgent>> baseSocketAgentsMap{};
+		std::unordered_map<uint32_t, std::unique_ptr<DiscordCoreInternal::BaseSocketAgent>>
+			baseSocketAgentsMap{};///< Filled once by instantiateWebSockets(), and only looked up with find() after that, so it is read without a lock.
+		std::unordered_map<uint32_t, DiscordCoreInternal::WebSocketClient*> shardsById{};///< Added to as this process is handed shards.
+		std::unordered_map<uint32_t, uint64_t> lastShardLoads{};
+		std::unique_ptr<DiscordCoreInternal::GatewayProxyPublisher> gatewayProxyPublisher{ nullptr };
+		std::unique_ptr<DiscordCoreInternal::GatewayProxyConsumer> gatewayProxyConsumer{ nullptr };
+		std::unique_ptr<DiscordCoreInternal::ClusterClient> clusterClient{ nullptr };
+		std::unique_ptr<std::jthread> rebalanceThread{ nullptr };
+		std::unique_ptr<DiscordCoreInternal::SerialTaskPool> dispatchPool{ nullptr };
 		std::unique_ptr<DiscordCoreInternal::HttpsClient> httpsClient{ nullptr };
 		std::deque<CreateApplicationCommandData> commandsToRegister{};
-		StopWatch<Milliseconds> connectionStopWatch{ 5250ms };
+		std::unique_ptr<DiscordCoreInternal::IdentifyBucket[]> identifyBuckets{};
+		std::unordered_map<uint32_t, ShardStartupData> shardStartupData{};
+		std::unordered_map<uint32_t, StoredSession> storedSessions{};///< Read from the session store once, on the first addShards() call.
 #ifdef _WIN32
 		DiscordCoreInternal::WSADataWrapper theWSAData{};
 #endif
 		CommandController commandController{ this };
-		std::atomic_bool isItSafeToConnect{ true };
+		std::shared_mutex shardsByIdMutex{};
+		std::mutex shardStartupMutex{};
+		std::mutex storedSessionsMutex{};
+		bool haveWeLoadedSessions{};
 		Milliseconds startupTimeSinceEpoch{};
+		uint32_t maxConcurrency{ 1 };
 		ConfigManager configManager{};
 		EventManager eventManager{};///< An event-manager, for hooking into Discord-API-Events sent over the Websockets.
 		bool didWeStartCorrectly{};
@@ -177,6 +238,22 @@ namespace DiscordCoreAPI {
 		GatewayBotData getGateWayBot();
 
 		bool instantiateWebSockets();
+
+		/// \brief Takes the place of the shards, in a gateway proxy consumer.
+		bool instantiateGatewayProxyConsumer();
+
+		/// \brief Creates the shards of a range, spread across the agents, and connects them.
+		void addShards(uint32_t startingShard, uint32_t shardCount);
+
+		/// \brief Finds a shard, whichever agent it is currently on.
+		DiscordCoreInternal::WebSocketClient* getShard(uint32_t shardId);
+
+		/// \brief Moves the shard that best evens out the load of the busiest and the idlest agents, as measured since the last call.
+		void rebalanceShards();
+
+		void loadGatewaySessions();
+
+		void saveGatewaySessions();
 	};
 	/**@}*/
 }// namespace DiscordCoreAPI
@@ -56,6 +56,10 @@ namespace DiscordCoreInternal {
 			return newValue;
 		}
 
+		static char* escapeCharacters(const char* data, size_t length, char* outPtr) noexcept;
+
+		static char* escapeCharacter(const char value, char* outPtr) noexcept;
+
 		void writeCharacters(const char* data, size_t length);
 
 		void writeCharactersFromBuffer(uint32_t length);
@@ -0,0 +1,111 @@
+/*
+	DiscordCoreAPI, A bot library for Discord, written in C++, and featuring explicit multithreading through the usage of custom, asynchronous C++ CoRoutines.
+
+	Copyright 2021, 2022 Chris M. (RealTimeChris)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 2.1 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+	USA
+*/
+/// EventJournal.hpp - Header for the memory-mapped journal of each shard's dispatches.
+/// Oct 17, 2022
+/// https://discordcoreapi.com
+/// \file EventJournal.hpp
+
+#pragma once
+
+#include <discordcoreapi/FoundationEntities.hpp>
+#include <filesystem>
+#include <future>
+
+#ifdef __linux__
+	#include <sys/mman.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+namespace DiscordCoreInternal {
+
+	/// \brief Opens each segment of a journal.
+	struct DiscordCoreAPI_Dll EventJournalSegmentHeader {
+		static constexpr uint32_t currentMagic{ 0x4A414344 };///< "DCAJ".
+		static constexpr uint32_t currentVersion{ 1 };
+
+		uint32_t magic{ currentMagic };
+		uint32_t version{ currentVersion };
+		uint32_t shardId{};
+		DiscordCoreAPI::TextFormat textFormat{};///< The format that the segment's payloads are in, as they came off of the gateway.
+	};
+
+	/// \brief Precedes each payload in a segment. The size is written last, so that a record the process died in the middle of reads as the end.
+	struct DiscordCoreAPI_Dll EventJournalRecord {
+		uint32_t size{};
+		uint32_t sequence{};
+		int64_t receivedTime{};///< Milliseconds since the epoch.
+	};
+
+	/// \brief An append-only journal of the dispatches of a single shard, spread across a bounded number of memory-mapped segment files, so that
+	/// the dispatches outlive the process that received them.
+	class DiscordCoreAPI_Dll EventJournal {
+	  public:
+		using RecordCallback = std::function<void(DiscordCoreAPI::TextFormat, const EventJournalRecord&, std::string_view)>;
+
+		EventJournal(DiscordCoreAPI::ConfigManager* configManagerNew, uint32_t shardIdNew) noexcept;
+
+		/// \brief Copies a payload into the current segment, moving on to the next segment once it is full.
+		void append(uint32_t sequence, std::string_view payload) noexcept;
+
+		/// \brief The first segment that this journal writes to. Every segment before it was written before this journal was opened.
+		uint64_t getStartingSegment() noexcept;
+
+		/// \brief Hands each of a shard's journaled payloads to the callback, oldest first, from the segments before endingSegment.
+		/// \returns uint64_t The number of records handed over.
+		static uint64_t readRecords(const std::string& directory, uint32_t shardId, uint64_t endingSegment, RecordCallback callback) noexcept;
+
+		~EventJournal() noexcept;
+
+	  protected:
+		struct Segment {
+			char* data{ nullptr };
+			uint64_t index{};
+			uint64_t size{};
+		};
+
+		DiscordCoreAPI::ConfigManager* configManager{ nullptr };
+		std::future<Segment> nextSegment{};///< Opened off of the shard's thread, so that moving on to it costs the shard no more than a swap.
+		Segment currentSegment{};
+		uint64_t startingSegment{};
+		uint64_t segmentOffset{};
+		std::string directory{};
+		uint64_t segmentSize{};
+		uint32_t maxSegments{};
+		uint32_t shardId{};
+
+		/// \brief Creates, maps and pre-faults a segment, and deletes whichever of the shard's segments it leaves more than maxSegments back.
+		/// Safe to call from any thread.
+		Segment openSegment(uint64_t segmentIndex, uint64_t size) noexcept;
+
+		/// \brief Moves on to the next segment, making sure that it has room for a record of recordSize bytes.
+		void rotateSegment(uint64_t recordSize) noexcept;
+
+		void prepareNextSegment() noexcept;
+
+		static void closeSegment(Segment& segment) noexcept;
+
+		static std::vector<uint64_t> getSegments(const std::string& directory, uint32_t shardId) noexcept;
+
+		static std::string getSegmentPath(const std::string& directory, uint32_t shardId, uint64_t segmentIndex) noexcept;
+	};
+
+}// namespace DiscordCoreInternal
@@ -89,6 +89,8 @@ namespace DiscordCoreAPI {
 	struct DiscordCoreAPI_Dll OnChannelCreationData {
 		std::unique_ptr<ChannelData> channel{ std::make_unique<ChannelData>() };///< The new Channel.
 		OnChannelCreationData(DiscordCoreInternal::WebSocketMessage& message, simdjson::ondemand::value data);
+		OnChannelCreationData(ChannelData&& channelNew);
+		static void updateCache(ChannelData& channelNew);
 		OnChannelCreationData& operator=(const OnChannelCreationData& other);
 		OnChannelCreationData(const OnChannelCreationData& other);
 	};
@@ -97,6 +99,8 @@ namespace DiscordCoreAPI {
 	struct DiscordCoreAPI_Dll OnChannelUpdateData {
 		std::unique_ptr<ChannelData> channel{ std::make_unique<ChannelData>() };///< The new Channel.
 		OnChannelUpdateData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal);
+		OnChannelUpdateData(ChannelData&& channelNew);
+		static void updateCache(ChannelData& channelNew);
 		OnChannelUpdateData& operator=(const OnChannelUpdateData& other);
 		OnChannelUpdateData(const OnChannelUpdateData& other);
 	};
@@ -105,6 +109,8 @@ namespace DiscordCoreAPI {
 	struct DiscordCoreAPI_Dll OnChannelDeletionData {
 		std::unique_ptr<ChannelData> channel{ std::make_unique<ChannelData>() };///< The deleted Channel.
 		OnChannelDeletionData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal);
+		OnChannelDeletionData(ChannelData&& channelNew);
+		static void updateCache(ChannelData& channelNew);
 		OnChannelDeletionData& operator=(const OnChannelDeletionData&);
 		OnChannelDeletionData(const OnChannelDeletionData&);
 	};
@@ -155,6 +161,8 @@ namespace DiscordCoreAPI {
 	struct DiscordCoreAPI_Dll OnGuildCreationData {
 		std::unique_ptr<GuildData> guild{ std::make_unique<GuildData>() };///< The new Guild.
 		OnGuildCreationData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal, DiscordCoreClient*);
+		OnGuildCreationData(GuildData&& guildNew, DiscordCoreClient*);
+		static void updateCache(GuildData& guildNew, DiscordCoreClient*);
 		OnGuildCreationData& operator=(const OnGuildCreationData&);
 		OnGuildCreationData(const OnGuildCreationData&);
 	};
@@ -163,6 +171,8 @@ namespace DiscordCoreAPI {
 	struct DiscordCoreAPI_Dll OnGuildUpdateData {
 		std::unique_ptr<GuildData> guild{ std::make_unique<GuildData>() };///< The new Guild.
 		OnGuildUpdateData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal, DiscordCoreClient*);
+		OnGuildUpdateData(GuildData&& guildNew, DiscordCoreClient*);
+		static void updateCache(GuildData& guildNew, DiscordCoreClient*);
 		OnGuildUpdateData& operator=(const OnGuildUpdateData&);
 		OnGuildUpdateData(const OnGuildUpdateData&);
 	};
@@ -171,6 +181,8 @@ namespace DiscordCoreAPI {
 	struct DiscordCoreAPI_Dll OnGuildDeletionData {
 		std::unique_ptr<GuildData> guild{ std::make_unique<GuildData>() };///< The deleted Guild.
 		OnGuildDeletionData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal, DiscordCoreClient*);
+		OnGuildDeletionData(GuildData&& guildNew);
+		static void updateCache(GuildData& guildNew);
 		OnGuildDeletionData& operator=(const OnGuildDeletionData&);
 		OnGuildDeletionData(const OnGuildDeletionData&);
 	};
@@ -212,6 +224,8 @@ namespace DiscordCoreAPI {
 		std::unique_ptr<GuildMemberData> guildMember{ std::make_unique<GuildMemberData>() };///< The new GuildMember.
 		DiscordCoreClient* discordCoreClient{ nullptr };
 		OnGuildMemberAddData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal, DiscordCoreClient*);
+		OnGuildMemberAddData(GuildMemberData&& guildMemberNew, DiscordCoreClient*);
+		static void updateCache(GuildMemberData& guildMemberNew);
 		OnGuildMemberAddData& operator=(const OnGuildMemberAddData&);
 		OnGuildMemberAddData(const OnGuildMemberAddData&);
 	};
@@ -220,6 +234,8 @@ namespace DiscordCoreAPI {
 	struct DiscordCoreAPI_Dll OnGuildMemberUpdateData {
 		std::unique_ptr<GuildMemberData> guildMember{ std::make_unique<GuildMemberData>() };///< The new GuildMember.
 		OnGuildMemberUpdateData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal, DiscordCoreClient*);
+		OnGuildMemberUpdateData(GuildMemberData&& guildMemberNew, DiscordCoreClient*);
+		static void updateCache(GuildMemberData& guildMemberNew);
 		OnGuildMemberUpdateData& operator=(const OnGuildMemberUpdateData&);
 		OnGuildMemberUpdateData(const OnGuildMemberUpdateData&);
 	};
@@ -230,6 +246,7 @@ namespace DiscordCoreAPI {
 		DiscordCoreClient* discordCoreClient{ nullptr };
 		Snowflake guildId{};///< The id of the Guild from which they were removed.
 		OnGuildMemberRemoveData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal, DiscordCoreClient*);
+		static void updateCache(Snowflake guildIdNew, UserData& userNew);
 		OnGuildMemberRemoveData& operator=(const OnGuildMemberRemoveData&);
 		OnGuildMemberRemoveData(const OnGuildMemberRemoveData&);
 	};
@@ -238,6 +255,7 @@ namespace DiscordCoreAPI {
 	struct DiscordCoreAPI_Dll OnGuildMembersChunkData {
 		GuildMembersChunkEventData chunkEventData{};///< GuildMembersChunkEventData structure.
 		OnGuildMembersChunkData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal);
+		OnGuildMembersChunkData(GuildMembersChunkEventData&& chunkEventDataNew);
 	};
 
 	/// \brief Data that is received as part of a Role creation event.
@@ -245,6 +263,7 @@ namespace DiscordCoreAPI {
 		std::unique_ptr<RoleData> role{ std::make_unique<RoleData>() };///< The new Role.
 		Snowflake guildId{};///< The id of the Guild within which the Role was created.
 		OnRoleCreationData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal);
+		static void updateCache(Snowflake guildIdNew, RoleData& roleNew);
 		OnRoleCreationData& operator=(const OnRoleCreationData&);
 		OnRoleCreationData(const OnRoleCreationData&);
 	};
@@ -254,6 +273,7 @@ namespace DiscordCoreAPI {
 		std::unique_ptr<RoleData> role{ std::make_unique<RoleData>() };///< The new Role.
 		Snowflake guildId{};///< The id of the Guild within which the Role was updated.
 		OnRoleUpdateData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal);
+		static void updateCache(Snowflake guildIdNew, RoleData& roleNew);
 		OnRoleUpdateData& operator=(const OnRoleUpdateData&);
 		OnRoleUpdateData(const OnRoleUpdateData&);
 	};
@@ -263,6 +283,7 @@ namespace DiscordCoreAPI {
 		std::unique_ptr<RoleData> role{ std::make_unique<RoleData>() };///< The deleted Role.
 		Snowflake guildId{};///< The id of the Guild from which the Role was deleted.
 		OnRoleDeletionData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal);
+		static void updateCache(Snowflake guildIdNew, Snowflake roleIdNew);
 		OnRoleDeletionData& operator=(const OnRoleDeletionData&);
 		OnRoleDeletionData(const OnRoleDeletionData&);
 	};
@@ -404,6 +425,8 @@ namespace DiscordCoreAPI {
 	struct DiscordCoreAPI_Dll OnPresenceUpdateData {
 		PresenceUpdateData presenceData{};///< PresenceUpdateData..
 		OnPresenceUpdateData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal);
+		OnPresenceUpdateData(PresenceUpdateData&& presenceDataNew);
+		static void updateCache(PresenceUpdateData& presenceDataNew);
 	};
 
 	/// \brief Data that is received as part of a StageInstance creation event.
@@ -443,6 +466,7 @@ namespace DiscordCoreAPI {
 		VoiceStateData voiceStateData{};///< VoiceStateData for the new voice state.
 		OnVoiceStateUpdateData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal,
 			DiscordCoreInternal::WebSocketClient* sslShard);
+		static void updateCache(VoiceStateData& voiceStateDataNew, DiscordCoreInternal::WebSocketClient* sslShard);
 	};
 
 	/// \brief Data that is received as part of a voice server update event.
@@ -452,6 +476,8 @@ namespace DiscordCoreAPI {
 		std::string token{};///< The token of the server update event.
 		OnVoiceServerUpdateData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal,
 			DiscordCoreInternal::WebSocketClient* sslShard);
+		static void updateCache(Snowflake guildIdNew, const std::string& endpointNew, const std::string& tokenNew,
+			DiscordCoreInternal::WebSocketClient* sslShard);
 	};
 
 	/// \brief Data that is received as part of a WebHook update event.
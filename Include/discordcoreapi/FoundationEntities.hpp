@@ -314,6 +314,8 @@ namespace DiscordCoreInternal {
 
 		WebSocketMessage(simdjson::ondemand::value);
 
+		WebSocketMessage(DiscordCoreAPI::EtfValue);
+
 		template<typename RTy> RTy processJsonMessage(simdjson::ondemand::value jsonData, const char* dataName) {
 			simdjson::ondemand::value object{};
 			if (jsonData[dataName].get(object) != simdjson::error_code::SUCCESS) {
@@ -345,6 +347,66 @@ namespace DiscordCoreAPI {
 		bool areWeResuming{};
 	};
 
+	/// \brief Timings of the most recent connection of a single shard.
+	struct DiscordCoreAPI_Dll ShardStartupData {
+		Milliseconds timeSpentQueued{};///< Time spent waiting for the shard's identify bucket to open up.
+		Milliseconds timeToHello{};///< Time from opening the connection until the Hello was received.
+		Milliseconds timeToReady{};///< Time from the Hello until the session was Ready/Resumed.
+		uint32_t identifyBucket{};///< The identify bucket (shard id % max_concurrency) that the shard connected through.
+		uint32_t shardId{};///< The id of the shard.
+		bool isKernelTlsSendActive{};///< Whether the kernel encrypts the records this shard sends.
+		bool isKernelTlsReceiveActive{};///< Whether the kernel decrypts the records this shard receives.
+	};
+
+	/// \brief Counts of the TLS handshakes that could, or could not, resume a cached session.
+	struct DiscordCoreAPI_Dll TlsSessionCacheData {
+		uint64_t hits{};///< Handshakes that resumed a cached session.
+		uint64_t misses{};///< Handshakes that had to do a full key exchange.
+	};
+
+	/// \brief The state of a shard's outbound gateway queue.
+	struct DiscordCoreAPI_Dll GatewaySendQueueData {
+		uint64_t queuedFrames{};///< Frames waiting for the rate limit.
+		uint64_t droppedFrames{};///< Frames refused because their lane was full, or discarded on a disconnect or from a full TLS write buffer.
+		uint64_t sentFrames{};///< Frames handed to the TLS layer.
+		uint64_t tlsWrites{};///< Writes those frames were packed into.
+		uint32_t shardId{};///< The shard this queue belongs to.
+	};
+
+	/// \brief Percentiles of a latency over the last one to two minutes.
+	struct DiscordCoreAPI_Dll LatencySummary {
+		uint64_t sampleCount{};///< The number of samples the percentiles were taken over.
+		Nanoseconds p50{};///< The median, rounded up to the histogram's bucket, which is within 25% of it.
+		Nanoseconds p99{};///< The 99th percentile, rounded up the same way.
+		Nanoseconds max{};///< The largest sample, exactly.
+	};
+
+	/// \brief The latencies of a single shard.
+	struct DiscordCoreAPI_Dll ShardLatencyData {
+		LatencySummary heartbeatRoundTrip{};///< Time from sending a heartbeat until its acknowledgement arrived.
+		LatencySummary dispatchLatency{};///< Time from a dispatch arriving until its handlers returned, dispatch pool queueing included.
+		LatencySummary frameParseTime{};///< Time spent parsing each frame's envelope, converting ETF to JSON where needed.
+		uint32_t baseSocketAgent{};///< The agent, and so the thread, that runs the shard.
+		uint32_t shardId{};///< The id of the shard.
+	};
+
+	/// \brief The work a single shard has cost its thread since startup.
+	struct DiscordCoreAPI_Dll ShardLoadData {
+		Nanoseconds processingTime{};///< Time spent inflating, parsing, and handling the shard's messages on its own thread.
+		uint64_t messageCount{};///< The number of messages the shard has received.
+		uint32_t baseSocketAgent{};///< The agent, and so the thread, that currently runs the shard.
+		uint32_t shardId{};///< The id of the shard.
+	};
+
+	/// \brief How many events of one type a single shard has kept from its handlers, and why.
+	struct DiscordCoreAPI_Dll EventShedData {
+		std::string eventType{};///< The event's gateway name, as in DiscordCoreClientConfig::eventBudgets.
+		uint64_t droppedForQueueDepth{};///< Dropped because too many of them were already waiting on the dispatch pool.
+		uint64_t droppedForRate{};///< Dropped because they came in faster than maxEventsPerSecond.
+		uint64_t coalesced{};///< Held back under the Coalesce policy, and then replaced by a later one before they could be handed over.
+		uint32_t shardId{};///< The id of the shard.
+	};
+
 	/// \brief Timeout durations for the timeout command.
 	enum class TimeoutDurations : uint16_t {
 		None = 0,///< None - remove timeout.
@@ -432,6 +494,8 @@ namespace DiscordCoreAPI {
 
 		UserData(simdjson::ondemand::value jsonObjectData);
 
+		UserData(EtfValue etfObjectData);
+
 		template<IsEnum ETy> bool getFlagValue(ETy theEnum) {
 			return getBool(this->flags, theEnum);
 		}
@@ -759,6 +823,8 @@ namespace DiscordCoreAPI {
 
 		VoiceStateDataLight(simdjson::ondemand::value jsonObjectData);
 
+		VoiceStateDataLight(EtfValue etfObjectData);
+
 		virtual ~VoiceStateDataLight() noexcept = default;
 	};
 
@@ -817,6 +883,8 @@ namespace DiscordCoreAPI {
 
 		RoleData(simdjson::ondemand::value jsonObjectData);
 
+		RoleData(EtfValue etfObjectData);
+
 		template<IsEnum ETy> bool getFlagValue(ETy theEnum) {
 			return getBool(this->flags, theEnum);
 		}
@@ -864,33 +932,86 @@ namespace DiscordCoreAPI {
 		virtual ~ActivityData() noexcept = default;
 	};
 
+	/// \brief Presence update flags - two bits apiece for the overall status, and for the status on each client.
 	enum class PresenceUpdateFlags : uint8_t {
-		Desktop_Online = 0b00000001,
-		Desktop_Idle = 0b00000010,
-		Desktop_Dnd = 0b000000011,
-		Mobile_Online = 0b00000010,
-		Mobile_Idle = 0b00000100,
-		Mobile_Dnd = 0b00000110,
-		Web_Online = 0b00000100,
-		Web_Idle = 0b00001000,
-		Web_Dnd = 0b00001100,
-		Status_Online = 0b00001000,
-		Status_Idle = 0b00010000,
-		Status_Dnd = 0b00011000
+		Status_Online = 0b00000001,
+		Status_Idle = 0b00000010,
+		Status_Dnd = 0b00000011,
+		Desktop_Online = 0b00000100,
+		Desktop_Idle = 0b00001000,
+		Desktop_Dnd = 0b00001100,
+		Mobile_Online = 0b00010000,
+		Mobile_Idle = 0b00100000,
+		Mobile_Dnd = 0b00110000,
+		Web_Online = 0b01000000,
+		Web_Idle = 0b10000000,
+		Web_Dnd = 0b11000000
+	};
+
+	/// \brief A status, as held in each two bits of PresenceUpdateFlags.
+	enum class PresenceStatus : uint8_t { Offline = 0, Online = 1, Idle = 2, Dnd = 3 };
+
+	/// \brief Which of a presence's statuses to read - the value is the offset of its bits in PresenceUpdateFlags.
+	enum class PresenceClient : uint8_t { All = 0, Desktop = 2, Mobile = 4, Web = 6 };
+
+	/// \brief Sets one of a presence's statuses, from its name in a payload, such as "idle".
+	void setPresenceStatus(PresenceUpdateFlags& data, PresenceClient client, std::string_view status) noexcept;
+
+	/// \brief Parses a presence's "client_status" object.
+	void parseObject(simdjson::ondemand::value jsonObjectData, PresenceUpdateFlags& data);
+
+	/// \brief The activities of the cached presences, each of which is stored once, however many presences share it, and referred to by index.
+	class DiscordCoreAPI_Dll PresenceActivities {
+	  public:
+		static constexpr uint32_t maxActivityCount{ 65536 };///< Beyond this, new activities go uncached, since none are ever let go of.
+
+		/// \brief Returns the activity's index, or 0 if it has no name, or if it is new and the table is full.
+		static uint32_t intern(ActivityType type, std::string_view name, std::string_view url) noexcept;
+
+		/// \brief Returns the activity at an index, or an empty one for 0.
+		static ActivityData getActivity(uint32_t index) noexcept;
+
+		/// \brief Returns how many activities have gone uncached so far, for want of room in the table.
+		static uint64_t getFailedInternCount() noexcept;
+
+	  protected:
+		struct Activity {
+			std::string name{};
+			std::string url{};
+			ActivityType type{};
+		};
+
+		static std::unordered_map<std::string, uint32_t> indices;
+		static std::atomic_uint64_t failedInterns;
+		static std::deque<Activity> activities;
+		static std::shared_mutex accessMutex;
 	};
 
-	void parseObject(simdjson::ondemand::value jsonObjectData, PresenceUpdateFlags& data);
+	/// \brief Presence data, as the Guild cache holds it. It has no vtable, to keep it at 16 bytes.
+	struct DiscordCoreAPI_Dll PresenceUpdateDataLight {
+		Snowflake userId{};///< User id for the current presence.
+		uint32_t activityIndex{};///< The index of the presence's first activity in PresenceActivities, or 0 for none.
+		PresenceUpdateFlags theStatus{};///< Current statuses, overall and on each client.
+
+		PresenceUpdateDataLight() noexcept = default;
+
+		/// \brief Returns the overall status, or the status on one of the clients.
+		PresenceStatus getStatus(PresenceClient client = PresenceClient::All) const noexcept;
+
+		/// \brief Returns the presence's first activity.
+		ActivityData getActivity() const noexcept;
+	};
 
 	/// \brief Presence update data.
-	struct DiscordCoreAPI_Dll PresenceUpdateData {
-		PresenceUpdateFlags theStatus{};///< Current client status.
+	struct DiscordCoreAPI_Dll PresenceUpdateData : public PresenceUpdateDataLight {
 		Snowflake guildId{};///< Guild id for the current presence.
-		Snowflake userId{};///< User id for the current presence.
 
 		PresenceUpdateData() noexcept = default;
 
 		PresenceUpdateData(simdjson::ondemand::value jsonObjectData);
 
+		PresenceUpdateData(EtfValue etfObjectData);
+
 		virtual ~PresenceUpdateData() noexcept = default;
 	};
 
@@ -921,12 +1042,16 @@ namespace DiscordCoreAPI {
 
 		GuildMemberData& operator=(simdjson::ondemand::value);
 
+		GuildMemberData& operator=(EtfValue);
+
 		template<IsEnum ETy> bool getFlagValue(ETy theEnum) {
 			return getBool(this->flags, theEnum);
 		}
 
 		GuildMemberData(simdjson::ondemand::value);
 
+		GuildMemberData(EtfValue);
+
 		VoiceStateDataLight getVoiceStateData();
 
 		std::string getAvatarUrl();
@@ -953,6 +1078,8 @@ namespace DiscordCoreAPI {
 
 		OverWriteData(simdjson::ondemand::value jsonObjectData);
 
+		OverWriteData(EtfValue etfObjectData);
+
 		virtual ~OverWriteData() noexcept = default;
 	};
 
@@ -1010,6 +1137,8 @@ namespace DiscordCoreAPI {
 
 		ChannelData(simdjson::ondemand::value);
 
+		ChannelData(EtfValue);
+
 		template<IsEnum ETy> bool getFlagValue(ETy theEnum) {
 			return getBool(this->flags, theEnum);
 		}
@@ -1340,6 +1469,24 @@ namespace DiscordCoreAPI {
 		operator Jsonifier();
 	};
 
+	/// \brief How far the collection of a Guild's member list has come.
+	struct DiscordCoreAPI_Dll GuildMembersProgressData {
+		uint64_t membersReceived{};///< How many members have been cached so far.
+		int32_t chunksReceived{};///< How many chunks have arrived so far.
+		int32_t chunkCount{};///< How many chunks Discord is sending in total, or zero until the first one arrives.
+		Snowflake guildId{};///< The Guild whose members are being collected.
+		bool isItComplete{};///< Whether every chunk has arrived.
+	};
+
+	/// \brief For collecting the full member lists of a set of Guilds over the gateway, which requires the GUILD_MEMBERS intent.
+	struct DiscordCoreAPI_Dll RequestGuildMembersData {
+		std::function<void(const GuildMembersProgressData&)> onProgress{};///< Called after each chunk has been cached.
+		std::vector<Snowflake> guildIds{};///< The Guilds to collect the members of.
+		uint32_t maxConcurrentRequests{ 4 };///< How many of the Guilds may be outstanding at once.
+		int32_t chunkTimeoutInMs{ 30000 };///< How long to wait for a Guild's next chunk before giving up on it.
+		bool includePresences{};///< Whether to also collect presences, which requires the GUILD_PRESENCES intent.
+	};
+
 	/// \brief Team object data.
 	class DiscordCoreAPI_Dll TeamObjectData : public DiscordEntity {
 	  public:
@@ -1813,7 +1960,7 @@ namespace DiscordCoreAPI {
 		DiscordCoreClient* discordCoreClient{ nullptr };///< A pointer to the DiscordCoreClient.
 		VoiceConnection* voiceConnectionPtr{ nullptr };///< A pointer to the VoiceConnection, if present.
 		std::vector<Snowflake> guildScheduledEvents{};///< Array of Guild channels.
-		std::vector<PresenceUpdateData> presences{};///< Presence states for each of the GuildMembers..
+		std::vector<PresenceUpdateDataLight> presences{};///< Presence states for each of the GuildMembers, sorted by userId.
 		std::vector<Snowflake> stageInstances{};///< Array of Guild channels.
 		std::vector<Snowflake> stickers{};///< Array of Guild channels.
 		std::vector<Snowflake> channels{};///< Array of Guild channels.
@@ -1840,6 +1987,8 @@ namespace DiscordCoreAPI {
 
 		GuildData(simdjson::ondemand::value jsonObjectData);
 
+		GuildData(EtfValue etfObjectData);
+
 		/// \brief For connecting to an individual voice channel.
 		/// \param guildMemberId An id of the guild member who's current voice channel to connect to.
 		/// \param channelId An id of the voice channel to connect to.
@@ -2896,6 +3045,8 @@ namespace DiscordCoreAPI {
 
 		GuildMembersChunkEventData(simdjson::ondemand::value jsonObjectData);
 
+		GuildMembersChunkEventData(EtfValue etfObjectData);
+
 		virtual ~GuildMembersChunkEventData() noexcept = default;
 	};
 
@@ -0,0 +1,121 @@
+/*
+	DiscordCoreAPI, A bot library for Discord, written in C++, and featuring explicit multithreading through the usage of custom, asynchronous C++ CoRoutines.
+
+	Copyright 2021, 2022 Chris M. (RealTimeChris)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 2.1 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+	USA
+*/
+/// GatewayProxy.hpp - Header for sharing one process's gateway dispatches with other processes.
+/// Oct 17, 2022
+/// https://discordcoreapi.com
+/// \file GatewayProxy.hpp
+
+#pragma once
+
+#include <discordcoreapi/WebSocketEntities.hpp>
+
+#ifdef __linux__
+	#include <sys/un.h>
+#endif
+
+namespace DiscordCoreInternal {
+
+	/// \brief Precedes each frame on the proxy's socket.
+	struct DiscordCoreAPI_Dll GatewayProxyFrameHeader {
+		static constexpr uint32_t handshakeShardId{ std::numeric_limits<uint32_t>::max() };///< Marks the frame that opens each connection.
+		static constexpr uint32_t maxFrameSize{ 256 * 1024 * 1024 };
+
+		uint32_t shardId{};
+		uint32_t size{};
+	};
+
+	/// \brief Hands the dispatches of this process's shards, exactly as they came off of the gateway, to every consumer that is connected to it
+	/// over a Unix domain socket.
+	class DiscordCoreAPI_Dll GatewayProxyPublisher {
+	  public:
+		GatewayProxyPublisher(DiscordCoreAPI::ConfigManager* configManagerNew) noexcept;
+
+		/// \brief Starts taking consumers. Returns false if the socket could not be listened on.
+		bool start() noexcept;
+
+		/// \brief Queues a dispatch for every consumer, and writes as much of it as each consumer's socket will take right away.
+		void publish(uint32_t shardId, std::string_view frame, GatewayEventType eventType) noexcept;
+
+		~GatewayProxyPublisher() noexcept;
+
+	  protected:
+		struct Consumer {
+			uint64_t snapshotBacklog{};///< How far the guild snapshot lets the backlog run past its limit, until the backlog first drains.
+			std::string outputBuffer{};
+			SOCKETWrapper socket{};
+		};
+
+		std::unordered_map<uint64_t, std::pair<uint32_t, std::string>> guildSnapshot{};///< The latest GUILD_CREATE of each guild, and its shard.
+		std::unordered_map<uint32_t, Consumer> consumers{};
+		DiscordCoreAPI::ConfigManager* configManager{};
+		std::unique_ptr<std::jthread> taskThread{};
+		std::atomic_uint32_t activeConsumers{};///< Lets the shards skip the lock while nobody is listening.
+		SOCKETWrapper listenSocket{};
+		std::mutex accessMutex{};
+		uint32_t consumerCount{};
+
+		/// \brief Writes as much of the consumer's backlog as its socket will take. Returns false once the consumer is gone.
+		bool writeData(Consumer& consumer) noexcept;
+
+		void removeConsumer(uint32_t consumerId, const std::string& reason) noexcept;
+
+		void updateGuildSnapshot(uint32_t shardId, std::string_view frame, GatewayEventType eventType) noexcept;
+
+		void run(std::stop_token token) noexcept;
+	};
+
+	/// \brief Stands in for a process's shards: it takes the dispatches of a publisher's shards, and hands them to this process's EventManager,
+	/// as its own shards would have.
+	class DiscordCoreAPI_Dll GatewayProxyConsumer {
+	  public:
+		GatewayProxyConsumer(DiscordCoreAPI::DiscordCoreClient* discordCoreClientNew, std::atomic_bool* doWeQuitNew) noexcept;
+
+		/// \brief Connects to the publisher, and takes on its shard count and text format. Returns false if the publisher could not be reached.
+		bool connect() noexcept;
+
+		/// \brief Starts dispatching the publisher's frames, and reconnecting to it whenever it goes away.
+		void start() noexcept;
+
+		/// \brief Stops dispatching, while leaving the stand-in shards to whatever dispatches they have already handed to the dispatch pool.
+		void stop() noexcept;
+
+		~GatewayProxyConsumer() noexcept;
+
+	  protected:
+		std::unordered_map<uint32_t, std::unique_ptr<WebSocketClient>> shardMap{};///< Never connected, just used to dispatch.
+		DiscordCoreAPI::DiscordCoreClient* discordCoreClient{};
+		std::unique_ptr<std::jthread> taskThread{};
+		std::atomic_bool* doWeQuit{};
+		std::string inputBuffer{};
+		SOCKETWrapper socket{};
+
+		/// \brief Reads whatever has arrived. Returns false once the publisher is gone.
+		bool readData() noexcept;
+
+		/// \brief Dispatches the complete frames that have arrived. Returns false if the publisher sent something that is not a frame.
+		bool processFrames() noexcept;
+
+		void onFrame(uint32_t shardId, std::string_view frame) noexcept;
+
+		void run(std::stop_token token) noexcept;
+	};
+
+}// namespace DiscordCoreInternal
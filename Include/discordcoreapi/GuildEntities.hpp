@@ -277,7 +277,7 @@ namespace DiscordCoreAPI {
 		friend class Guilds;
 
 		DefaultMessageNotificationLevel defaultMessageNotifications{};///< Default Message notification level.
-		std::unordered_map<uint64_t, PresenceUpdateData> presences{};///< std::map of presences for each GuildMember.
+		std::unordered_map<uint64_t, PresenceUpdateDataLight> presences{};///< std::map of presences for each GuildMember.
 		std::vector<GuildScheduledEvent> guildScheduledEvents{};///< Guild scheduled events of the Guild.
 		GuildNSFWLevel nsfwLevel{ GuildNSFWLevel::Default };///< NSFW warning level.
 		ExplicitContentFilterLevel explicitContentFilter{};///< Explicit content filtering level, by default.
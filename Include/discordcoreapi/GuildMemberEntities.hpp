@@ -223,6 +223,8 @@ namespace DiscordCoreAPI {
 
 		static void insertGuildMember(GuildMemberData guildMember);
 
+		static void insertGuildMembers(std::vector<GuildMemberData>&& guildMembers);
+
 		static void removeGuildMember(GuildMemberData guildMemberId);
 
 		static bool doWeCacheGuildMembers();
@@ -62,9 +62,17 @@
 	#include <netinet/in.h>
 	#include <sys/socket.h>
 	#include <sys/types.h>
+	#include <sys/eventfd.h>
+	#include <sys/epoll.h>
 	#include <netdb.h>
 	#include <fcntl.h>
 	#include <poll.h>
+	#include <unistd.h>
+	#ifdef DCA_IO_URING
+		#include <linux/io_uring.h>
+		#include <sys/syscall.h>
+		#include <sys/mman.h>
+	#endif
 #endif
 
 namespace DiscordCoreInternal {
@@ -84,6 +92,118 @@ namespace DiscordCoreInternal {
 		std::vector<pollfd> polls{};
 	};
 
+	class DiscordCoreAPI_Dll TCPSSLClient;
+
+#ifdef __linux__
+	/// \brief An edge-triggered epoll set, where each socket is registered once and only has its write-interest toggled afterwards.
+	class DiscordCoreAPI_Dll EpollWrapper {
+	  public:
+		friend class TCPSSLClient;
+
+		EpollWrapper() noexcept;
+
+		bool addSocket(SOCKET socketNew, TCPSSLClient* client) noexcept;
+
+		bool modifySocket(SOCKET socketNew, TCPSSLClient* client, bool doWeWatchForWrites) noexcept;
+
+		void removeSocket(SOCKET socketNew, TCPSSLClient* client) noexcept;
+
+		uint32_t getSocketCount() noexcept;
+
+		int32_t wait(int32_t msToWait) noexcept;
+
+		void wakeUp() noexcept;
+
+		~EpollWrapper() noexcept;
+
+	  protected:
+		std::unordered_set<TCPSSLClient*> pendingReads{};
+		std::vector<epoll_event> events{};
+		std::mutex accessMutex{};
+		SOCKET epollFd{ SOCKET_ERROR };
+		SOCKET wakeFd{ SOCKET_ERROR };
+		std::atomic_uint32_t socketCount{};
+	};
+#endif
+
+#if defined(__linux__) && defined(DCA_IO_URING)
+	/// \brief A completion-based io_uring ring, which owns one registered read buffer and one registered write buffer per client it drives.
+	/// Clients on the ring talk TLS through memory BIOs, so each read or write costs a queue entry instead of a syscall, and the re-armed reads
+	/// are submitted together with the next wait.
+	class DiscordCoreAPI_Dll IoUringWrapper {
+	  public:
+		friend class TCPSSLClient;
+
+		static constexpr uint64_t bufferSize{ 1024 * 16 };
+
+		IoUringWrapper() noexcept = default;
+
+		/// \brief Sets up the ring and registers the buffers for slotCount clients. Returns false, leaving the ring unusable, on kernels that
+		/// lack io_uring or IORING_FEAT_EXT_ARG, in which case the caller should stay on epoll.
+		bool initialize(uint32_t slotCountNew) noexcept;
+
+		bool addSocket(TCPSSLClient* client) noexcept;
+
+		void removeSocket(TCPSSLClient* client) noexcept;
+
+		bool submitWrite(TCPSSLClient* client) noexcept;
+
+		int32_t wait(int32_t msToWait) noexcept;
+
+		bool isItAvailable() noexcept;
+
+		void wakeUp() noexcept;
+
+		~IoUringWrapper() noexcept;
+
+	  protected:
+		enum class OpType : uint64_t { Wake = 0, Read = 1, Write = 2, Cancel = 3 };
+
+		struct Slot {
+			TCPSSLClient* client{ nullptr };
+			uint64_t bytesToWrite{};
+			uint64_t bytesWritten{};
+			uint32_t opsInFlight{};
+			bool isWriteInFlight{};
+		};
+
+		std::unordered_set<TCPSSLClient*> pendingReads{};
+		std::unique_ptr<char[]> buffers{};
+		std::vector<io_uring_cqe> events{};
+		io_uring_sqe* sqes{ nullptr };
+		io_uring_cqe* cqes{ nullptr };
+		std::vector<Slot> slots{};
+		uint32_t* sqArray{ nullptr };
+		uint32_t* sqHead{ nullptr };
+		uint32_t* sqTail{ nullptr };
+		uint32_t* cqHead{ nullptr };
+		uint32_t* cqTail{ nullptr };
+		std::mutex accessMutex{};
+		SOCKET ringFd{ SOCKET_ERROR };
+		uint64_t sqesSize{};
+		uint64_t ringSize{};
+		void* ring{ nullptr };
+		uint32_t pendingSqes{};
+		uint32_t sqEntries{};
+		uint32_t sqMask{};
+		uint32_t cqMask{};
+
+		bool pushSqe(const io_uring_sqe& sqe) noexcept;
+
+		int32_t submit() noexcept;
+
+		bool submitRead(uint32_t slotIndex) noexcept;
+
+		bool fillWriteBuffer(uint32_t slotIndex) noexcept;
+
+		int32_t enter(uint32_t toSubmit, uint32_t minComplete, uint32_t flags, int32_t msToWait) noexcept;
+
+		char* getReadBuffer(uint32_t slotIndex) noexcept;
+
+		char* getWriteBuffer(uint32_t slotIndex) noexcept;
+	};
+#endif
+
 #ifdef _WIN32
 	struct DiscordCoreAPI_Dll WSADataWrapper {
 		struct DiscordCoreAPI_Dll WSADataDeleter {
@@ -149,6 +269,8 @@ namespace DiscordCoreInternal {
 	};
 
 	struct DiscordCoreAPI_Dll addrinfoWrapper {
+		friend class DnsResolver;
+
 		addrinfo* operator->();
 
 		operator addrinfo**();
@@ -156,10 +278,43 @@ namespace DiscordCoreInternal {
 		operator addrinfo*();
 
 	  protected:
+		sockaddr_storage storage{};
 		addrinfo value{};
 		addrinfo* ptr{ &this->value };
 	};
 
+	/// \brief Resolves host names for every socket in the library - gateway, REST, voice, and the song downloads. Answers are cached for the
+	/// configured TTL, and failures for a few seconds. Lookups run on threads of their own, so an expired answer keeps being served while it is
+	/// refreshed, a slow resolver can only hold a connection attempt up for as long as it is willing to wait, and concurrent lookups of one host
+	/// share a single query.
+	class DiscordCoreAPI_Dll DnsResolver {
+	  public:
+		static void initialize(const std::unordered_map<std::string, std::string>& hostOverridesNew, Seconds ttlNew) noexcept;
+
+		/// \brief Fills address with the first IPv4 address of host. Returns false if it could not be resolved within timeToWait.
+		static bool resolve(const std::string& host, uint16_t port, int32_t socketType, addrinfoWrapper& address,
+			Milliseconds timeToWait = 5000ms) noexcept;
+
+	  protected:
+		struct CacheEntry {
+			std::shared_future<void> pendingLookup{};
+			std::chrono::steady_clock::time_point expiry{};
+			sockaddr_storage address{};
+			socklen_t addressLength{};
+			std::mutex accessMutex{};
+			bool didItResolve{};
+		};
+
+		static std::unordered_map<std::string, std::shared_ptr<CacheEntry>> cache;
+		static std::unordered_map<std::string, std::string> hostOverrides;
+		static const Seconds negativeTtl;
+		static std::mutex accessMutex;
+		static Seconds ttl;
+
+		static std::shared_future<void> startLookup(std::shared_ptr<CacheEntry> entry, const std::string& host, uint16_t port, int32_t socketType,
+			Seconds ttlNew) noexcept;
+	};
+
 	class DiscordCoreAPI_Dll SSLConnectionInterface {
 	  public:
 		virtual bool connect(const std::string& baseUrl, const uint16_t portNew, bool doWePrintErrorMessages,
@@ -169,14 +324,28 @@ namespace DiscordCoreInternal {
 
 		virtual void disconnect() noexcept = 0;
 
-		static bool initialize() noexcept;
+		/// \brief Sets up the shared SSL_CTX. With doWeUseKernelTls, OpenSSL is asked to move each connection's record layer into the kernel
+		/// after the handshake, and quietly keeps it in userspace when the kernel or the negotiated cipher can't take it.
+		static bool initialize(bool doWeUseKernelTls = false) noexcept;
+
+		static DiscordCoreAPI::TlsSessionCacheData getSessionCacheData() noexcept;
 
 		virtual ~SSLConnectionInterface() noexcept = default;
 
 	  protected:
+		static std::unordered_map<std::string, SSL_SESSION*> sessionCache;
+		static std::atomic_uint64_t sessionCacheMisses;
+		static std::atomic_uint64_t sessionCacheHits;
+		static std::mutex sessionCacheMutex;
 		static SSL_CTXWrapper context;
 		static std::mutex mutex;
 
+		std::string sessionCacheKey{};
+
+		static int32_t storeSession(SSL* ssl, SSL_SESSION* session) noexcept;
+
+		void loadSession() noexcept;
+
 		SOCKETWrapper socket{};
 		SSLWrapper ssl{};
 	};
@@ -204,14 +373,40 @@ namespace DiscordCoreInternal {
 
 	class DiscordCoreAPI_Dll TCPSSLClient : public SSLDataInterface, public SSLConnectionInterface {
 	  public:
+#ifdef __linux__
+		friend class EpollWrapper;
+#endif
+#if defined(__linux__) && defined(DCA_IO_URING)
+		friend class IoUringWrapper;
+#endif
+
 		virtual void handleBuffer() noexcept = 0;
 
 		bool connect(const std::string& baseUrl, const uint16_t portNew, bool doWePrintErrorMessages, bool areWeAStandaloneSocket) noexcept;
 
 		static std::vector<TCPSSLClient*> processIO(std::unordered_map<uint32_t, std::unique_ptr<WebSocketClient>>& shardMap) noexcept;
 
+#ifdef __linux__
+		/// \brief Waits for and handles the ready sockets, releasing lockToRelease, if given, for as long as the wait lasts.
+		static std::vector<TCPSSLClient*> processIO(EpollWrapper& epoll, int32_t msToWait,
+			std::unique_lock<std::mutex>* lockToRelease = nullptr) noexcept;
+
+		void setEpoll(EpollWrapper* epollNew) noexcept;
+#endif
+
+#if defined(__linux__) && defined(DCA_IO_URING)
+		/// \brief Waits for and handles the completions, releasing lockToRelease, if given, for as long as the wait lasts.
+		static std::vector<TCPSSLClient*> processIO(IoUringWrapper& ioUring, int32_t msToWait,
+			std::unique_lock<std::mutex>* lockToRelease = nullptr) noexcept;
+
+		/// \brief Moves an established connection onto the ring. Returns false if the ring is unavailable or full.
+		bool setIoUring(IoUringWrapper* ioUringNew) noexcept;
+#endif
+
 		ProcessIOResult writeData(std::string_view dataToWrite, bool priority) noexcept;
 
+		ProcessIOResult writeData(std::string_view header, std::string_view dataToWrite, bool priority) noexcept;
+
 		ProcessIOResult processIO(int32_t msToWait) noexcept;
 
 		std::string_view getInputBuffer() noexcept;
@@ -224,11 +419,29 @@ namespace DiscordCoreInternal {
 
 		int64_t getBytesRead() noexcept;
 
+		bool isKernelTlsSendActive() noexcept;
+
+		bool isKernelTlsReceiveActive() noexcept;
+
 		virtual ~TCPSSLClient() noexcept = default;
 
 	  protected:
+#ifdef __linux__
+		EpollWrapper* epoll{ nullptr };
+		bool areWeWatchingForWrites{};
+#endif
+#if defined(__linux__) && defined(DCA_IO_URING)
+		IoUringWrapper* ioUring{ nullptr };
+		uint32_t ioUringSlot{};
+#endif
+		std::atomic_uint64_t outputBufferDrops{};///< Unwritten slots discarded to make room for newer writes, or cleared away on a disconnect.
 		bool doWePrintErrorMessages{};
 		bool areWeAStandaloneSocket{};
+
+		/// \brief Discards the oldest unwritten slot, and counts it in outputBufferDrops, if there is no free one left.
+		void makeRoomInOutputBuffer() noexcept;
+
+		void updateWriteInterest() noexcept;
 	};
 
 	enum class ProcessIOType { Both = 0, Read_Only = 1, Write_Only = 2 };
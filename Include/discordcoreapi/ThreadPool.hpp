@@ -27,6 +27,7 @@
 
 #include <discordcoreapi/FoundationEntities.hpp>
 #include <discordcoreapi/Https.hpp>
+#include <condition_variable>
 #include <coroutine>
 
 namespace DiscordCoreAPI {
@@ -126,5 +127,28 @@ namespace DiscordCoreInternal {
 
 		void threadFunction(std::stop_token token, int64_t index);
 	};
+
+	/// \brief A fixed set of threads, on which the tasks that share a key run one at a time and in the order they were submitted.
+	class DiscordCoreAPI_Dll SerialTaskPool {
+	  public:
+		SerialTaskPool(uint32_t threadCountNew);
+
+		void submitTask(uint64_t key, std::function<void()> task) noexcept;
+
+		~SerialTaskPool() noexcept;
+
+	  protected:
+		struct DiscordCoreAPI_Dll TaskQueue {
+			std::deque<std::function<void()>> tasks{};
+			std::condition_variable_any condVar{};
+			std::mutex accessMutex{};
+			std::jthread thread{};
+		};
+
+		std::unique_ptr<TaskQueue[]> taskQueues{};
+		uint32_t threadCount{};
+
+		void threadFunction(std::stop_token token, TaskQueue& taskQueue);
+	};
 	/**@}*/
 }// namespace DiscordCoreAPI
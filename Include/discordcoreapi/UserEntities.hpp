@@ -137,6 +137,11 @@ namespace DiscordCoreAPI {
 		/// \brief Updates the bot's current activity status, to be viewed by others in the same server as the bot.
 		void updatePresence(UpdatePresenceData& dataPackage);
 
+		/// \brief Collects the full member lists of a set of Guilds over the gateway, caching each chunk as it arrives.
+		/// \param dataPackage A RequestGuildMembersData structure.
+		/// \returns A CoRoutine containing one GuildMembersProgressData for each Guild, which is not complete if its chunks stopped coming.
+		CoRoutine<std::vector<GuildMembersProgressData>> requestGuildMembersAsync(RequestGuildMembersData dataPackage);
+
 	  protected:
 		BotUser() noexcept = default;
 
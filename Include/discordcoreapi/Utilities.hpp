@@ -67,6 +67,7 @@
 #include <iostream>
 #include <sstream>
 #include <iomanip>
+#include <future>
 #include <vector>
 #include <atomic>
 #include <random>
@@ -74,6 +75,7 @@
 #include <thread>
 #include <mutex>
 #include <queue>
+#include <deque>
 #include <array>
 #include <map>
 
@@ -665,6 +667,7 @@ namespace DiscordCoreInternal {
 	class DiscordCoreAPI_Dll YouTubeRequestBuilder;
 	class DiscordCoreAPI_Dll WebSocketClient;
 	class DiscordCoreAPI_Dll BaseSocketAgent;
+	class DiscordCoreAPI_Dll ClusterClient;
 	class DiscordCoreAPI_Dll SoundCloudAPI;
 	class DiscordCoreAPI_Dll YouTubeAPI;
 
@@ -957,6 +960,12 @@ namespace DiscordCoreAPI {
 		Json = 0x01///< Json format.
 	};
 
+	/// \brief Represents which transport compression to use for the gateway websocket.
+	enum class GatewayCompression : uint8_t {
+		None = 0x00,///< No transport compression.
+		Zlib_Stream = 0x01///< One zlib stream, shared across every message of a connection.
+	};
+
 	/// \brief Sharding options for the library.
 	struct DiscordCoreAPI_Dll ShardingOptions {
 		uint32_t numberOfShardsForThisProcess{ 1 };///< The number of shards to launch on the current process.
@@ -964,6 +973,60 @@ namespace DiscordCoreAPI {
 		uint32_t startingShard{};///< The first shard to start on this process.
 	};
 
+	/// \brief The part a process plays in a cluster of processes that share one bot's shards between them.
+	enum class ClusterRole : uint8_t {
+		None = 0x00,///< The process runs the shards of its ShardingOptions by itself.
+		Coordinator = 0x01,///< The process runs no shards, and instead hands out shard ranges and identify windows to the workers.
+		Worker = 0x02///< The process runs whichever shard ranges the coordinator hands it, in place of those of its ShardingOptions.
+	};
+
+	/// \brief Cluster options for the library.
+	struct DiscordCoreAPI_Dll ClusterOptions {
+		std::string socketPath{ "/tmp/discordcoreapi.sock" };///< The Unix domain socket that the coordinator listens on, and the workers connect to.
+		/// \brief Workers that are silent for this long are taken for dead, and their shards handed to others once this long again has passed.
+		/// It is also the lease on a worker's shards: a worker that has not heard back from the coordinator for this long quits.
+		Milliseconds workerTimeout{ 10000 };
+		ClusterRole role{ ClusterRole::None };///< The part that this process plays.
+		uint32_t shardsPerWorker{ 1 };///< The size of the shard range that each worker is handed when it joins.
+	};
+
+	/// \brief The part a process plays in sharing one set of gateway connections with the other processes on its machine.
+	enum class GatewayProxyRole : uint8_t {
+		None = 0x00,///< The process's dispatches stay within it.
+		Publisher = 0x01,///< The process runs its shards as usual, and also hands each of their dispatches to the consumers.
+		Consumer = 0x02///< The process runs no shards, and instead dispatches whatever the publisher hands it to its own EventManager.
+	};
+
+	/// \brief Gateway proxy options for the library.
+	struct DiscordCoreAPI_Dll GatewayProxyOptions {
+		std::string socketPath{ "/tmp/discordcoreapi-gateway.sock" };///< The Unix domain socket that the publisher listens on.
+		uint64_t maxConsumerBacklog{ 64ull * 1024ull * 1024ull };///< Consumers that fall this many bytes behind are disconnected.
+		/// \brief Hands each consumer, as it connects, the latest GUILD_CREATE of every guild that the publisher's shards have, which the publisher
+		/// keeps a copy of for the purpose. READY and RESUMED only concern the publisher's own sessions, and are never handed over.
+		bool replayGuildCreates{ true };
+		GatewayProxyRole role{ GatewayProxyRole::None };///< The part that this process plays.
+	};
+
+	/// \brief Event journal options for the library.
+	struct DiscordCoreAPI_Dll EventJournalOptions {
+		std::string directory{};///< Where each shard's dispatches are journaled. Left empty, nothing is.
+		uint64_t segmentSize{ 16ull * 1024ull * 1024ull };///< The size of each of the memory-mapped files that a shard's journal is split across.
+		uint32_t maxSegments{ 4 };///< How many of each shard's segments are kept, the one being written to included, besides the next one.
+	};
+
+	/// \brief What becomes of the events that go over their budget. Either way, the caches are still updated from them.
+	enum class EventShedPolicy : uint8_t {
+		Drop = 0x00,///< The handlers never see them.
+		Coalesce = 0x01///< The latest of them is held back, and handed to the handlers once the budget allows.
+	};
+
+	/// \brief A per-shard budget for the events of one type, beyond which they are kept from their handlers.
+	struct DiscordCoreAPI_Dll EventBudget {
+		uint32_t maxEventsPerSecond{};///< The sustained rate, which may also be reached in a single burst. 0 for no limit.
+		uint32_t maxQueueDepth{};///< How many of them may be waiting on the dispatch pool at once. 0 for no limit.
+		EventShedPolicy policy{ EventShedPolicy::Drop };///< What becomes of the events that go over maxEventsPerSecond.
+	};
+
 	/**@}*/
 
 	/// \brief Loggin options for the library.
@@ -991,12 +1054,26 @@ namespace DiscordCoreAPI {
 		std::vector<RepeatedFunctionData> functionsToExecute{};///< Functions to execute after a timer, or on a repetition.
 		GatewayIntents intents{ GatewayIntents::All_Intents };///< The gateway intents to be used for this instance.
 		TextFormat textFormat{ TextFormat::Etf };///< Use ETF or JSON format for websocket transfer?
+		GatewayCompression compression{ GatewayCompression::None };///< Transport compression to use for the gateway websocket.
 		UpdatePresenceData presenceData{};///< Presence data to initialize your bot with.
 		std::string connectionAddress{};///< A potentially alternative connection address for the websocket.
+		std::string sessionStorePath{};///< If set, each shard's gateway session is saved to this file on shutdown and resumed on the next start.
 		ShardingOptions shardOptions{};///< Options for the sharding of your bot.
+		ClusterOptions clusterOptions{};///< Options for sharing your bot's shards between several processes on one machine.
+		GatewayProxyOptions gatewayProxyOptions{};///< Options for sharing one process's gateway dispatches with others on one machine.
+		EventJournalOptions eventJournalOptions{};///< Options for journaling each shard's dispatches to disk, for catching up on or replaying them.
+		std::unordered_map<std::string, EventBudget> eventBudgets{};///< Budgets keyed by gateway event name, such as "TYPING_START".
+		Milliseconds presenceCoalesceWindow{ 0 };///< Presence updates for a user this close together are delivered as one; 0 delivers each.
 		LoggingOptions logOptions{};///< Options for the output/logging of the library.
 		CacheOptions cacheOptions{};///< Options for the cache of the library.
 		uint16_t connectionPort{};///< A potentially alternative connection port for the websocket.
+		bool enableKernelTls{};///< Hand TLS record encryption over to the kernel (kTLS) where the kernel and the negotiated cipher support it.
+		std::unordered_map<std::string, std::string> hostOverrides{};///< Host names mapped to fixed addresses, /etc/hosts style, ahead of DNS.
+		Seconds dnsCacheTtl{ 60 };///< How long a resolved address is reused before it is looked up again.
+		/// \brief Dispatches of at least this many bytes are decoded on a worker thread; 0 decodes them all inline. Nothing is offloaded while
+		/// logOptions.logWebSocketSuccessMessages is set, since the logged payload is the one that the shard's own thread decoded.
+		uint64_t dispatchOffloadThreshold{ 65536 };
+		Milliseconds shardRebalanceInterval{ 0 };///< How often a shard may move from the busiest shard thread to the idlest; 0 never moves any.
 		std::string botToken{};///< Your bot's token.
 	};
 
@@ -1057,8 +1134,36 @@ namespace DiscordCoreAPI {
 
 		const TextFormat getTextFormat() const;
 
+		const GatewayCompression getGatewayCompression() const;
+
 		const GatewayIntents getGatewayIntents();
 
+		const std::string getSessionStorePath() const;
+
+		const bool doWeUseKernelTls() const;
+
+		const std::unordered_map<std::string, std::string> getHostOverrides() const;
+
+		const Seconds getDnsCacheTtl() const;
+
+		const uint64_t getDispatchOffloadThreshold() const;
+
+		const Milliseconds getShardRebalanceInterval() const;
+
+		const ClusterOptions getClusterOptions() const;
+
+		void setTotalShardCount(uint32_t totalShardCountNew);
+
+		const GatewayProxyOptions getGatewayProxyOptions() const;
+
+		void setTextFormat(TextFormat textFormatNew);
+
+		const EventJournalOptions getEventJournalOptions() const;
+
+		const std::unordered_map<std::string, EventBudget> getEventBudgets() const;
+
+		const Milliseconds getPresenceCoalesceWindow() const;
+
 	  protected:
 		DiscordCoreClientConfig config{};
 	};
@@ -1131,6 +1236,20 @@ namespace DiscordCoreAPI {
 			this->set.emplace(data);
 		}
 
+		/// \brief Inserts or replaces a whole batch of objects under a single acquisition of the lock.
+		void emplace(std::vector<OTy>&& data) noexcept {
+			std::unique_lock lock{ this->accessMutex };
+			this->set.reserve(this->set.size() + data.size());
+			for (auto& value: data) {
+				auto iterator = this->set.find(value);
+				if (iterator != this->set.end()) {
+					( OTy& )*iterator = std::move(value);
+				} else {
+					this->set.emplace(std::move(value));
+				}
+			}
+		}
+
 		const OTy& readOnly(OTy& key) noexcept {
 			std::shared_lock lock{ this->accessMutex };
 			return *this->set.find(key);
@@ -1141,6 +1260,23 @@ namespace DiscordCoreAPI {
 			return ( OTy& )*this->set.find(key);
 		}
 
+		/// \brief Copies an object out under the lock, so that a modify() can not change it halfway through the copy.
+		OTy copy(OTy& key) noexcept {
+			std::shared_lock lock{ this->accessMutex };
+			return *this->set.find(key);
+		}
+
+		/// \brief Changes an object in place under the lock, returning false if it is not cached.
+		template<typename FunctionTy> bool modify(OTy& key, FunctionTy&& function) {
+			std::unique_lock lock{ this->accessMutex };
+			auto iterator = this->set.find(key);
+			if (iterator == this->set.end()) {
+				return false;
+			}
+			function(( OTy& )*iterator);
+			return true;
+		}
+
 		OTy& at(OTy& key) noexcept {
 			std::shared_lock lock{ this->accessMutex };
 			return ( OTy& )*this->set.find(key);
@@ -1758,8 +1894,11 @@ namespace DiscordCoreInternal {
 		uint64_t length{};
 	};
 
+	/// \brief A receive buffer that is consumed by advancing a read offset, and which always keeps paddingSize bytes of slack past its end.
 	class DiscordCoreAPI_Dll StringBuffer {
 	  public:
+		static constexpr uint64_t paddingSize{ 64 };
+
 		StringBuffer() noexcept;
 
 		std::string_view operator[](LengthData);
@@ -1783,6 +1922,7 @@ namespace DiscordCoreInternal {
 	  protected:
 		std::string string{};
 		uint64_t sizeValue{};
+		uint64_t offset{};
 	};
 
 	enum class RingBufferAccessType { Read = 0, Write = 1 };
@@ -30,19 +30,123 @@
 #include <discordcoreapi/CommandController.hpp>
 #include <discordcoreapi/ErlParser.hpp>
 #include <discordcoreapi/EventEntities.hpp>
+#include <discordcoreapi/EventJournal.hpp>
 #include <discordcoreapi/SSLClients.hpp>
 #include <discordcoreapi/ThreadPool.hpp>
+#include <zlib.h>
 
 namespace DiscordCoreInternal {
 
+	/// \brief The dispatch events that can be received from the gateway.
+	enum class GatewayEventType : int32_t {
+		Unknown = 0,
+		Ready = 1,
+		Resumed = 2,
+		Application_Command_Permissions_Update = 3,
+		Auto_Moderation_Rule_Create = 4,
+		Auto_Moderation_Rule_Update = 5,
+		Auto_Moderation_Rule_Delete = 6,
+		Auto_Moderation_Action_Execution = 7,
+		Channel_Create = 8,
+		Channel_Update = 9,
+		Channel_Delete = 10,
+		Channel_Pins_Update = 11,
+		Thread_Create = 12,
+		Thread_Update = 13,
+		Thread_Delete = 14,
+		Thread_List_Sync = 15,
+		Thread_Member_Update = 16,
+		Thread_Members_Update = 17,
+		Guild_Create = 18,
+		Guild_Update = 19,
+		Guild_Delete = 20,
+		Guild_Ban_Add = 21,
+		Guild_Ban_Remove = 22,
+		Guild_Emojis_Update = 23,
+		Guild_Stickers_Update = 24,
+		Guild_Integrations_Update = 25,
+		Guild_Member_Add = 26,
+		Guild_Member_Remove = 27,
+		Guild_Member_Update = 28,
+		Guild_Members_Chunk = 29,
+		Guild_Role_Create = 30,
+		Guild_Role_Update = 31,
+		Guild_Role_Delete = 32,
+		Guild_Scheduled_Event_Create = 33,
+		Guild_Scheduled_Event_Update = 34,
+		Guild_Scheduled_Event_Delete = 35,
+		Guild_Scheduled_Event_User_Add = 36,
+		Guild_Scheduled_Event_User_Remove = 37,
+		Integration_Create = 38,
+		Integration_Update = 39,
+		Integration_Delete = 40,
+		Interaction_Create = 41,
+		Invite_Create = 42,
+		Invite_Delete = 43,
+		Message_Create = 44,
+		Message_Update = 45,
+		Message_Delete = 46,
+		Message_Delete_Bulk = 47,
+		Message_Reaction_Add = 48,
+		Message_Reaction_Remove = 49,
+		Message_Reaction_Remove_All = 50,
+		Message_Reaction_Remove_Emoji = 51,
+		Presence_Update = 52,
+		Stage_Instance_Create = 53,
+		Stage_Instance_Update = 54,
+		Stage_Instance_Delete = 55,
+		Typing_Start = 56,
+		User_Update = 57,
+		Voice_State_Update = 58,
+		Voice_Server_Update = 59,
+		Webhooks_Update = 60,
+	};
+
+	/// \brief How much of a dispatch needs to be decoded, given the current subscribers and cache settings.
+	enum class EventDecodeMode : uint8_t {
+		Skip = 0,///< Nobody is listening and nothing is cached - the payload is dropped unparsed.
+		Cache_Only = 1,///< Only the caches need it - the entity is parsed, but no event object is built.
+		Full = 2,///< The event object is built and handed to the subscribers.
+		Held = 3///< As Full, except that the event object is kept back from the subscribers, in place of the last one kept, until a flush.
+	};
+
+	/// \brief Maps an event name onto its GatewayEventType, through a perfect hash that is built at compile time.
 	class DiscordCoreAPI_Dll EventConverter {
 	  public:
-		EventConverter(std::string eventNew);
+		EventConverter(std::string_view eventNew) noexcept;
 
-		operator int32_t();
+		operator GatewayEventType() const noexcept;
 
 	  protected:
-		std::string eventValue{};
+		GatewayEventType eventValue{};
+	};
+
+	/// \brief A streaming inflate context for a zlib-stream gateway connection.
+	class DiscordCoreAPI_Dll ZlibDecompressor {
+	  public:
+		ZlibDecompressor() noexcept = default;
+
+		bool initialize() noexcept;
+
+		bool decompress(std::string_view dataToDecompress) noexcept;
+
+		std::string_view getDecompressedData() noexcept;
+
+		bool isItInitialized() noexcept;
+
+		bool isItComplete() noexcept;
+
+		void clearOutput() noexcept;
+
+		~ZlibDecompressor() noexcept;
+
+	  protected:
+		static constexpr std::string_view zlibSuffix{ "\x00\x00\xff\xff", 4 };
+		std::string outputBuffer{};
+		bool haveWeInitialized{};
+		bool areWeComplete{};
+		size_t outputSize{};
+		z_stream stream{};
 	};
 
 	/// \brief For the opcodes that could be sent/received via Discord's websockets.
@@ -64,17 +168,155 @@ namespace DiscordCoreInternal {
 
 	enum class WebSocketState { Connecting = 0, Upgrading = 1, Collecting_Hello = 2, Sending_Identify = 3, Authenticated = 4, Disconnected = 5 };
 
+	/// \brief The outbound lanes of a gateway shard, drained in this order.
+	enum class SendLane : uint8_t {
+		Control = 0,///< Heartbeats, identifies and resumes.
+		State_Update = 1,///< Voice state and presence updates.
+		Bulk = 2,///< Guild member requests.
+	};
+
+	enum class TimerType : uint8_t {
+		Heartbeat = 0,///< A heartbeat is due, unless the previous one was never acknowledged, in which case the connection is a zombie.
+		Reconnect = 1,///< A shard's reconnect backoff has run out.
+		Event_Flush = 2,///< A shard's budgets may have room again for the events they are holding back.
+		Presence_Flush = 3,///< A shard's presence coalescing window has run out.
+		Handshake_Timeout = 4///< A shard may have gone too long without its Hello, or without its Ready once the Hello came.
+	};
+
+	struct DiscordCoreAPI_Dll TimerEntry {
+		uint64_t generation{};///< The shard's timer generation at the time of scheduling, which goes stale when the shard disconnects.
+		uint64_t deadline{};///< In ticks of one millisecond since the wheel's creation.
+		uint32_t shardId{};
+		TimerType type{};
+	};
+
+	/// \brief A hierarchical timer wheel: four levels of 64 slots, where each level's slots span 64 times those of the level below.
+	/// A timer sits at the highest level on which its deadline differs from the current tick, and moves down a level whenever its
+	/// slot comes due, until it reaches level zero and fires. Advancing jumps straight from one occupied slot to the next.
+	class DiscordCoreAPI_Dll TimerWheel {
+	  public:
+		TimerWheel() noexcept;
+
+		void schedule(uint32_t shardId, TimerType type, uint64_t generation, Milliseconds delay) noexcept;
+
+		/// \brief Returns how long until a slot comes due, at most maxTimeToWait.
+		Milliseconds getTimeUntilNextDeadline(Milliseconds maxTimeToWait) noexcept;
+
+		/// \brief Advances the wheel to the current time, and returns the timers that have come due in the meantime.
+		std::vector<TimerEntry> collectExpired() noexcept;
+
+	  protected:
+		static constexpr uint64_t slotBits{ 6 };
+		static constexpr uint64_t slotCount{ 1ull << slotBits };
+		static constexpr uint64_t levelCount{ 4 };
+		static constexpr uint64_t wheelSpan{ 1ull << (slotBits * levelCount) };
+
+		std::array<std::array<std::vector<TimerEntry>, slotCount>, levelCount> slots{};
+		std::chrono::steady_clock::time_point startTime{};
+		std::array<uint64_t, levelCount> occupiedSlots{};
+		std::vector<TimerEntry> overflowEntries{};
+		std::vector<TimerEntry> dueEntries{};
+		uint64_t currentTick{};
+		std::mutex accessMutex{};
+
+		uint64_t getCurrentTick() noexcept;
+
+		void insertEntry(TimerEntry&& entry) noexcept;
+
+		void reinsertOverflow() noexcept;
+
+		uint64_t getNextSlotTick() noexcept;
+	};
+
+	/// \brief A histogram of latencies over a rolling window, in logarithmic buckets of four sub-buckets per power of two.
+	/// Samples go into the current window, which replaces the previous one once a minute; summaries cover both.
+	class DiscordCoreAPI_Dll LatencyHistogram {
+	  public:
+		void record(Nanoseconds value) noexcept;
+
+		DiscordCoreAPI::LatencySummary getSummary() noexcept;
+
+	  protected:
+		static constexpr uint64_t subBucketBits{ 2 };
+		static constexpr uint64_t bucketCount{ 64ull << subBucketBits };
+		static constexpr Seconds windowLength{ 60 };
+
+		struct Window {
+			std::array<uint32_t, bucketCount> counts{};
+			uint64_t sampleCount{};
+			uint64_t maxValue{};
+		};
+
+		std::chrono::steady_clock::time_point windowStart{ std::chrono::steady_clock::now() };
+		std::array<Window, 2> windows{};///< The current window, followed by the previous one.
+		std::mutex accessMutex{};
+
+		static uint64_t getBucketIndex(uint64_t value) noexcept;
+
+		static uint64_t getBucketUpperBound(uint64_t index) noexcept;
+
+		void rotateWindows() noexcept;
+	};
+
+	/// \brief A shard's budget for the events of one type, as a token bucket that holds a second's worth of them.
+	/// Only the shard's own thread touches it, aside from the counters.
+	struct DiscordCoreAPI_Dll EventBudgetState {
+		std::chrono::steady_clock::time_point lastRefill{ std::chrono::steady_clock::now() };
+		std::atomic_uint64_t droppedForQueueDepth{};
+		std::atomic_uint64_t pendingDispatches{};///< How many of them are waiting on, or being handled by, the dispatch pool.
+		std::atomic_uint64_t droppedForRate{};
+		std::atomic_uint64_t coalesced{};
+		DiscordCoreAPI::EventBudget budget{};
+		std::function<void()> heldEvent{};///< Under the Coalesce policy, hands the latest of them that went over budget to the subscribers.
+		std::mutex heldEventMutex{};///< Guards heldEvent, which is filled in wherever the event was decoded.
+		std::string eventName{};
+		bool isItHolding{};///< Whether the shard's thread has held one of them back since the last flush.
+		double tokens{};
+
+		/// \brief Hands the held event, if there is one, to the subscribers.
+		void flushHeldEvent() noexcept;
+
+		bool tryTakeToken() noexcept;
+
+		Milliseconds getTimeUntilNextToken() noexcept;
+
+	  protected:
+		void refillTokens() noexcept;
+	};
+
+	/// \brief The latest presence update of a user, held back until the shard's coalescing window runs out.
+	struct DiscordCoreAPI_Dll HeldPresenceUpdate {
+		EventDecodeMode decodeMode{};
+		std::string payload{};
+	};
+
 	class DiscordCoreAPI_Dll WebSocketCore : public ErlParser, public TCPSSLClient {
 	  public:
+		friend class DiscordCoreAPI::DiscordCoreClient;
+
 		WebSocketCore(DiscordCoreAPI::ConfigManager* configManagerNew, WebSocketType typeOfWebSocketNew);
 
+		/// \brief Opens the connection and sends the upgrade request, without waiting for the response, which handleBuffer() takes care of.
+		bool startConnecting(const std::string& baseUrl, const std::string& relativePath, const uint16_t portNew, bool doWePrintErrorsNew,
+			bool areWeAStandaloneSocketNew) noexcept;
+
+		/// \brief Opens the connection, and waits for up to five seconds for it to be upgraded.
 		bool connect(const std::string& baseUrl, const std::string& relativePath, const uint16_t portNew, bool doWePrintErrorsNew,
 			bool areWeAStandaloneSocketNew) noexcept;
 
+		static constexpr uint64_t maxFrameHeaderSize{ 14 };
+
+		/// \brief Writes the frame header for a payload of payloadSize bytes into header, and returns the header's length.
+		static uint64_t createHeader(char* header, uint64_t payloadSize, WebSocketOpCode opCode) noexcept;
+
 		void createHeader(std::string& outBuffer, WebSocketOpCode opCode) noexcept;
 
+		/// \brief Called with each complete payload, which is always followed by at least StringBuffer::paddingSize readable bytes.
 		virtual bool onMessageReceived(std::string_view message) noexcept = 0;
 
+		/// \brief Frames and sends a payload, without moving the payload to make room for the header.
+		virtual bool sendMessage(std::string_view dataToSend, WebSocketOpCode opCode, bool priority) noexcept;
+
 		bool sendMessage(std::string& dataToSend, bool priority) noexcept;
 
 		void parseConnectionHeaders(std::string_view stringNew) noexcept;
@@ -92,9 +334,13 @@ namespace DiscordCoreInternal {
 	  protected:
 		std::unique_ptr<DiscordCoreAPI::ConnectionPackage> connections{ nullptr };
 		DiscordCoreAPI::StopWatch<Milliseconds> heartBeatStopWatch{ 20000ms };
+		std::chrono::steady_clock::time_point heartbeatSentTime{};
+		std::atomic_uint64_t messagesProcessed{};
+		std::atomic_uint64_t processingTime{};
 		DiscordCoreAPI::ConfigManager* configManager{};
 		std::atomic<WebSocketState> currentState{};
 		std::atomic_bool areWeConnecting{ true };
+		ZlibDecompressor zlibDecompressor{};
 		bool haveWeReceivedHeartbeatAck{ true };
 		const uint32_t maxReconnectTries{ 10 };
 		uint32_t currentReconnectTries{};
@@ -116,7 +362,9 @@ namespace DiscordCoreInternal {
 		friend struct DiscordCoreAPI::OnVoiceStateUpdateData;
 		friend class DiscordCoreAPI::VoiceConnection;
 		friend class DiscordCoreAPI::BotUser;
+		friend class DiscordCoreAPI::DiscordCoreClient;
 		friend class BaseSocketAgent;
+		friend class GatewayProxyConsumer;
 		friend class WebSocketCore;
 		friend class TCPSSLClient;
 
@@ -126,6 +374,75 @@ namespace DiscordCoreInternal {
 
 		bool onMessageReceived(std::string_view message) noexcept;
 
+		EventDecodeMode getEventDecodeMode(GatewayEventType eventType, bool doWeIgnoreSubscribers = false) noexcept;
+
+		bool onEtfDispatch(GatewayEventType eventType, EventDecodeMode decodeMode, DiscordCoreAPI::EtfValue dValue);
+
+		void onJsonDispatch(GatewayEventType eventType, EventDecodeMode decodeMode, WebSocketMessage& message, simdjson::ondemand::value dValue);
+
+		/// \brief Whether a dispatch is to be decoded on the client's dispatch pool, rather than on the shard's thread.
+		bool doWeOffloadDispatch(GatewayEventType eventType, uint64_t payloadSize) noexcept;
+
+		/// \brief Decodes and dispatches a copy of a payload on one of the dispatch pool's threads.
+		void onOffloadedDispatch(std::string& payload, GatewayEventType eventType, EventDecodeMode decodeMode) noexcept;
+
+		/// \brief Keeps an event from its handlers, by lowering its decode mode, or holds it back, if it goes over its type's budget.
+		EventDecodeMode applyEventBudget(GatewayEventType eventType, EventDecodeMode decodeMode) noexcept;
+
+		/// \brief Hands over whichever held events their budgets now have room for, and schedules another flush for the rest.
+		void flushHeldEvents() noexcept;
+
+		/// \brief Hands an event to its subscribers, dropping whichever one of its type is held back, or holds it back in that one's place.
+		template<typename EventTy, typename DataTy>
+		void dispatchEvent(GatewayEventType eventType, EventDecodeMode decodeMode, EventTy& event, std::unique_ptr<DataTy>& dataPackage) {
+			auto eventBudget = this->eventBudgets.find(eventType);
+			if (eventBudget == this->eventBudgets.end()) {
+				event(*dataPackage);
+				return;
+			}
+			std::unique_lock lock{ eventBudget->second.heldEventMutex };
+			if (eventBudget->second.heldEvent) {
+				++eventBudget->second.coalesced;
+			}
+			if (decodeMode == EventDecodeMode::Held) {
+				eventBudget->second.heldEvent = [&event, dataPackageNew = std::shared_ptr<DataTy>{ std::move(dataPackage) }] {
+					event(*dataPackageNew);
+				};
+				return;
+			}
+			eventBudget->second.heldEvent = nullptr;
+			lock.unlock();
+			event(*dataPackage);
+		}
+
+		/// \brief Holds a presence update back, in place of whichever one of the same user's, in the same Guild, it is holding already.
+		void holdPresenceUpdate(std::string_view payload, uint64_t guildId, uint64_t userId, EventDecodeMode decodeMode) noexcept;
+
+		/// \brief Hands over the held presence updates, once the coalescing window that they were held for has run out.
+		void flushHeldPresenceUpdates() noexcept;
+
+		/// \brief Caches a chunk's members in one batch, and reports the chunk to whoever requested it before handing it to the subscribers.
+		void onGuildMembersChunk(DiscordCoreAPI::GuildMembersChunkEventData&& chunk, EventDecodeMode decodeMode);
+
+		using WebSocketCore::sendMessage;
+
+		/// \brief Queues a payload on the control lane if it is a priority one, and on the state update lane otherwise.
+		bool sendMessage(std::string_view dataToSend, WebSocketOpCode opCode, bool priority) noexcept override;
+
+		/// \brief Frames a payload and queues it on the given lane, to be sent once the gateway's rate limit allows it.
+		bool sendMessage(std::string_view dataToSend, SendLane lane) noexcept;
+
+		/// \brief Writes as many queued frames as the token bucket allows, packing the small ones into shared TLS writes.
+		bool flushSendQueue() noexcept;
+
+		DiscordCoreAPI::GatewaySendQueueData getSendQueueData() noexcept;
+
+		DiscordCoreAPI::ShardLatencyData getLatencyData() noexcept;
+
+		DiscordCoreAPI::ShardLoadData getLoadData() noexcept;
+
+		std::vector<DiscordCoreAPI::EventShedData> getEventShedData() noexcept;
+
 		void disconnect() noexcept;
 
 		void onClosed() noexcept;
@@ -133,8 +450,34 @@ namespace DiscordCoreInternal {
 		virtual ~WebSocketClient() noexcept;
 
 	  protected:
+		static constexpr uint64_t laneCapacities[3]{ 64, 256, 1024 };
+		static constexpr double sendTokensPerSecond{ 2.0 };
+		static constexpr double sendTokenCapacity{ 120.0 };
+		static constexpr double controlTokenReserve{ 4.0 };
+
+		std::array<std::deque<std::string>, 3> sendLanes{};
+		std::chrono::steady_clock::time_point lastTokenRefill{};
+		std::atomic_uint64_t sendQueueDepth{};
+		std::atomic_uint64_t sendQueueDrops{};
+		double sendTokens{ sendTokenCapacity };
+		std::atomic_uint64_t framesSent{};
+		std::atomic_uint64_t tlsWrites{};
+		std::mutex sendMutex{};
 		std::unordered_map<uint64_t, DiscordCoreAPI::UnboundedMessageBlock<VoiceConnectionData>*> voiceConnectionDataBuffersMap{};
+		std::unordered_map<GatewayEventType, EventBudgetState> eventBudgets{};///< Filled in on construction, never changed after.
+		std::map<std::pair<uint64_t, uint64_t>, HeldPresenceUpdate> heldPresenceUpdates{};///< Keyed by Guild id, then by User id.
+		std::atomic_uint64_t presenceUpdatesCoalesced{};
+		std::unique_ptr<EventJournal> eventJournal{ nullptr };
+		std::unordered_map<std::string, DiscordCoreAPI::UnboundedMessageBlock<DiscordCoreAPI::GuildMembersProgressData>*>
+			memberRequestBuffersMap{};
+		std::mutex memberRequestMutex{};
+		std::atomic_uint64_t pendingDispatches{};
+		std::atomic_uint64_t timerGeneration{};
+		LatencyHistogram heartbeatRoundTrip{};
+		LatencyHistogram dispatchLatency{};
+		LatencyHistogram frameParseTime{};
 		DiscordCoreAPI::DiscordCoreClient* discordCoreClient{ nullptr };
+		TimerWheel* timerWheel{ nullptr };
 		VoiceConnectionData voiceConnectionData{};
 		std::atomic_bool* doWeQuit{ nullptr };
 		simdjson::ondemand::parser parser{};
@@ -142,10 +485,32 @@ namespace DiscordCoreInternal {
 		bool serverUpdateCollected{};
 		bool stateUpdateCollected{};
 		bool areWeCollectingData{};
+		bool isItFlushScheduled{};
+		bool isItPresenceFlushScheduled{};
+		bool areWeProxied{};///< Set on stand-ins, such as a gateway proxy consumer's, which dispatch without ever connecting.
 		std::string resumeUrl{};
 		std::string sessionId{};
 	};
 
+	/// \brief Serializes the identifies of the shards that share a max_concurrency bucket, keeping them one window apart.
+	struct DiscordCoreAPI_Dll IdentifyBucket {
+		DiscordCoreAPI::StopWatch<Milliseconds> stopWatch{ 5250ms };
+		std::mutex accessMutex{};
+		bool haveWeIdentified{};
+
+		/// \brief Takes the bucket's window, and returns 0ms, if it is open, or else returns how long it has left.
+		Milliseconds tryTakeWindow() noexcept;
+	};
+
+	/// \brief A shard's progress through its handshake, which its agent follows from one pass of its loop to the next.
+	struct DiscordCoreAPI_Dll ShardHandshake {
+		DiscordCoreAPI::StopWatch<Milliseconds> timeoutStopWatch{ 5000ms };///< Restarted for the Ready once the Hello has arrived.
+		DiscordCoreAPI::StopWatch<Milliseconds> startupStopWatch{ 0ms };
+		DiscordCoreAPI::ShardStartupData startupData{};
+		ClusterClient* clusterClient{ nullptr };///< Set while the shard holds the cluster's identify window, which it gives back with the Hello.
+		bool haveWeReceivedHello{};
+	};
+
 	class DiscordCoreAPI_Dll BaseSocketAgent {
 	  public:
 		friend class DiscordCoreAPI::DiscordCoreClient;
@@ -157,17 +522,61 @@ namespace DiscordCoreInternal {
 
 		std::jthread* getTheTask() noexcept;
 
+		/// \brief Collects the latencies of each of the agent's shards.
+		std::vector<DiscordCoreAPI::ShardLatencyData> getLatencyData() noexcept;
+
+		/// \brief Collects the processing time and message count of each of the agent's shards.
+		std::vector<DiscordCoreAPI::ShardLoadData> getLoadData() noexcept;
+
+		/// \brief Hands a live shard over to another agent, without reconnecting it, once this agent's thread gets around to it.
+		/// Shards that are not yet authenticated, or that are on an io_uring ring, stay where they are.
+		void migrateShard(uint32_t shardId, BaseSocketAgent* targetAgent) noexcept;
+
+		/// \brief Stops the agent's thread, and waits for it to finish.
+		void stop() noexcept;
+
 		~BaseSocketAgent() noexcept;
 
 	  protected:
+		std::unordered_map<uint32_t, DiscordCoreAPI::StopWatch<Milliseconds>> identifyQueueStopWatches{};///< For the shards waiting on a bucket.
+		std::unordered_map<uint32_t, DiscordCoreAPI::ConnectionPackage> pendingConnections{};
+		std::unordered_map<uint32_t, ShardHandshake> handshakes{};///< For the shards that are connected, but not yet Ready.
 		std::unordered_map<uint32_t, std::unique_ptr<WebSocketClient>> shardMap{};
+		std::vector<std::pair<uint32_t, BaseSocketAgent*>> outgoingShards{};
+		std::vector<std::unique_ptr<WebSocketClient>> incomingShards{};
 		DiscordCoreAPI::DiscordCoreClient* discordCoreClient{ nullptr };
 		std::unique_ptr<std::jthread> taskThread{ nullptr };
 		DiscordCoreAPI::ConfigManager* configManager{};
 		std::atomic_bool* doWeQuit{ nullptr };
 		uint32_t currentBaseSocketAgent{};
+#ifdef __linux__
+		EpollWrapper epoll{};
+	#ifdef DCA_IO_URING
+		IoUringWrapper ioUring{};
+	#endif
+#endif
+		TimerWheel timerWheel{};
+		std::shared_mutex shardMapMutex{};///< Held by this agent while it adds or removes shards, and by other threads while they read them.
+		std::mutex migrationMutex{};
 		std::mutex accessMutex{};
 
+		int32_t getMsUntilNextDeadline() noexcept;
+
+		/// \brief Sends a heartbeat or reconnects a shard, unless the timer went stale when its shard disconnected.
+		void onTimerExpired(const TimerEntry& entry) noexcept;
+
+		/// \brief Records the Hello and the Ready of each shard that is still handshaking, as they arrive.
+		void processHandshakes() noexcept;
+
+		/// \brief Stops following a shard's handshake, giving back the cluster's identify window if the shard still holds it.
+		std::unordered_map<uint32_t, ShardHandshake>::iterator eraseHandshake(
+			std::unordered_map<uint32_t, ShardHandshake>::iterator iterator) noexcept;
+
+		/// \brief Hands this agent's outgoing shards to their new agents, and takes on the ones handed to this agent.
+		void processMigrations() noexcept;
+
+		void wakeUp() noexcept;
+
 		void run(std::stop_token) noexcept;
 	};
 
@@ -0,0 +1,129 @@
+/*
+	DiscordCoreAPI, A bot library for Discord, written in C++, and featuring explicit multithreading through the usage of custom, asynchronous C++ CoRoutines.
+
+	Copyright 2021, 2022 Chris M. (RealTimeChris)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 2.1 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+	USA
+*/
+/// EscapeCharacters.cpp - Equivalence check and benchmark for ErlParser::escapeCharacters().
+/// Oct 17, 2026
+/// https://discordcoreapi.com
+/// \file EscapeCharacters.cpp
+
+#include <discordcoreapi/ErlParser.hpp>
+#include <chrono>
+#include <iostream>
+#include <random>
+
+/// \brief Exposes the ErlParser escaping routines to this benchmark.
+struct EscapeBenchmark : public DiscordCoreInternal::ErlParser {
+	using DiscordCoreInternal::ErlParser::escapeCharacter;
+	using DiscordCoreInternal::ErlParser::escapeCharacters;
+
+	/// \brief The per-byte loop that escapeCharacters() falls back to without __AVX2__.
+	static char* escapeCharactersScalar(const char* data, size_t length, char* outPtr) noexcept {
+		for (size_t x = 0; x < length; ++x) {
+			outPtr = escapeCharacter(data[x], outPtr);
+		}
+		return outPtr;
+	}
+};
+
+/// \brief Returns a string of the given length, mixing plain text with quotes, apostrophes, backslashes and control bytes.
+std::string generateInput(std::mt19937_64& engine, size_t length) {
+	static constexpr char specials[]{ '"', '\'', '\\', 0x00, 0x01, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x7F };
+	std::uniform_int_distribution<uint32_t> kind{ 0, 15 };
+	std::uniform_int_distribution<uint32_t> byte{ 0, 255 };
+	std::uniform_int_distribution<uint32_t> special{ 0, std::size(specials) - 1 };
+	std::string returnValue(length, '\0');
+	for (auto& value: returnValue) {
+		switch (kind(engine)) {
+			case 0: {
+				value = specials[special(engine)];
+				break;
+			}
+			case 1: {
+				value = static_cast<char>(byte(engine));
+				break;
+			}
+			default: {
+				value = static_cast<char>('a' + byte(engine) % 26);
+				break;
+			}
+		}
+	}
+	return returnValue;
+}
+
+/// \brief Escapes the data with both paths and returns whether their outputs match byte-for-byte.
+bool checkEquivalence(const std::string& data) {
+	std::string vectorOutput(data.size() * 2, '\0');
+	std::string scalarOutput(data.size() * 2, '\0');
+	size_t vectorLength = static_cast<size_t>(EscapeBenchmark::escapeCharacters(data.data(), data.size(), vectorOutput.data()) - vectorOutput.data());
+	size_t scalarLength =
+		static_cast<size_t>(EscapeBenchmark::escapeCharactersScalar(data.data(), data.size(), scalarOutput.data()) - scalarOutput.data());
+	return vectorLength == scalarLength && std::equal(vectorOutput.data(), vectorOutput.data() + vectorLength, scalarOutput.data());
+}
+
+/// \brief Returns the mean time, in microseconds, for the given escaping function to process the data.
+template<typename FTy> double timeEscaping(FTy function, const std::string& data, std::string& output, size_t iterations) {
+	size_t checksum{};
+	auto startTime = std::chrono::steady_clock::now();
+	for (size_t x = 0; x < iterations; ++x) {
+		checksum += static_cast<size_t>(function(data.data(), data.size(), output.data()) - output.data());
+	}
+	auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - startTime);
+	if (checksum != iterations * static_cast<size_t>(function(data.data(), data.size(), output.data()) - output.data())) {
+		std::cout << "Inconsistent output length while timing." << std::endl;
+	}
+	return elapsed.count() / static_cast<double>(iterations);
+}
+
+int32_t main() {
+#if defined(__AVX2__)
+	std::cout << "escapeCharacters() was built with AVX2." << std::endl;
+#else
+	std::cout << "escapeCharacters() was built without AVX2, so both paths are scalar." << std::endl;
+#endif
+	std::mt19937_64 engine{ 0x0DCA };
+	std::uniform_int_distribution<size_t> lengths{ 0, 300 };
+	const size_t inputCount{ 20000 };
+	size_t mismatches{};
+	for (size_t x = 0; x < inputCount; ++x) {
+		if (!checkEquivalence(generateInput(engine, lengths(engine)))) {
+			++mismatches;
+		}
+	}
+	std::cout << "Equivalence: " << inputCount - mismatches << " of " << inputCount << " randomized inputs matched byte-for-byte." << std::endl;
+
+	std::string text(1024 * 1024, '\0');
+	for (size_t x = 0; x < text.size(); ++x) {
+		text[x] = (x % 97 == 96) ? '"' : static_cast<char>('a' + x % 26);
+	}
+	if (!checkEquivalence(text)) {
+		++mismatches;
+		std::cout << "Equivalence: the 1 MiB text did not match." << std::endl;
+	}
+	std::string output(text.size() * 2, '\0');
+	const size_t iterations{ 200 };
+	double vectorTime = timeEscaping(&EscapeBenchmark::escapeCharacters, text, output, iterations);
+	double scalarTime = timeEscaping(&EscapeBenchmark::escapeCharactersScalar, text, output, iterations);
+	std::cout << "1 MiB of text with a quote every 97 bytes, mean of " << iterations << " runs:" << std::endl;
+	std::cout << "escapeCharacters(): " << vectorTime << "us" << std::endl;
+	std::cout << "Scalar loop: " << scalarTime << "us" << std::endl;
+	std::cout << "Speedup: " << scalarTime / vectorTime << "x" << std::endl;
+	return mismatches == 0 ? 0 : 1;
+}
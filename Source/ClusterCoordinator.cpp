@@ -0,0 +1,503 @@
+/*
+	DiscordCoreAPI, A bot library for Discord, written in C++, and featuring explicit multithreading through the usage of custom, asynchronous C++ CoRoutines.
+
+	Copyright 2021, 2022 Chris M. (RealTimeChris)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 2.1 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+	USA
+*/
+/// ClusterCoordinator.cpp - Source file for sharing one bot's shards between several processes.
+/// Oct 17, 2022
+/// https://discordcoreapi.com
+/// \file ClusterCoordinator.cpp
+
+#include <discordcoreapi/ClusterCoordinator.hpp>
+#include <discordcoreapi/DiscordCoreClient.hpp>
+#include <sstream>
+
+namespace DiscordCoreInternal {
+
+	// The messages, one per line:
+	// worker -> coordinator: "HELLO <pid>", "PING", "IDENTIFY <shard>", "DONE <shard>"
+	// coordinator -> worker: "WELCOME <total shards>", "PONG", "ASSIGN <starting shard> <shard count>", "GRANT <shard>"
+	// Each PONG renews the worker's lease on its ranges for another workerTimeout.
+
+	ClusterConnection::ClusterConnection(SOCKET socketNew) noexcept {
+		this->socket = socketNew;
+	}
+
+	bool ClusterConnection::sendMessage(const std::string& message) noexcept {
+#ifdef __linux__
+		std::unique_lock lock{ this->writeMutex };
+		std::string messageNew{ message + "\n" };
+		std::string_view remainingData{ messageNew };
+		while (remainingData.size() > 0) {
+			auto bytesWritten = ::send(this->socket, remainingData.data(), remainingData.size(), MSG_NOSIGNAL);
+			if (bytesWritten == SOCKET_ERROR) {
+				if (errno == EINTR) {
+					continue;
+				}
+				return false;
+			}
+			remainingData.remove_prefix(static_cast<uint64_t>(bytesWritten));
+		}
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	bool ClusterConnection::receiveMessages(std::vector<std::string>& messages) noexcept {
+#ifdef __linux__
+		char buffer[1024]{};
+		auto bytesRead = ::recv(this->socket, buffer, sizeof(buffer), 0);
+		if (bytesRead == 0 || (bytesRead == SOCKET_ERROR && errno != EINTR && errno != EWOULDBLOCK)) {
+			return false;
+		}
+		if (bytesRead > 0) {
+			this->inputBuffer.append(buffer, static_cast<uint64_t>(bytesRead));
+		}
+		uint64_t position{};
+		while ((position = this->inputBuffer.find('\n')) != std::string::npos) {
+			messages.emplace_back(this->inputBuffer.substr(0, position));
+			this->inputBuffer.erase(0, position + 1);
+		}
+		// Neither end ever sends a message this long, so whatever sent it is not speaking the protocol.
+		return this->inputBuffer.size() < maxMessageSize;
+#else
+		return false;
+#endif
+	}
+
+	SOCKET ClusterConnection::getSocket() noexcept {
+		return this->socket;
+	}
+
+	ClusterCoordinator::ClusterCoordinator(DiscordCoreAPI::ConfigManager* configManagerNew, uint32_t maxConcurrencyNew) noexcept {
+		this->configManager = configManagerNew;
+		this->maxConcurrency = std::max(maxConcurrencyNew, 1u);
+		this->identifyBuckets = std::make_unique<ClusterIdentifyBucket[]>(this->maxConcurrency);
+		uint32_t shardsPerWorker{ std::max(this->configManager->getClusterOptions().shardsPerWorker, 1u) };
+		for (uint32_t x = 0; x < this->configManager->getTotalShardCount(); x += shardsPerWorker) {
+			this->initialRanges.emplace_back(ShardRange{ x, std::min(shardsPerWorker, this->configManager->getTotalShardCount() - x) });
+		}
+	}
+
+	bool ClusterCoordinator::run(std::atomic_bool* doWeQuit) noexcept {
+#ifdef __linux__
+		DiscordCoreAPI::ClusterOptions clusterOptions{ this->configManager->getClusterOptions() };
+		SOCKETWrapper listenSocket{ ::socket(AF_UNIX, SOCK_STREAM, 0) };
+		sockaddr_un address{};
+		address.sun_family = AF_UNIX;
+		if (listenSocket == SOCKET_ERROR || clusterOptions.socketPath.size() >= sizeof(address.sun_path)) {
+			if (this->configManager->doWePrintGeneralErrorMessages()) {
+				cout << DiscordCoreAPI::shiftToBrightRed() << "Failed to create the cluster socket at " << clusterOptions.socketPath << "."
+					 << DiscordCoreAPI::reset() << endl
+					 << endl;
+			}
+			return false;
+		}
+		std::copy(clusterOptions.socketPath.begin(), clusterOptions.socketPath.end(), address.sun_path);
+		// A socket file left behind by a coordinator that did not shut down cleanly would keep the bind from succeeding.
+		::unlink(clusterOptions.socketPath.c_str());
+		if (::bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == SOCKET_ERROR ||
+			::listen(listenSocket, SOMAXCONN) == SOCKET_ERROR) {
+			if (this->configManager->doWePrintGeneralErrorMessages()) {
+				cout << DiscordCoreAPI::shiftToBrightRed() << "Failed to listen on the cluster socket at " << clusterOptions.socketPath << "."
+					 << DiscordCoreAPI::reset() << endl
+					 << endl;
+			}
+			return false;
+		}
+		if (this->configManager->doWePrintGeneralSuccessMessages()) {
+			cout << DiscordCoreAPI::shiftToBrightGreen() << "Coordinating " << this->configManager->getTotalShardCount() << " shards in "
+				 << this->initialRanges.size() << " ranges on " << clusterOptions.socketPath << "." << DiscordCoreAPI::reset() << endl
+				 << endl;
+		}
+		while (!doWeQuit->load()) {
+			std::vector<pollfd> polls{ pollfd{ listenSocket, POLLIN, 0 } };
+			std::vector<uint32_t> workerIds{};
+			for (auto& [key, value]: this->workers) {
+				polls.emplace_back(pollfd{ value.connection->getSocket(), POLLIN, 0 });
+				workerIds.emplace_back(key);
+			}
+			if (::poll(polls.data(), polls.size(), 100) == SOCKET_ERROR && errno != EINTR) {
+				break;
+			}
+			if (polls[0].revents & POLLIN) {
+				SOCKET socketNew = ::accept(listenSocket, nullptr, nullptr);
+				if (socketNew != SOCKET_ERROR) {
+					this->workers[this->workerCount++].connection = std::make_unique<ClusterConnection>(socketNew);
+				}
+			}
+			for (uint64_t x = 1; x < polls.size(); ++x) {
+				uint32_t workerId{ workerIds[x - 1] };
+				if (!(polls[x].revents & (POLLIN | POLLHUP | POLLERR)) || !this->workers.contains(workerId)) {
+					continue;
+				}
+				std::vector<std::string> messages{};
+				if (!this->workers[workerId].connection->receiveMessages(messages)) {
+					this->removeWorker(workerId, "disconnected");
+					continue;
+				}
+				this->workers[workerId].stopWatch.resetTimer();
+				for (auto& value: messages) {
+					this->onMessage(workerId, value);
+				}
+			}
+			std::vector<uint32_t> silentWorkers{};
+			for (auto& [key, value]: this->workers) {
+				if (value.stopWatch.totalTimePassed() >= clusterOptions.workerTimeout) {
+					silentWorkers.emplace_back(key);
+				}
+			}
+			for (auto& value: silentWorkers) {
+				this->removeWorker(value, "went silent", true);
+			}
+			this->releaseFencedRanges();
+			this->assignOrphanedRanges();
+			this->grantIdentifyWindows();
+		}
+		::unlink(clusterOptions.socketPath.c_str());
+		return true;
+#else
+		if (this->configManager->doWePrintGeneralErrorMessages()) {
+			cout << DiscordCoreAPI::shiftToBrightRed() << "Clustering needs Unix domain sockets, which this platform does not have."
+				 << DiscordCoreAPI::reset() << endl
+				 << endl;
+		}
+		return false;
+#endif
+	}
+
+	void ClusterCoordinator::onMessage(uint32_t workerId, const std::string& message) noexcept {
+		Worker& worker = this->workers[workerId];
+		std::istringstream stream{ message };
+		std::string command{};
+		stream >> command;
+		if (command == "HELLO") {
+			stream >> worker.processId;
+			worker.haveWeRegistered = true;
+			if (!worker.connection->sendMessage("WELCOME " + std::to_string(this->configManager->getTotalShardCount()))) {
+				this->removeWorker(workerId, "disconnected");
+				return;
+			}
+			if (this->configManager->doWePrintGeneralSuccessMessages()) {
+				cout << DiscordCoreAPI::shiftToBrightGreen() << "Worker " << worker.processId << " joined the cluster." << DiscordCoreAPI::reset()
+					 << endl
+					 << endl;
+			}
+			if (this->initialRanges.size() > 0 && this->assignShardRange(workerId, this->initialRanges.front())) {
+				this->initialRanges.pop_front();
+			}
+		} else if (command == "PING" && worker.haveWeRegistered) {
+			if (!worker.connection->sendMessage("PONG")) {
+				this->removeWorker(workerId, "disconnected");
+			}
+		} else if (command == "IDENTIFY" && worker.haveWeRegistered) {
+			uint32_t shardId{};
+			if (stream >> shardId && shardId < this->configManager->getTotalShardCount()) {
+				this->identifyBuckets[shardId % this->maxConcurrency].waitingShards.emplace_back(workerId, shardId);
+			}
+		} else if (command == "DONE" && worker.haveWeRegistered) {
+			uint32_t shardId{};
+			if (stream >> shardId && shardId < this->configManager->getTotalShardCount()) {
+				ClusterIdentifyBucket& identifyBucket = this->identifyBuckets[shardId % this->maxConcurrency];
+				if (identifyBucket.isItHeld && identifyBucket.holderWorkerId == workerId && identifyBucket.holderShardId == shardId) {
+					identifyBucket.isItHeld = false;
+					identifyBucket.haveWeIdentified = true;
+					identifyBucket.stopWatch.resetTimer();
+				}
+			}
+		}
+	}
+
+	void ClusterCoordinator::removeWorker(uint32_t workerId, const std::string& reason, bool doWeFence) noexcept {
+		Worker& worker = this->workers[workerId];
+		if (worker.haveWeRegistered && this->configManager->doWePrintGeneralErrorMessages()) {
+			cout << DiscordCoreAPI::shiftToBrightRed() << "Worker " << worker.processId << " " << reason << ", leaving " << worker.shardCount
+				 << " shards to the rest of the cluster." << DiscordCoreAPI::reset() << endl
+				 << endl;
+		}
+		if (doWeFence) {
+			// A silent worker may yet be running its shards, so they only move once its lease has run out. The last PONG went out no later
+			// than the worker was last heard from, one workerTimeout ago, and the second one covers that PONG's way across.
+			FencedRanges& fencedRangesNew = this->fencedRanges.emplace_back();
+			fencedRangesNew.stopWatch = DiscordCoreAPI::StopWatch<Milliseconds>{ this->configManager->getClusterOptions().workerTimeout };
+			fencedRangesNew.shardRanges = worker.shardRanges;
+		} else {
+			this->orphanedRanges.insert(this->orphanedRanges.end(), worker.shardRanges.begin(), worker.shardRanges.end());
+		}
+		for (uint32_t x = 0; x < this->maxConcurrency; ++x) {
+			ClusterIdentifyBucket& identifyBucket = this->identifyBuckets[x];
+			std::erase_if(identifyBucket.waitingShards, [&](auto& value) {
+				return value.first == workerId;
+			});
+			// The worker may well have identified just before it went, so its window still runs its course.
+			if (identifyBucket.isItHeld && identifyBucket.holderWorkerId == workerId) {
+				identifyBucket.isItHeld = false;
+				identifyBucket.haveWeIdentified = true;
+				identifyBucket.stopWatch.resetTimer();
+			}
+		}
+		this->workers.erase(workerId);
+	}
+
+	void ClusterCoordinator::releaseFencedRanges() noexcept {
+		while (this->fencedRanges.size() > 0 && this->fencedRanges.front().stopWatch.hasTimePassed()) {
+			auto& shardRanges = this->fencedRanges.front().shardRanges;
+			this->orphanedRanges.insert(this->orphanedRanges.end(), shardRanges.begin(), shardRanges.end());
+			this->fencedRanges.pop_front();
+		}
+	}
+
+	bool ClusterCoordinator::assignShardRange(uint32_t workerId, const ShardRange& shardRange) noexcept {
+		Worker& worker = this->workers[workerId];
+		if (!worker.connection->sendMessage("ASSIGN " + std::to_string(shardRange.startingShard) + " " + std::to_string(shardRange.shardCount))) {
+			return false;
+		}
+		worker.shardRanges.emplace_back(shardRange);
+		worker.shardCount += shardRange.shardCount;
+		return true;
+	}
+
+	void ClusterCoordinator::assignOrphanedRanges() noexcept {
+		while (this->orphanedRanges.size() > 0) {
+			// The least busy worker takes the range, which makes it a standby worker's whenever there is one.
+			std::optional<uint32_t> workerId{};
+			for (auto& [key, value]: this->workers) {
+				if (value.haveWeRegistered && (!workerId || value.shardCount < this->workers[*workerId].shardCount)) {
+					workerId = key;
+				}
+			}
+			if (!workerId) {
+				return;
+			}
+			if (!this->assignShardRange(*workerId, this->orphanedRanges.front())) {
+				this->removeWorker(*workerId, "disconnected");
+				continue;
+			}
+			if (this->configManager->doWePrintGeneralSuccessMessages()) {
+				cout << DiscordCoreAPI::shiftToBrightBlue() << "Handed " << this->orphanedRanges.front().shardCount << " shards, from Shard "
+					 << this->orphanedRanges.front().startingShard + 1 << " on, to worker " << this->workers[*workerId].processId << "."
+					 << DiscordCoreAPI::reset() << endl
+					 << endl;
+			}
+			this->orphanedRanges.pop_front();
+		}
+	}
+
+	void ClusterCoordinator::grantIdentifyWindows() noexcept {
+		for (uint32_t x = 0; x < this->maxConcurrency; ++x) {
+			ClusterIdentifyBucket& identifyBucket = this->identifyBuckets[x];
+			// A worker that never reports back on its identify is not allowed to hold up the rest of the bucket for good.
+			if (identifyBucket.isItHeld && identifyBucket.heldStopWatch.hasTimePassed()) {
+				identifyBucket.isItHeld = false;
+				identifyBucket.haveWeIdentified = true;
+				identifyBucket.stopWatch.resetTimer();
+			}
+			while (!identifyBucket.isItHeld && identifyBucket.waitingShards.size() > 0 &&
+				(!identifyBucket.haveWeIdentified || identifyBucket.stopWatch.hasTimePassed())) {
+				auto [workerId, shardId] = identifyBucket.waitingShards.front();
+				identifyBucket.waitingShards.pop_front();
+				if (this->workers.contains(workerId) && this->workers[workerId].connection->sendMessage("GRANT " + std::to_string(shardId))) {
+					identifyBucket.heldStopWatch.resetTimer();
+					identifyBucket.holderWorkerId = workerId;
+					identifyBucket.holderShardId = shardId;
+					identifyBucket.isItHeld = true;
+				}
+			}
+		}
+	}
+
+	ClusterClient::ClusterClient(DiscordCoreAPI::DiscordCoreClient* discordCoreClientNew, std::atomic_bool* doWeQuitNew) noexcept {
+		this->discordCoreClient = discordCoreClientNew;
+		this->doWeQuit = doWeQuitNew;
+	}
+
+	uint32_t ClusterClient::connect() noexcept {
+#ifdef __linux__
+		DiscordCoreAPI::ClusterOptions clusterOptions{ this->discordCoreClient->configManager.getClusterOptions() };
+		this->connection = std::make_unique<ClusterConnection>(::socket(AF_UNIX, SOCK_STREAM, 0));
+		sockaddr_un address{};
+		address.sun_family = AF_UNIX;
+		if (this->connection->getSocket() == SOCKET_ERROR || clusterOptions.socketPath.size() >= sizeof(address.sun_path)) {
+			return 0;
+		}
+		std::copy(clusterOptions.socketPath.begin(), clusterOptions.socketPath.end(), address.sun_path);
+		if (::connect(this->connection->getSocket(), reinterpret_cast<sockaddr*>(&address), sizeof(address)) == SOCKET_ERROR ||
+			!this->connection->sendMessage("HELLO " + std::to_string(::getpid()))) {
+			return 0;
+		}
+		DiscordCoreAPI::StopWatch<Milliseconds> stopWatch{ 10000ms };
+		while (!stopWatch.hasTimePassed() && !this->doWeQuit->load()) {
+			pollfd readPoll{ this->connection->getSocket(), POLLIN, 0 };
+			if (::poll(&readPoll, 1, 100) > 0 && !this->connection->receiveMessages(this->pendingMessages)) {
+				return 0;
+			}
+			for (uint64_t x = 0; x < this->pendingMessages.size(); ++x) {
+				std::istringstream stream{ this->pendingMessages[x] };
+				std::string command{};
+				uint32_t totalShardCount{};
+				if (stream >> command >> totalShardCount && command == "WELCOME") {
+					// Whatever came in behind the welcome is left for the client's thread, once start() has been called.
+					this->pendingMessages.erase(this->pendingMessages.begin(), this->pendingMessages.begin() + static_cast<int64_t>(x) + 1);
+					this->areWeConnected = true;
+					return totalShardCount;
+				}
+			}
+		}
+		return 0;
+#else
+		return 0;
+#endif
+	}
+
+	void ClusterClient::start() noexcept {
+		this->taskThread = std::make_unique<std::jthread>([this](std::stop_token token) {
+			this->run(token);
+		});
+	}
+
+	bool ClusterClient::requestIdentifyWindow(uint32_t shardId) noexcept {
+		std::unique_lock lock{ this->accessMutex };
+		if (!this->areWeConnected) {
+			return false;
+		}
+		if (!this->requestedShards.emplace(shardId).second) {
+			return true;
+		}
+		lock.unlock();
+		return this->connection->sendMessage("IDENTIFY " + std::to_string(shardId));
+	}
+
+	bool ClusterClient::takeIdentifyWindow(uint32_t shardId) noexcept {
+		std::unique_lock lock{ this->accessMutex };
+		if (this->grantedShards.erase(shardId) == 0) {
+			return false;
+		}
+		this->requestedShards.erase(shardId);
+		return true;
+	}
+
+	void ClusterClient::releaseIdentifyWindow(uint32_t shardId) noexcept {
+		this->connection->sendMessage("DONE " + std::to_string(shardId));
+	}
+
+	void ClusterClient::onMessage(const std::string& message) noexcept {
+		std::istringstream stream{ message };
+		std::string command{};
+		stream >> command;
+		if (command == "ASSIGN") {
+			uint32_t startingShard{};
+			uint32_t shardCount{};
+			if (stream >> startingShard >> shardCount) {
+				if (this->discordCoreClient->configManager.doWePrintGeneralSuccessMessages()) {
+					cout << DiscordCoreAPI::shiftToBrightBlue() << "The cluster coordinator handed this process " << shardCount
+						 << " shards, from Shard " << startingShard + 1 << " on." << DiscordCoreAPI::reset() << endl
+						 << endl;
+				}
+				this->discordCoreClient->addShards(startingShard, shardCount);
+			}
+		} else if (command == "GRANT") {
+			uint32_t shardId{};
+			if (stream >> shardId) {
+				std::unique_lock lock{ this->accessMutex };
+				this->grantedShards.emplace(shardId);
+			}
+		}
+	}
+
+	void ClusterClient::onDisconnected(const std::string& reason) noexcept {
+		// Without a coordinator there is no telling whether this process's shards are already being run by another, so it stops running them.
+		if (this->discordCoreClient->configManager.doWePrintGeneralErrorMessages()) {
+			cout << DiscordCoreAPI::shiftToBrightRed() << reason << "... quitting." << DiscordCoreAPI::reset() << endl << endl;
+		}
+		std::unique_lock lock{ this->accessMutex };
+		this->areWeConnected = false;
+		lock.unlock();
+		this->doWeQuit->store(true);
+	}
+
+	void ClusterClient::run(std::stop_token token) noexcept {
+#ifdef __linux__
+		Milliseconds workerTimeout{ this->discordCoreClient->configManager.getClusterOptions().workerTimeout };
+		DiscordCoreAPI::StopWatch<Milliseconds> pingStopWatch{ std::max(workerTimeout / 4, Milliseconds{ 100 }) };
+		DiscordCoreAPI::StopWatch<Milliseconds> leaseStopWatch{ workerTimeout };
+		std::vector<std::string> messages{ std::move(this->pendingMessages) };
+		while (!token.stop_requested() && !this->doWeQuit->load()) {
+			for (auto& value: messages) {
+				if (value == "PONG") {
+					leaseStopWatch.resetTimer();
+				}
+				this->onMessage(value);
+			}
+			messages.clear();
+			// Past this point the coordinator may already have handed this process's shards to another worker.
+			if (leaseStopWatch.hasTimePassed()) {
+				this->onDisconnected("The cluster coordinator stopped renewing this process's lease");
+				return;
+			}
+			if (pingStopWatch.hasTimePassed()) {
+				pingStopWatch.resetTimer();
+				if (!this->connection->sendMessage("PING")) {
+					this->onDisconnected("Lost the connection to the cluster coordinator");
+					return;
+				}
+			}
+			pollfd readPoll{ this->connection->getSocket(), POLLIN, 0 };
+			auto result = ::poll(&readPoll, 1, 100);
+			if ((result == SOCKET_ERROR && errno != EINTR) || (result > 0 && !this->connection->receiveMessages(messages))) {
+				this->onDisconnected("Lost the connection to the cluster coordinator");
+				return;
+			}
+		}
+#endif
+	}
+
+	ClusterClient::~ClusterClient() noexcept {
+		this->taskThread.reset(nullptr);
+	}
+
+	ClusterIdentifyLock::ClusterIdentifyLock(ClusterClient* clusterClientNew, uint32_t shardIdNew) noexcept {
+		this->clusterClient = clusterClientNew;
+		this->shardId = shardIdNew;
+		if (this->clusterClient) {
+			this->haveWeAcquired = this->clusterClient->takeIdentifyWindow(this->shardId);
+			if (!this->haveWeAcquired) {
+				this->clusterClient->requestIdentifyWindow(this->shardId);
+			}
+		}
+	}
+
+	ClusterIdentifyLock::operator bool() noexcept {
+		return !this->clusterClient || this->haveWeAcquired;
+	}
+
+	ClusterClient* ClusterIdentifyLock::release() noexcept {
+		if (!this->haveWeAcquired) {
+			return nullptr;
+		}
+		this->haveWeAcquired = false;
+		return this->clusterClient;
+	}
+
+	ClusterIdentifyLock::~ClusterIdentifyLock() noexcept {
+		if (this->haveWeAcquired) {
+			this->clusterClient->releaseIdentifyWindow(this->shardId);
+		}
+	}
+
+}
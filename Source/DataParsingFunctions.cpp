@@ -232,39 +232,235 @@ namespace DiscordCoreAPI {
 		return value;
 	}
 
+	void setPresenceStatus(PresenceUpdateFlags& data, PresenceClient client, std::string_view status) noexcept {
+		PresenceStatus statusNew{ PresenceStatus::Offline };
+		if (status == "online") {
+			statusNew = PresenceStatus::Online;
+		} else if (status == "idle") {
+			statusNew = PresenceStatus::Idle;
+		} else if (status == "dnd") {
+			statusNew = PresenceStatus::Dnd;
+		}
+		uint8_t offSet{ static_cast<uint8_t>(client) };
+		uint8_t dataNew = static_cast<uint8_t>(data) & ~(0b11 << offSet);
+		data = static_cast<PresenceUpdateFlags>(dataNew | (static_cast<uint8_t>(statusNew) << offSet));
+	}
+
 	void parseObject(simdjson::ondemand::value jsonData, PresenceUpdateFlags& data) {
-		uint8_t dataNew = static_cast<uint8_t>(data);
+		setPresenceStatus(data, PresenceClient::Desktop, getString(jsonData, "desktop"));
+
+		setPresenceStatus(data, PresenceClient::Mobile, getString(jsonData, "mobile"));
+
+		setPresenceStatus(data, PresenceClient::Web, getString(jsonData, "web"));
+	}
+
+	EtfValue::EtfValue(std::string_view dataNew, uint64_t offSetNew) noexcept {
+		this->dataBuffer = dataNew;
+		this->offSet = offSetNew;
+	}
+
+	EtfValue EtfValue::operator[](std::string_view key) const {
+		EtfValue returnValue{};
+		if (this->getType() != EtfType::Map_Ext) {
+			return returnValue;
+		}
+		uint64_t offSetNew{ this->offSet + 1 };
+		uint32_t length = this->readBits<uint32_t>(offSetNew);
+		for (uint32_t x = 0; x < length; ++x) {
+			EtfValue keyNew{ this->dataBuffer, offSetNew };
+			EtfValue value{ this->dataBuffer, keyNew.getEndOffset() };
+			if (keyNew.getStringView() == key) {
+				return value;
+			}
+			offSetNew = value.getEndOffset();
+		}
+		return returnValue;
+	}
+
+	std::string_view EtfValue::getStringView() const {
+		uint64_t offSetNew{ this->offSet + 1 };
+		uint64_t length{};
+		switch (this->getType()) {
+			case EtfType::Binary_Ext: {
+				length = this->readBits<uint32_t>(offSetNew);
+				break;
+			}
+			case EtfType::Atom_Ext: {
+				[[fallthrough]];
+			}
+			case EtfType::String_Ext: {
+				length = this->readBits<uint16_t>(offSetNew);
+				break;
+			}
+			case EtfType::Small_Atom_Ext: {
+				length = this->readBits<uint8_t>(offSetNew);
+				break;
+			}
+			default: {
+				return {};
+			}
+		}
+		if (offSetNew + length > this->dataBuffer.size()) {
+			throw DCAException{ "EtfValue::getStringView() Error: String reading past end of ETF buffer." };
+		}
+		return this->dataBuffer.substr(offSetNew, length);
+	}
 
-		auto stringNew = getString(jsonData, "dekstop");
+	uint64_t EtfValue::getEndOffset() const {
+		uint64_t offSetNew{ this->offSet + 1 };
+		switch (this->getType()) {
+			case EtfType::New_Float_Ext: {
+				offSetNew += 8;
+				break;
+			}
+			case EtfType::Small_Integer_Ext: {
+				offSetNew += 1;
+				break;
+			}
+			case EtfType::Integer_Ext: {
+				offSetNew += 4;
+				break;
+			}
+			case EtfType::Atom_Ext: {
+				[[fallthrough]];
+			}
+			case EtfType::String_Ext: {
+				offSetNew += this->readBits<uint16_t>(offSetNew);
+				break;
+			}
+			case EtfType::Small_Atom_Ext: {
+				offSetNew += this->readBits<uint8_t>(offSetNew);
+				break;
+			}
+			case EtfType::Binary_Ext: {
+				offSetNew += this->readBits<uint32_t>(offSetNew);
+				break;
+			}
+			case EtfType::Small_Big_Ext: {
+				offSetNew += this->readBits<uint8_t>(offSetNew) + 1ull;
+				break;
+			}
+			case EtfType::Nil_Ext: {
+				break;
+			}
+			case EtfType::List_Ext: {
+				uint32_t length = this->readBits<uint32_t>(offSetNew);
+				for (uint32_t x = 0; x < length + 1; ++x) {
+					offSetNew = EtfValue{ this->dataBuffer, offSetNew }.getEndOffset();
+				}
+				break;
+			}
+			case EtfType::Map_Ext: {
+				uint32_t length = this->readBits<uint32_t>(offSetNew);
+				for (uint64_t x = 0; x < length * 2ull; ++x) {
+					offSetNew = EtfValue{ this->dataBuffer, offSetNew }.getEndOffset();
+				}
+				break;
+			}
+			default: {
+				throw DCAException{ "EtfValue::getEndOffset() Error: Unknown data type in ETF, the type: " +
+					std::to_string(static_cast<uint8_t>(this->getType())) };
+			}
+		}
+		if (offSetNew > this->dataBuffer.size()) {
+			throw DCAException{ "EtfValue::getEndOffset() Error: Read past end of ETF buffer." };
+		}
+		return offSetNew;
+	}
 
-		if (stringNew == "online") {
-			dataNew += setBool(dataNew, PresenceUpdateFlags::Desktop_Online, true);
-		} else if (stringNew == "idle") {
-			dataNew += setBool(dataNew, PresenceUpdateFlags::Desktop_Idle, true);
-		} else if (stringNew == "dnd") {
-			dataNew += setBool(dataNew, PresenceUpdateFlags::Desktop_Dnd, true);
+	std::string EtfValue::getString() const {
+		if (this->isNull()) {
+			return "";
 		}
+		auto stringNew = this->getStringView();
+		return std::string{ stringNew.data(), stringNew.size() };
+	}
 
-		stringNew = getString(jsonData, "mobile");
+	uint64_t EtfValue::getUint64() const {
+		// Snowflakes arrive as strings, and those of 2^63 or more would not fit through getInt64().
+		if (this->getType() == EtfType::Binary_Ext) {
+			auto stringNew = this->getStringView();
+			uint64_t value{};
+			std::from_chars(stringNew.data(), stringNew.data() + stringNew.size(), value);
+			return value;
+		}
+		return static_cast<uint64_t>(this->getInt64());
+	}
 
-		if (stringNew == "online") {
-			dataNew += setBool(dataNew, PresenceUpdateFlags::Mobile_Online, true);
-		} else if (stringNew == "idle") {
-			dataNew += setBool(dataNew, PresenceUpdateFlags::Mobile_Idle, true);
-		} else if (stringNew == "dnd") {
-			dataNew += setBool(dataNew, PresenceUpdateFlags::Mobile_Dnd, true);
+	EtfType EtfValue::getType() const {
+		if (this->offSet >= this->dataBuffer.size()) {
+			return EtfType{};
 		}
+		return static_cast<EtfType>(this->dataBuffer[this->offSet]);
+	}
 
-		stringNew = getString(jsonData, "web");
+	int64_t EtfValue::getInt64() const {
+		uint64_t offSetNew{ this->offSet + 1 };
+		switch (this->getType()) {
+			case EtfType::Small_Integer_Ext: {
+				return this->readBits<uint8_t>(offSetNew);
+			}
+			case EtfType::Integer_Ext: {
+				return this->readBits<int32_t>(offSetNew);
+			}
+			case EtfType::Small_Big_Ext: {
+				uint8_t digits = this->readBits<uint8_t>(offSetNew);
+				uint8_t sign = this->readBits<uint8_t>(offSetNew);
+				if (digits > 8) {
+					throw DCAException{ "EtfValue::getInt64() Error: Big integer larger than 8 bytes not supported." };
+				}
+				uint64_t value{};
+				for (uint32_t x = 0; x < digits; ++x) {
+					value |= static_cast<uint64_t>(this->readBits<uint8_t>(offSetNew)) << (x * 8);
+				}
+				return sign == 0 ? static_cast<int64_t>(value) : -static_cast<int64_t>(value);
+			}
+			case EtfType::New_Float_Ext: {
+				return static_cast<int64_t>(this->getFloat());
+			}
+			case EtfType::Binary_Ext: {
+				auto stringNew = this->getStringView();
+				int64_t value{};
+				std::from_chars(stringNew.data(), stringNew.data() + stringNew.size(), value);
+				return value;
+			}
+			default: {
+				return 0;
+			}
+		}
+	}
 
-		if (stringNew == "online") {
-			dataNew += setBool(dataNew, PresenceUpdateFlags::Web_Online, true);
-		} else if (stringNew == "idle") {
-			dataNew += setBool(dataNew, PresenceUpdateFlags::Web_Idle, true);
-		} else if (stringNew == "dnd") {
-			dataNew += setBool(dataNew, PresenceUpdateFlags::Web_Dnd, true);
+	double EtfValue::getFloat() const {
+		if (this->getType() != EtfType::New_Float_Ext) {
+			return static_cast<double>(this->getInt64());
 		}
+		uint64_t offSetNew{ this->offSet + 1 };
+		return std::bit_cast<double>(this->readBits<uint64_t>(offSetNew));
+	}
+
+	Snowflake EtfValue::getId() const {
+		return Snowflake{ this->getUint64() };
+	}
+
+	bool EtfValue::getBool() const {
+		return this->getStringView() == "true";
+	}
 
-		data = static_cast<PresenceUpdateFlags>(dataNew);
+	bool EtfValue::isNull() const {
+		switch (this->getType()) {
+			case EtfType::Nil_Ext: {
+				return true;
+			}
+			case EtfType::Atom_Ext: {
+				[[fallthrough]];
+			}
+			case EtfType::Small_Atom_Ext: {
+				auto stringNew = this->getStringView();
+				return stringNew == "nil" || stringNew == "null";
+			}
+			default: {
+				return this->offSet >= this->dataBuffer.size();
+			}
+		}
 	}
 };
@@ -25,8 +25,14 @@
 
 #include <discordcoreapi/DiscordCoreClient.hpp>
 #include <csignal>
+#include <fstream>
 #include <atomic>
 
+#ifdef __linux__
+	#include <sys/stat.h>
+	#include <sys/file.h>
+#endif
+
 namespace DiscordCoreAPI {
 
 	namespace Globals {
@@ -59,10 +65,8 @@ namespace DiscordCoreAPI {
 		GuildData guild = Guilds::getCachedGuild({ .guildId = guildId });
 		if (!Globals::voiceConnectionMap.contains(guildId.operator size_t())) {
 			uint64_t theShardId{ (guildId.operator size_t() >> 22) % guild.discordCoreClient->configManager.getTotalShardCount() };
-			uint64_t baseSocketIndex{ theShardId % guild.discordCoreClient->baseSocketAgentsMap.size() };
-			auto baseSocketAgent = guild.discordCoreClient->baseSocketAgentsMap[baseSocketIndex].get();
 			Globals::voiceConnectionMap[guildId.operator size_t()] =
-				std::make_unique<VoiceConnection>(guild.discordCoreClient, baseSocketAgent->shardMap[theShardId].get(), &Globals::doWeQuit);
+				std::make_unique<VoiceConnection>(guild.discordCoreClient, guild.discordCoreClient->getShard(theShardId), &Globals::doWeQuit);
 		}
 		guild.voiceConnectionPtr = Globals::voiceConnectionMap[guildId.operator size_t()].get();
 		return guild.voiceConnectionPtr;
@@ -131,7 +135,8 @@ namespace DiscordCoreAPI {
 		std::signal(SIGABRT, &signalHandler);
 		std::signal(SIGFPE, &signalHandler);
 		this->configManager = ConfigManager{ configData };
-		if (!DiscordCoreInternal::SSLConnectionInterface::initialize()) {
+		DiscordCoreInternal::DnsResolver::initialize(this->configManager.getHostOverrides(), this->configManager.getDnsCacheTtl());
+		if (!DiscordCoreInternal::SSLConnectionInterface::initialize(this->configManager.doWeUseKernelTls())) {
 			if (this->configManager.doWePrintGeneralErrorMessages()) {
 				cout << shiftToBrightRed() << "Failed to initialize the SSL_CTX structure!" << reset() << endl << endl;
 			}
@@ -192,6 +197,115 @@ namespace DiscordCoreAPI {
 		return std::chrono::duration_cast<Milliseconds>(SysClock::now().time_since_epoch()) - this->startupTimeSinceEpoch;
 	}
 
+	TlsSessionCacheData DiscordCoreClient::getTlsSessionCacheData() {
+		return DiscordCoreInternal::SSLConnectionInterface::getSessionCacheData();
+	}
+
+	std::vector<GatewaySendQueueData> DiscordCoreClient::getGatewaySendQueueData() {
+		std::vector<GatewaySendQueueData> returnData{};
+		std::shared_lock lock{ this->shardsByIdMutex };
+		for (auto& [key, value]: this->shardsById) {
+			returnData.emplace_back(value->getSendQueueData());
+		}
+		return returnData;
+	}
+
+	std::vector<ShardLatencyData> DiscordCoreClient::getShardLatencyData() {
+		std::vector<ShardLatencyData> returnData{};
+		for (auto& [key, value]: this->baseSocketAgentsMap) {
+			if (!value) {
+				continue;
+			}
+			auto latencyData = value->getLatencyData();
+			returnData.insert(returnData.end(), latencyData.begin(), latencyData.end());
+		}
+		return returnData;
+	}
+
+	std::vector<ShardLoadData> DiscordCoreClient::getShardLoadData() {
+		std::vector<ShardLoadData> returnData{};
+		for (auto& [key, value]: this->baseSocketAgentsMap) {
+			if (!value) {
+				continue;
+			}
+			auto loadData = value->getLoadData();
+			returnData.insert(returnData.end(), loadData.begin(), loadData.end());
+		}
+		return returnData;
+	}
+
+	std::vector<EventShedData> DiscordCoreClient::getEventShedData() {
+		std::vector<EventShedData> returnData{};
+		std::shared_lock lock{ this->shardsByIdMutex };
+		for (auto& [key, value]: this->shardsById) {
+			auto eventShedData = value->getEventShedData();
+			returnData.insert(returnData.end(), eventShedData.begin(), eventShedData.end());
+		}
+		return returnData;
+	}
+
+	bool DiscordCoreClient::migrateShard(uint32_t shardId, uint32_t baseSocketAgent) {
+		auto newBaseSocketAgent = this->baseSocketAgentsMap.find(baseSocketAgent);
+		if (newBaseSocketAgent == this->baseSocketAgentsMap.end() || !newBaseSocketAgent->second) {
+			return false;
+		}
+		for (auto& [key, value]: this->baseSocketAgentsMap) {
+			if (!value) {
+				continue;
+			}
+			std::shared_lock lock{ value->shardMapMutex };
+			if (value->shardMap.contains(shardId)) {
+				auto currentState = value->shardMap[shardId]->currentState.load();
+				lock.unlock();
+				if (key == baseSocketAgent || currentState != DiscordCoreInternal::WebSocketState::Authenticated) {
+					return false;
+				}
+				value->migrateShard(shardId, newBaseSocketAgent->second.get());
+				return true;
+			}
+		}
+		return false;
+	}
+
+	uint64_t DiscordCoreClient::replayEventJournal(uint32_t shardId, Milliseconds receivedAfter) {
+		std::string directory{ this->configManager.getEventJournalOptions().directory };
+		if (directory == "") {
+			return 0;
+		}
+		// The live shard's own segments hold what the handlers have already been handed.
+		auto shard = this->getShard(shardId);
+		uint64_t endingSegment{ shard && shard->eventJournal ? shard->eventJournal->getStartingSegment() : std::numeric_limits<uint64_t>::max() };
+		DiscordCoreInternal::WebSocketClient replayShard{ this, static_cast<int32_t>(shardId), &Globals::doWeQuit };
+		replayShard.areWeProxied = true;
+		uint64_t replayCount{};
+		std::string payload{};
+		DiscordCoreInternal::EventJournal::readRecords(directory, shardId, endingSegment,
+			[&](TextFormat textFormat, const DiscordCoreInternal::EventJournalRecord& record, std::string_view payloadNew) {
+				if (textFormat != this->configManager.getTextFormat() || Milliseconds{ record.receivedTime } <= receivedAfter) {
+					return;
+				}
+				payload.clear();
+				payload.reserve(payloadNew.size() + DiscordCoreInternal::StringBuffer::paddingSize);
+				payload.append(payloadNew);
+				replayShard.onMessageReceived(payload);
+				++replayCount;
+			});
+		// Whatever was handed to the dispatch pool still refers to the stand-in.
+		while (replayShard.pendingDispatches.load() > 0) {
+			std::this_thread::sleep_for(1ms);
+		}
+		return replayCount;
+	}
+
+	std::vector<ShardStartupData> DiscordCoreClient::getShardStartupData() {
+		std::unique_lock lock{ this->shardStartupMutex };
+		std::vector<ShardStartupData> returnData{};
+		for (auto& [key, value]: this->shardStartupData) {
+			returnData.emplace_back(value);
+		}
+		return returnData;
+	}
+
 	BotUser DiscordCoreClient::getBotUser() {
 		return DiscordCoreClient::currentUser;
 	}
@@ -200,14 +314,36 @@ namespace DiscordCoreAPI {
 		if (!this->didWeStartCorrectly) {
 			return;
 		}
-		if (!this->instantiateWebSockets()) {
+		if (this->configManager.getClusterOptions().role == ClusterRole::Coordinator) {
+			DiscordCoreInternal::ClusterCoordinator clusterCoordinator{ &this->configManager,
+				this->getGateWayBot().sessionStartLimit.maxConcurrency };
+			clusterCoordinator.run(&Globals::doWeQuit);
+			return;
+		}
+		bool areWeAConsumer{ this->configManager.getGatewayProxyOptions().role == GatewayProxyRole::Consumer };
+		if (!(areWeAConsumer ? this->instantiateGatewayProxyConsumer() : this->instantiateWebSockets())) {
 			Globals::doWeQuit.store(true);
 			return;
 		}
+		DiscordCoreClient::currentUser = BotUser{ Users::getCurrentUserAsync().get(),
+			this->baseSocketAgentsMap.contains(0) ? this->baseSocketAgentsMap.find(0)->second.get() : nullptr };
+		for (auto& value: this->configManager.getFunctionsToExecute()) {
+			if (value.repeated) {
+				TimeElapsedHandlerNoArgs onSend = [=, this]() -> void {
+					value.function(this);
+				};
+				ThreadPool::storeThread(onSend, value.intervalInMs);
+			} else {
+				ThreadPool::executeFunctionAfterTimePeriod(value.function, value.intervalInMs, false, this);
+			}
+		}
+		this->startupTimeSinceEpoch = std::chrono::duration_cast<Milliseconds>(SysClock::now().time_since_epoch());
 		this->registerFunctionsInternal();
 		while (!Globals::doWeQuit.load()) {
 			std::this_thread::sleep_for(1ms);
 		}
+		this->rebalanceThread.reset(nullptr);
+		this->saveGatewaySessions();
 	}
 
 	void DiscordCoreClient::registerFunctionsInternal() {
@@ -278,54 +414,271 @@ namespace DiscordCoreAPI {
 			std::this_thread::sleep_for(5s);
 			return false;
 		}
-		if (this->configManager.getStartingShard() + this->configManager.getShardCountForThisProcess() > this->configManager.getTotalShardCount()) {
+		bool areWeAWorker{ this->configManager.getClusterOptions().role == ClusterRole::Worker };
+		if (areWeAWorker) {
+			this->clusterClient = std::make_unique<DiscordCoreInternal::ClusterClient>(this, &Globals::doWeQuit);
+			uint32_t totalShardCount{ this->clusterClient->connect() };
+			if (totalShardCount == 0) {
+				if (this->configManager.doWePrintGeneralErrorMessages()) {
+					cout << shiftToBrightRed() << "Failed to reach the cluster coordinator at " << this->configManager.getClusterOptions().socketPath
+						 << "!" << reset() << endl
+						 << endl;
+				}
+				return false;
+			}
+			this->configManager.setTotalShardCount(totalShardCount);
+		} else if (this->configManager.getStartingShard() + this->configManager.getShardCountForThisProcess() >
+			this->configManager.getTotalShardCount()) {
 			if (this->configManager.doWePrintGeneralErrorMessages()) {
 				cout << shiftToBrightRed() << "Your sharding options are incorrect! Please fix it!" << reset() << endl << endl;
 			}
 			std::this_thread::sleep_for(5s);
 			return false;
 		}
-		uint32_t theWorkerCount = this->configManager.getTotalShardCount() <= std::thread::hardware_concurrency()
-			? this->configManager.getTotalShardCount()
-			: std::thread::hardware_concurrency();
+		// A worker cannot know how many shards it will end up with, so it keeps an agent ready for as many as it could be handed.
+		uint32_t theShardCount{ areWeAWorker ? this->configManager.getTotalShardCount() : this->configManager.getShardCountForThisProcess() };
+		uint32_t theWorkerCount{ std::max(std::min(theShardCount, std::thread::hardware_concurrency()), 1u) };
 		if (this->configManager.getConnectionAddress() == "") {
 			this->configManager.setConnectionAddress(gatewayData.url.substr(gatewayData.url.find("wss://") + std::string("wss://").size()));
 		}
 		if (this->configManager.getConnectionPort() == 0) {
 			this->configManager.setConnectionPort(443);
 		}
-		this->connectionStopWatch.resetTimer();
-		for (uint32_t x = 0; x < this->configManager.getTotalShardCount(); ++x) {
-			if (!this->baseSocketAgentsMap.contains(x % theWorkerCount)) {
-				this->baseSocketAgentsMap[x % theWorkerCount] =
-					std::make_unique<DiscordCoreInternal::BaseSocketAgent>(this, &Globals::doWeQuit, x % theWorkerCount);
-			}
-			ConnectionPackage data{};
-			data.currentShard = x;
-			data.currentReconnectTries = 0;
-			this->baseSocketAgentsMap[x % theWorkerCount]->connect(data);
-			while (!this->connectionStopWatch.hasTimePassed()) {
-				std::this_thread::sleep_for(1ms);
+		if (this->configManager.getDispatchOffloadThreshold() > 0) {
+			this->dispatchPool = std::make_unique<DiscordCoreInternal::SerialTaskPool>(std::thread::hardware_concurrency());
+		}
+		this->maxConcurrency = std::max(gatewayData.sessionStartLimit.maxConcurrency, 1u);
+		this->identifyBuckets = std::make_unique<DiscordCoreInternal::IdentifyBucket[]>(this->maxConcurrency);
+		for (uint32_t x = 0; x < theWorkerCount; ++x) {
+			this->baseSocketAgentsMap[x] = std::make_unique<DiscordCoreInternal::BaseSocketAgent>(this, &Globals::doWeQuit, x);
+		}
+		if (this->configManager.getGatewayProxyOptions().role == GatewayProxyRole::Publisher) {
+			this->gatewayProxyPublisher = std::make_unique<DiscordCoreInternal::GatewayProxyPublisher>(&this->configManager);
+			if (!this->gatewayProxyPublisher->start()) {
+				return false;
 			}
-			this->connectionStopWatch.resetTimer();
 		}
-		DiscordCoreClient::currentUser =
-			BotUser{ Users::getCurrentUserAsync().get(), this->baseSocketAgentsMap[this->configManager.getStartingShard()].get() };
+		if (areWeAWorker) {
+			this->clusterClient->start();
+		} else {
+			this->addShards(this->configManager.getStartingShard(), this->configManager.getShardCountForThisProcess());
+		}
+		if (this->configManager.getShardRebalanceInterval() > 0ms && this->baseSocketAgentsMap.size() > 1) {
+			this->rebalanceThread = std::make_unique<std::jthread>([this](std::stop_token token) {
+				std::condition_variable_any condition{};
+				std::mutex accessMutex{};
+				std::unique_lock lock{ accessMutex };
+				while (!token.stop_requested()) {
+					condition.wait_for(lock, token, this->configManager.getShardRebalanceInterval(), [] {
+						return false;
+					});
+					if (!token.stop_requested()) {
+						this->rebalanceShards();
+					}
+				}
+			});
+		}
+		return true;
+	}
 
-		for (auto& value: this->configManager.getFunctionsToExecute()) {
-			if (value.repeated) {
-				TimeElapsedHandlerNoArgs onSend = [=, this]() -> void {
-					value.function(this);
-				};
-				ThreadPool::storeThread(onSend, value.intervalInMs);
-			} else {
-				ThreadPool::executeFunctionAfterTimePeriod(value.function, value.intervalInMs, false, this);
+	bool DiscordCoreClient::instantiateGatewayProxyConsumer() {
+		this->gatewayProxyConsumer = std::make_unique<DiscordCoreInternal::GatewayProxyConsumer>(this, &Globals::doWeQuit);
+		if (!this->gatewayProxyConsumer->connect()) {
+			if (this->configManager.doWePrintGeneralErrorMessages()) {
+				cout << shiftToBrightRed() << "Failed to reach the gateway proxy at " << this->configManager.getGatewayProxyOptions().socketPath << "!"
+					 << reset() << endl
+					 << endl;
 			}
+			return false;
 		}
-		this->startupTimeSinceEpoch = std::chrono::duration_cast<Milliseconds>(SysClock::now().time_since_epoch());
+		if (this->configManager.getDispatchOffloadThreshold() > 0) {
+			this->dispatchPool = std::make_unique<DiscordCoreInternal::SerialTaskPool>(std::thread::hardware_concurrency());
+		}
+		this->gatewayProxyConsumer->start();
 		return true;
 	}
 
+	void DiscordCoreClient::addShards(uint32_t startingShard, uint32_t shardCount) {
+		uint32_t theWorkerCount{ static_cast<uint32_t>(this->baseSocketAgentsMap.size()) };
+		for (uint32_t x = startingShard; x < startingShard + shardCount; ++x) {
+			auto& baseSocketAgent = this->baseSocketAgentsMap.find(x % theWorkerCount)->second;
+			std::unique_lock lock{ baseSocketAgent->accessMutex };
+			std::unique_lock shardMapLock{ baseSocketAgent->shardMapMutex };
+			baseSocketAgent->shardMap[x] = std::make_unique<DiscordCoreInternal::WebSocketClient>(this, x, &Globals::doWeQuit);
+			if (this->configManager.getEventJournalOptions().directory != "") {
+				baseSocketAgent->shardMap[x]->eventJournal = std::make_unique<DiscordCoreInternal::EventJournal>(&this->configManager, x);
+			}
+			std::unique_lock shardsByIdLock{ this->shardsByIdMutex };
+			this->shardsById[x] = baseSocketAgent->shardMap[x].get();
+		}
+		this->loadGatewaySessions();
+		// The agents connect the shards from their own threads, where the identify buckets keep each bucket's identifies a window apart,
+		// and so the shards of different buckets come up all at once.
+		for (uint32_t x = startingShard; x < startingShard + shardCount; ++x) {
+			auto& baseSocketAgent = this->baseSocketAgentsMap.find(x % theWorkerCount)->second;
+			std::unique_lock lock{ baseSocketAgent->accessMutex };
+			auto& shard = baseSocketAgent->shardMap[x];
+			shard->connections = std::make_unique<ConnectionPackage>();
+			shard->connections->currentShard = x;
+			shard->connections->currentReconnectTries = 0;
+			shard->connections->areWeResuming = shard->areWeResuming;
+			lock.unlock();
+			baseSocketAgent->wakeUp();
+		}
+	}
+
+	DiscordCoreInternal::WebSocketClient* DiscordCoreClient::getShard(uint32_t shardId) {
+		std::shared_lock lock{ this->shardsByIdMutex };
+		if (this->shardsById.contains(shardId)) {
+			return this->shardsById[shardId];
+		} else {
+			return nullptr;
+		}
+	}
+
+	void DiscordCoreClient::rebalanceShards() {
+		// Each message also costs its thread a wakeup and a TLS record, which processingTime does not cover.
+		static constexpr uint64_t messageOverheadInNs{ 2000 };
+		std::unordered_map<uint32_t, std::vector<std::pair<uint32_t, uint64_t>>> agentShards{};
+		std::unordered_map<uint32_t, uint64_t> agentLoads{};
+		for (auto& [key, value]: this->baseSocketAgentsMap) {
+			if (!value) {
+				continue;
+			}
+			agentLoads[key] = 0;
+			for (auto& valueNew: value->getLoadData()) {
+				uint64_t load{ static_cast<uint64_t>(valueNew.processingTime.count()) + valueNew.messageCount * messageOverheadInNs };
+				uint64_t loadSinceLastTime{ load - std::min(this->lastShardLoads[valueNew.shardId], load) };
+				this->lastShardLoads[valueNew.shardId] = load;
+				agentLoads[key] += loadSinceLastTime;
+				agentShards[key].emplace_back(valueNew.shardId, loadSinceLastTime);
+			}
+		}
+		if (agentLoads.size() < 2) {
+			return;
+		}
+		uint32_t busiestAgent{ agentLoads.begin()->first };
+		uint32_t idlestAgent{ agentLoads.begin()->first };
+		for (auto& [key, value]: agentLoads) {
+			if (value > agentLoads[busiestAgent]) {
+				busiestAgent = key;
+			}
+			if (value < agentLoads[idlestAgent]) {
+				idlestAgent = key;
+			}
+		}
+		uint64_t loadGap{ agentLoads[busiestAgent] - agentLoads[idlestAgent] };
+		// Agents within a quarter of each other are left alone, so that the shards do not chase noise from one agent to the next.
+		if (agentShards[busiestAgent].size() < 2 || loadGap * 4 < agentLoads[busiestAgent]) {
+			return;
+		}
+		// Anything short of the gap leaves both agents below the busiest one's current load, and the biggest such shard evens them out the most.
+		uint32_t shardToMove{};
+		uint64_t shardLoad{};
+		for (auto& [key, value]: agentShards[busiestAgent]) {
+			if (value < loadGap && value > shardLoad) {
+				shardToMove = key;
+				shardLoad = value;
+			}
+		}
+		if (shardLoad == 0) {
+			return;
+		}
+		if (this->configManager.doWePrintGeneralSuccessMessages()) {
+			cout << shiftToBrightBlue() << "Moving Shard " << shardToMove + 1 << " from thread " << busiestAgent << " to thread " << idlestAgent
+				 << "." << reset() << endl
+				 << endl;
+		}
+		this->baseSocketAgentsMap.find(busiestAgent)->second->migrateShard(shardToMove, this->baseSocketAgentsMap.find(idlestAgent)->second.get());
+	}
+
+	void DiscordCoreClient::loadGatewaySessions() {
+		if (this->configManager.getSessionStorePath() == "") {
+			return;
+		}
+		std::unique_lock lock{ this->storedSessionsMutex };
+		if (!this->haveWeLoadedSessions) {
+			this->haveWeLoadedSessions = true;
+			std::ifstream file{ this->configManager.getSessionStorePath() };
+			uint32_t shardId{};
+			uint32_t totalShards{};
+			StoredSession session{};
+			while (file >> shardId >> totalShards >> session.lastNumberReceived >> session.sessionId >> session.resumeUrl) {
+				if (totalShards == this->configManager.getTotalShardCount()) {
+					this->storedSessions[shardId] = session;
+				}
+			}
+		}
+		// The sessions of shards that this process has not been handed yet stay behind, for whichever later addShards() call hands them over.
+		for (auto iterator = this->storedSessions.begin(); iterator != this->storedSessions.end();) {
+			auto shard = this->getShard(iterator->first);
+			if (!shard) {
+				++iterator;
+				continue;
+			}
+			shard->sessionId = iterator->second.sessionId;
+			shard->resumeUrl = iterator->second.resumeUrl;
+			shard->lastNumberReceived = iterator->second.lastNumberReceived;
+			shard->areWeResuming = true;
+			iterator = this->storedSessions.erase(iterator);
+		}
+	}
+
+	void DiscordCoreClient::saveGatewaySessions() {
+		if (this->configManager.getSessionStorePath() == "") {
+			return;
+		}
+#ifdef __linux__
+		// The store holds resumable session ids, so only the bot's own user may read it, even where an older file was left readable. The lock
+		// keeps the other processes that share it from writing it in between our reading and writing it.
+		int32_t fileDescriptor = open(this->configManager.getSessionStorePath().c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+		if (fileDescriptor != -1) {
+			fchmod(fileDescriptor, 0600);
+			flock(fileDescriptor, LOCK_EX);
+		}
+#endif
+		// Other workers of a cluster may share the store, so their entries are kept, and only those of this process's own shards are replaced.
+		std::string otherSessions{};
+		std::ifstream fileIn{ this->configManager.getSessionStorePath() };
+		std::string line{};
+		while (std::getline(fileIn, line)) {
+			std::istringstream stream{ line };
+			uint32_t shardId{};
+			uint32_t totalShards{};
+			if (stream >> shardId >> totalShards && totalShards == this->configManager.getTotalShardCount() && !this->getShard(shardId)) {
+				otherSessions += line + "\n";
+			}
+		}
+		fileIn.close();
+		std::ofstream file{ this->configManager.getSessionStorePath(), std::ios::out | std::ios::trunc };
+		if (file.is_open()) {
+			file << otherSessions;
+			for (auto& [key, value]: this->baseSocketAgentsMap) {
+				if (!value) {
+					continue;
+				}
+				std::unique_lock lock{ value->accessMutex };
+				for (auto& [keyNew, shard]: value->shardMap) {
+					if (shard->currentState.load() == DiscordCoreInternal::WebSocketState::Authenticated && shard->sessionId != "") {
+						file << shard->shard[0] << " " << shard->shard[1] << " " << shard->lastNumberReceived << " " << shard->sessionId << " "
+							 << shard->resumeUrl << "\n";
+						shard->areWeResuming = true;
+					}
+				}
+			}
+			file.close();
+		} else if (this->configManager.doWePrintGeneralErrorMessages()) {
+			cout << shiftToBrightRed() << "Failed to open the session store: " << this->configManager.getSessionStorePath() << reset() << endl
+				 << endl;
+		}
+#ifdef __linux__
+		if (fileDescriptor != -1) {
+			flock(fileDescriptor, LOCK_UN);
+			close(fileDescriptor);
+		}
+#endif
+	}
+
 	DiscordCoreClient::~DiscordCoreClient() noexcept {
 		for (auto& value: Guilds::getCache()) {
 			Guild guild = value;
@@ -333,6 +686,21 @@ namespace DiscordCoreAPI {
 				guild.disconnect();
 			}
 		}
+		this->rebalanceThread.reset(nullptr);
+		// The cluster client starts shards from its own threads, which have to be done with that before the agents are stopped.
+		this->clusterClient.reset(nullptr);
+		// The shards hand their dispatches to the pool, so they have to stop before it does, and it before they are destroyed.
+		for (auto& [key, value]: this->baseSocketAgentsMap) {
+			if (!value) {
+				continue;
+			}
+			value->stop();
+		}
+		if (this->gatewayProxyConsumer) {
+			this->gatewayProxyConsumer->stop();
+		}
+		this->gatewayProxyPublisher.reset(nullptr);
+		this->dispatchPool.reset(nullptr);
 		for (auto& [key, value]: CoRoutineBase::threadPool.workerThreads) {
 			if (value.thread.joinable()) {
 				value.thread.request_stop();
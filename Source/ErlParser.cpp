@@ -56,9 +56,6 @@ namespace DiscordCoreInternal {
 		if (this->offSet + static_cast<uint64_t>(length) > this->dataBuffer.size()) {
 			throw ErlParseError{ "ErlParser::readString() Error: readString() past end of buffer.\n\n" };
 		}
-		if (this->finalString.size() < this->currentSize + length) {
-			this->finalString.resize(this->finalString.size() + static_cast<uint64_t>(length * 4ull));
-		}
 		const char* stringNew = this->dataBuffer.data() + this->offSet;
 		this->offSet += length;
 		if (length >= 3 && length <= 5) {
@@ -76,69 +73,108 @@ namespace DiscordCoreInternal {
 				return;
 			}
 		}
-		this->writeCharacter('"');
-		for (size_t x = 0; x < length; ++x) {
-			switch (stringNew[x]) {
-				case 0x00: {
-					break;
-				}
-				case 0x27: {
-					this->writeCharacter('\\');
-					this->writeCharacter('\'');
-					break;
-				}
-				case 0x22: {
-					this->writeCharacter('\\');
-					this->writeCharacter('"');
-					break;
-				}
-				case 0x5c: {
-					this->writeCharacter('\\');
-					this->writeCharacter('\\');
-					break;
-				}
-				case 0x07: {
-					this->writeCharacter('\\');
-					this->writeCharacter('a');
-					break;
-				}
-				case 0x08: {
-					this->writeCharacter('\\');
-					this->writeCharacter('b');
-					break;
-				}
-				case 0x0C: {
-					this->writeCharacter('\\');
-					this->writeCharacter('f');
-					break;
-				}
-				case 0x0A: {
-					this->writeCharacter('\\');
-					this->writeCharacter('n');
-					break;
-				}
-				case 0x0D: {
-					this->writeCharacter('\\');
-					this->writeCharacter('r');
-					break;
-				}
-				case 0x0B: {
-					this->writeCharacter('\\');
-					this->writeCharacter('v');
-					break;
-				}
-				case 0x09: {
-					this->writeCharacter('\\');
-					this->writeCharacter('t');
-					break;
-				}
-				default: {
-					this->writeCharacter(stringNew[x]);
-					break;
-				}
+		uint64_t maxLength{ this->currentSize + length * 2ull + 2ull };
+		if (this->finalString.size() < maxLength) {
+			this->finalString.resize(maxLength * 2ull);
+		}
+		char* outPtr = this->finalString.data() + this->currentSize;
+		*outPtr++ = '"';
+		outPtr = escapeCharacters(stringNew, length, outPtr);
+		*outPtr++ = '"';
+		this->currentSize = static_cast<size_t>(outPtr - this->finalString.data());
+	}
+
+	char* ErlParser::escapeCharacters(const char* data, size_t length, char* outPtr) noexcept {
+		size_t index{};
+#if defined(__AVX2__)
+		const __m256i quote{ _mm256_set1_epi8('"') };
+		const __m256i apostrophe{ _mm256_set1_epi8('\'') };
+		const __m256i backslash{ _mm256_set1_epi8('\\') };
+		const __m256i lastControl{ _mm256_set1_epi8(0x0D) };
+		while (index + 32 <= length) {
+			const __m256i chunk{ _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + index)) };
+			const __m256i needsEscaping{ _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote), _mm256_cmpeq_epi8(chunk, apostrophe)),
+				_mm256_or_si256(_mm256_cmpeq_epi8(chunk, backslash), _mm256_cmpeq_epi8(_mm256_min_epu8(chunk, lastControl), chunk))) };
+			const uint32_t mask{ static_cast<uint32_t>(_mm256_movemask_epi8(needsEscaping)) };
+			if (mask == 0) {
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(outPtr), chunk);
+				outPtr += 32;
+				index += 32;
+				continue;
+			}
+			const uint32_t cleanLength{ static_cast<uint32_t>(std::countr_zero(mask)) };
+			std::memcpy(outPtr, data + index, cleanLength);
+			outPtr += cleanLength;
+			index += cleanLength;
+			outPtr = escapeCharacter(data[index++], outPtr);
+		}
+#endif
+		while (index < length) {
+			outPtr = escapeCharacter(data[index++], outPtr);
+		}
+		return outPtr;
+	}
+
+	char* ErlParser::escapeCharacter(const char value, char* outPtr) noexcept {
+		switch (value) {
+			case 0x00: {
+				return outPtr;
+			}
+			case 0x27: {
+				*outPtr++ = '\\';
+				*outPtr++ = '\'';
+				return outPtr;
+			}
+			case 0x22: {
+				*outPtr++ = '\\';
+				*outPtr++ = '"';
+				return outPtr;
+			}
+			case 0x5c: {
+				*outPtr++ = '\\';
+				*outPtr++ = '\\';
+				return outPtr;
+			}
+			case 0x07: {
+				*outPtr++ = '\\';
+				*outPtr++ = 'a';
+				return outPtr;
+			}
+			case 0x08: {
+				*outPtr++ = '\\';
+				*outPtr++ = 'b';
+				return outPtr;
+			}
+			case 0x0C: {
+				*outPtr++ = '\\';
+				*outPtr++ = 'f';
+				return outPtr;
+			}
+			case 0x0A: {
+				*outPtr++ = '\\';
+				*outPtr++ = 'n';
+				return outPtr;
+			}
+			case 0x0D: {
+				*outPtr++ = '\\';
+				*outPtr++ = 'r';
+				return outPtr;
+			}
+			case 0x0B: {
+				*outPtr++ = '\\';
+				*outPtr++ = 'v';
+				return outPtr;
+			}
+			case 0x09: {
+				*outPtr++ = '\\';
+				*outPtr++ = 't';
+				return outPtr;
+			}
+			default: {
+				*outPtr++ = value;
+				return outPtr;
 			}
 		}
-		this->writeCharacter('"');
 	}
 
 	void ErlParser::writeCharacter(const char value) {
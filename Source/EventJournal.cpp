@@ -0,0 +1,237 @@
+/*
+	DiscordCoreAPI, A bot library for Discord, written in C++, and featuring explicit multithreading through the usage of custom, asynchronous C++ CoRoutines.
+
+	Copyright 2021, 2022 Chris M. (RealTimeChris)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 2.1 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+	USA
+*/
+/// EventJournal.cpp - Source file for the memory-mapped journal of each shard's dispatches.
+/// Oct 17, 2022
+/// https://discordcoreapi.com
+/// \file EventJournal.cpp
+
+#include <discordcoreapi/EventJournal.hpp>
+
+namespace DiscordCoreInternal {
+
+	static constexpr uint64_t getAlignedSize(uint64_t size) noexcept {
+		return (size + 7) & ~7ull;
+	}
+
+	EventJournal::EventJournal(DiscordCoreAPI::ConfigManager* configManagerNew, uint32_t shardIdNew) noexcept {
+		DiscordCoreAPI::EventJournalOptions eventJournalOptions{ configManagerNew->getEventJournalOptions() };
+		this->segmentSize = std::max(eventJournalOptions.segmentSize, uint64_t{ 64 * 1024 });
+		this->maxSegments = std::max(eventJournalOptions.maxSegments, 1u);
+		this->directory = eventJournalOptions.directory;
+		this->configManager = configManagerNew;
+		this->shardId = shardIdNew;
+		std::error_code errorCode{};
+		std::filesystem::create_directories(this->directory, errorCode);
+		// The segments of the process before this one are left alone, for as long as maxSegments allows, so that they can be caught up on.
+		auto segments = EventJournal::getSegments(this->directory, this->shardId);
+		this->startingSegment = segments.size() > 0 ? segments.back() + 1 : 0;
+		this->currentSegment = this->openSegment(this->startingSegment, this->segmentSize);
+		this->segmentOffset = getAlignedSize(sizeof(EventJournalSegmentHeader));
+		if (this->currentSegment.data) {
+			this->prepareNextSegment();
+		}
+	}
+
+	void EventJournal::append(uint32_t sequence, std::string_view payload) noexcept {
+		uint64_t recordSize{ getAlignedSize(sizeof(EventJournalRecord) + payload.size()) };
+		if (this->currentSegment.data && this->segmentOffset + recordSize > this->currentSegment.size) {
+			this->rotateSegment(recordSize);
+		}
+		if (!this->currentSegment.data) {
+			return;
+		}
+		// Nothing here is synced: the page cache outlives the process, and an msync per dispatch would cost the shard far more than a copy.
+		EventJournalRecord* record = reinterpret_cast<EventJournalRecord*>(this->currentSegment.data + this->segmentOffset);
+		record->sequence = sequence;
+		record->receivedTime = std::chrono::duration_cast<Milliseconds>(SysClock::now().time_since_epoch()).count();
+		std::memcpy(this->currentSegment.data + this->segmentOffset + sizeof(EventJournalRecord), payload.data(), payload.size());
+		std::atomic_ref{ record->size }.store(static_cast<uint32_t>(payload.size()), std::memory_order_release);
+		this->segmentOffset += recordSize;
+	}
+
+	uint64_t EventJournal::getStartingSegment() noexcept {
+		return this->startingSegment;
+	}
+
+	uint64_t EventJournal::readRecords(const std::string& directory, uint32_t shardId, uint64_t endingSegment, RecordCallback callback) noexcept {
+		uint64_t recordCount{};
+#ifdef __linux__
+		for (auto& value: EventJournal::getSegments(directory, shardId)) {
+			if (value >= endingSegment) {
+				break;
+			}
+			std::string segmentPath{ EventJournal::getSegmentPath(directory, shardId, value) };
+			std::error_code errorCode{};
+			uint64_t fileSize{ std::filesystem::file_size(segmentPath, errorCode) };
+			int32_t fileDescriptor{ ::open(segmentPath.c_str(), O_RDONLY) };
+			if (errorCode || fileSize < sizeof(EventJournalSegmentHeader) || fileDescriptor == -1) {
+				if (fileDescriptor != -1) {
+					::close(fileDescriptor);
+				}
+				continue;
+			}
+			void* mappedData = ::mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+			::close(fileDescriptor);
+			if (mappedData == MAP_FAILED) {
+				continue;
+			}
+			char* segmentData = static_cast<char*>(mappedData);
+			EventJournalSegmentHeader header{};
+			std::memcpy(&header, segmentData, sizeof(header));
+			if (header.magic == EventJournalSegmentHeader::currentMagic && header.version == EventJournalSegmentHeader::currentVersion &&
+				header.shardId == shardId) {
+				uint64_t offset{ getAlignedSize(sizeof(EventJournalSegmentHeader)) };
+				while (offset + sizeof(EventJournalRecord) <= fileSize) {
+					EventJournalRecord* record = reinterpret_cast<EventJournalRecord*>(segmentData + offset);
+					uint32_t payloadSize{ std::atomic_ref{ record->size }.load(std::memory_order_acquire) };
+					if (payloadSize == 0 || offset + sizeof(EventJournalRecord) + payloadSize > fileSize) {
+						break;
+					}
+					callback(header.textFormat, *record, std::string_view{ segmentData + offset + sizeof(EventJournalRecord), payloadSize });
+					offset += getAlignedSize(sizeof(EventJournalRecord) + payloadSize);
+					++recordCount;
+				}
+			}
+			::munmap(mappedData, fileSize);
+		}
+#endif
+		return recordCount;
+	}
+
+	void EventJournal::rotateSegment(uint64_t recordSize) noexcept {
+		uint64_t sizeNeeded{ getAlignedSize(sizeof(EventJournalSegmentHeader)) + recordSize };
+		Segment segment{ this->nextSegment.valid() ? this->nextSegment.get() : Segment{} };
+		// A record too big for any segment gets one of its own, sized to fit it, rather than being lost. That is rare enough to be done here,
+		// as is opening the segment when no thread could be had to open it on ahead of time.
+		if (!segment.data || segment.size < sizeNeeded) {
+			EventJournal::closeSegment(segment);
+			segment = this->openSegment(this->currentSegment.index + 1, std::max(this->segmentSize, sizeNeeded));
+		}
+		EventJournal::closeSegment(this->currentSegment);
+		this->currentSegment = segment;
+		this->segmentOffset = getAlignedSize(sizeof(EventJournalSegmentHeader));
+		if (this->currentSegment.data) {
+			this->prepareNextSegment();
+		}
+	}
+
+	void EventJournal::prepareNextSegment() noexcept {
+		uint64_t segmentIndex{ this->currentSegment.index + 1 };
+		try {
+			this->nextSegment = std::async(std::launch::async, [=, this] {
+				return this->openSegment(segmentIndex, this->segmentSize);
+			});
+		} catch (...) {
+			this->nextSegment = {};
+		}
+	}
+
+	EventJournal::Segment EventJournal::openSegment(uint64_t segmentIndex, uint64_t size) noexcept {
+#ifdef __linux__
+		std::string segmentPath{ EventJournal::getSegmentPath(this->directory, this->shardId, segmentIndex) };
+		int32_t fileDescriptor{ ::open(segmentPath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644) };
+		void* mappedData{ MAP_FAILED };
+		if (fileDescriptor != -1 && ::ftruncate(fileDescriptor, static_cast<off_t>(size)) != -1) {
+			// The pages are faulted in now, rather than one at a time as the shard writes its way across them.
+			mappedData = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fileDescriptor, 0);
+		}
+		if (fileDescriptor != -1) {
+			::close(fileDescriptor);
+		}
+		if (mappedData == MAP_FAILED) {
+			if (this->configManager->doWePrintGeneralErrorMessages()) {
+				cout << DiscordCoreAPI::shiftToBrightRed() << "Failed to map the event journal segment " << segmentPath << ", so Shard "
+					 << this->shardId + 1 << " is no longer being journaled." << DiscordCoreAPI::reset() << endl
+					 << endl;
+			}
+			return Segment{};
+		}
+		Segment segment{ .data = static_cast<char*>(mappedData), .index = segmentIndex, .size = size };
+		EventJournalSegmentHeader header{};
+		header.shardId = this->shardId;
+		header.textFormat = this->configManager->getTextFormat();
+		std::memcpy(segment.data, &header, sizeof(header));
+		// The segment is opened while the one before it is still being written to, which is kept, along with the maxSegments - 1 before it.
+		for (auto& value: EventJournal::getSegments(this->directory, this->shardId)) {
+			if (value + this->maxSegments < segmentIndex) {
+				std::error_code errorCode{};
+				std::filesystem::remove(EventJournal::getSegmentPath(this->directory, this->shardId, value), errorCode);
+			}
+		}
+		return segment;
+#else
+		if (this->configManager->doWePrintGeneralErrorMessages()) {
+			cout << DiscordCoreAPI::shiftToBrightRed() << "The event journal needs mmap, which this platform does not have."
+				 << DiscordCoreAPI::reset() << endl
+				 << endl;
+		}
+		return Segment{};
+#endif
+	}
+
+	void EventJournal::closeSegment(Segment& segment) noexcept {
+#ifdef __linux__
+		if (segment.data) {
+			::munmap(segment.data, segment.size);
+			segment.data = nullptr;
+		}
+#endif
+	}
+
+	std::vector<uint64_t> EventJournal::getSegments(const std::string& directory, uint32_t shardId) noexcept {
+		std::vector<uint64_t> returnData{};
+		std::string prefix{ "shard-" + std::to_string(shardId) + "-" };
+		std::string suffix{ ".journal" };
+		std::error_code errorCode{};
+		auto iterator = std::filesystem::directory_iterator{ directory, errorCode };
+		for (; !errorCode && iterator != std::filesystem::directory_iterator{}; iterator.increment(errorCode)) {
+			std::string fileName{ iterator->path().filename().string() };
+			if (fileName.size() <= prefix.size() + suffix.size() || !fileName.starts_with(prefix) || !fileName.ends_with(suffix)) {
+				continue;
+			}
+			std::string segmentIndex{ fileName.substr(prefix.size(), fileName.size() - prefix.size() - suffix.size()) };
+			if (segmentIndex.size() < 20 && std::all_of(segmentIndex.begin(), segmentIndex.end(), ::isdigit)) {
+				returnData.emplace_back(std::stoull(segmentIndex));
+			}
+		}
+		std::sort(returnData.begin(), returnData.end());
+		return returnData;
+	}
+
+	std::string EventJournal::getSegmentPath(const std::string& directory, uint32_t shardId, uint64_t segmentIndex) noexcept {
+		std::string fileName{ "shard-" + std::to_string(shardId) + "-" + std::to_string(segmentIndex) + ".journal" };
+		return (std::filesystem::path{ directory } / fileName).string();
+	}
+
+	EventJournal::~EventJournal() noexcept {
+		EventJournal::closeSegment(this->currentSegment);
+		if (this->nextSegment.valid()) {
+			// Never written to, it would only crowd a segment that is worth catching up on out of the next process's maxSegments.
+			Segment segment{ this->nextSegment.get() };
+			if (segment.data) {
+				EventJournal::closeSegment(segment);
+				std::error_code errorCode{};
+				std::filesystem::remove(EventJournal::getSegmentPath(this->directory, this->shardId, segment.index), errorCode);
+			}
+		}
+	}
+
+}
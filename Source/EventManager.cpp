@@ -58,17 +58,22 @@ namespace DiscordCoreAPI {
 		this->data = message.processJsonMessage<AutoModerationActionExecutionEventData>(data, "d");
 	}
 
-	OnChannelCreationData::OnChannelCreationData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal) {
-		this->channel = std::make_unique<ChannelData>(data.processJsonMessage<ChannelData>(dataReal, "d"));
+	OnChannelCreationData::OnChannelCreationData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal)
+		: OnChannelCreationData(data.processJsonMessage<ChannelData>(dataReal, "d")){};
+
+	OnChannelCreationData::OnChannelCreationData(ChannelData&& channelNew) {
+		this->channel = std::make_unique<ChannelData>(std::move(channelNew));
+		OnChannelCreationData::updateCache(*this->channel);
+	}
+
+	void OnChannelCreationData::updateCache(ChannelData& channelNew) {
 		if (Channels::doWeCacheChannels()) {
 			GuildData guild{};
-			guild.id = this->channel->guildId;
+			guild.id = channelNew.guildId;
 			if (Guilds::getCache().contains(guild)) {
-				Guilds::getCache()[guild].channels.emplace_back(this->channel->id);
-			}
-			if (Channels::doWeCacheChannels()) {
-				Channels::insertChannel(*this->channel);
+				Guilds::getCache()[guild].channels.emplace_back(channelNew.id);
 			}
+			Channels::insertChannel(channelNew);
 		}
 	}
 
@@ -81,10 +86,17 @@ namespace DiscordCoreAPI {
 		*this = other;
 	}
 
-	OnChannelUpdateData::OnChannelUpdateData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal) {
-		this->channel = std::make_unique<ChannelData>(data.processJsonMessage<ChannelData>(dataReal, "d"));
+	OnChannelUpdateData::OnChannelUpdateData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal)
+		: OnChannelUpdateData(data.processJsonMessage<ChannelData>(dataReal, "d")){};
+
+	OnChannelUpdateData::OnChannelUpdateData(ChannelData&& channelNew) {
+		this->channel = std::make_unique<ChannelData>(std::move(channelNew));
+		OnChannelUpdateData::updateCache(*this->channel);
+	}
+
+	void OnChannelUpdateData::updateCache(ChannelData& channelNew) {
 		if (Channels::doWeCacheChannels()) {
-			Channels::insertChannel(*this->channel);
+			Channels::insertChannel(channelNew);
 		}
 	}
 
@@ -97,21 +109,26 @@ namespace DiscordCoreAPI {
 		*this = other;
 	}
 
-	OnChannelDeletionData::OnChannelDeletionData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal) {
-		this->channel = std::make_unique<ChannelData>(data.processJsonMessage<ChannelData>(dataReal, "d"));
+	OnChannelDeletionData::OnChannelDeletionData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal)
+		: OnChannelDeletionData(data.processJsonMessage<ChannelData>(dataReal, "d")){};
+
+	OnChannelDeletionData::OnChannelDeletionData(ChannelData&& channelNew) {
+		this->channel = std::make_unique<ChannelData>(std::move(channelNew));
+		OnChannelDeletionData::updateCache(*this->channel);
+	}
+
+	void OnChannelDeletionData::updateCache(ChannelData& channelNew) {
 		if (Channels::doWeCacheChannels()) {
 			GuildData guild{};
-			guild.id = this->channel->guildId;
+			guild.id = channelNew.guildId;
 			if (Guilds::getCache().contains(guild)) {
 				for (uint64_t x = 0; x < Guilds::getCache()[guild].channels.size(); ++x) {
-					if (Guilds::getCache()[guild].channels[x] == this->channel->id) {
+					if (Guilds::getCache()[guild].channels[x] == channelNew.id) {
 						Guilds::getCache()[guild].channels.erase(Guilds::getCache()[guild].channels.begin() + x);
 					}
 				}
 			}
-			if (Channels::doWeCacheChannels()) {
-				Channels::removeChannel(this->channel->id);
-			}
+			Channels::removeChannel(channelNew.id);
 		}
 	}
 
@@ -167,13 +184,18 @@ namespace DiscordCoreAPI {
 	}
 
 	OnGuildCreationData::OnGuildCreationData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal,
-		DiscordCoreClient* client) {
-		this->guild = std::make_unique<GuildData>(data.processJsonMessage<GuildData>(dataReal, "d"));
-		this->guild->discordCoreClient = client;
+		DiscordCoreClient* client)
+		: OnGuildCreationData(data.processJsonMessage<GuildData>(dataReal, "d"), client){};
+
+	OnGuildCreationData::OnGuildCreationData(GuildData&& guildNew, DiscordCoreClient* client) {
+		this->guild = std::make_unique<GuildData>(std::move(guildNew));
+		OnGuildCreationData::updateCache(*this->guild, client);
+	}
+
+	void OnGuildCreationData::updateCache(GuildData& guildNew, DiscordCoreClient* client) {
+		guildNew.discordCoreClient = client;
 		if (Guilds::doWeCacheGuilds()) {
-			if (Guilds::doWeCacheGuilds()) {
-				Guilds::insertGuild(*this->guild);
-			}
+			Guilds::insertGuild(guildNew);
 		}
 	}
 
@@ -187,11 +209,18 @@ namespace DiscordCoreAPI {
 	}
 
 	OnGuildUpdateData::OnGuildUpdateData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal,
-		DiscordCoreClient* clientNew) {
-		this->guild = std::make_unique<GuildData>(data.processJsonMessage<GuildData>(dataReal, "d"));
-		this->guild->discordCoreClient = clientNew;
+		DiscordCoreClient* clientNew)
+		: OnGuildUpdateData(data.processJsonMessage<GuildData>(dataReal, "d"), clientNew){};
+
+	OnGuildUpdateData::OnGuildUpdateData(GuildData&& guildNew, DiscordCoreClient* clientNew) {
+		this->guild = std::make_unique<GuildData>(std::move(guildNew));
+		OnGuildUpdateData::updateCache(*this->guild, clientNew);
+	}
+
+	void OnGuildUpdateData::updateCache(GuildData& guildNew, DiscordCoreClient* clientNew) {
+		guildNew.discordCoreClient = clientNew;
 		if (Guilds::doWeCacheGuilds()) {
-			Guilds::insertGuild(*this->guild);
+			Guilds::insertGuild(guildNew);
 		}
 	}
 
@@ -205,19 +234,26 @@ namespace DiscordCoreAPI {
 	}
 
 	OnGuildDeletionData::OnGuildDeletionData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal,
-		DiscordCoreClient* clientNew) {
-		this->guild = std::make_unique<GuildData>(data.processJsonMessage<GuildData>(dataReal, "d"));
+		DiscordCoreClient* clientNew)
+		: OnGuildDeletionData(data.processJsonMessage<GuildData>(dataReal, "d")){};
+
+	OnGuildDeletionData::OnGuildDeletionData(GuildData&& guildNew) {
+		this->guild = std::make_unique<GuildData>(std::move(guildNew));
+		OnGuildDeletionData::updateCache(*this->guild);
+	}
+
+	void OnGuildDeletionData::updateCache(GuildData& guildNew) {
 		if (Guilds::doWeCacheGuilds()) {
-			Guilds::removeGuild(this->guild->id);
+			Guilds::removeGuild(guildNew.id);
 		}
-		for (auto& valueNew: this->guild->members) {
-			GuildMemberData guildMember = GuildMembers::getCachedGuildMember({ .guildMemberId = valueNew, .guildId = this->guild->id });
+		for (auto& valueNew: guildNew.members) {
+			GuildMemberData guildMember = GuildMembers::getCachedGuildMember({ .guildMemberId = valueNew, .guildId = guildNew.id });
 			GuildMembers::removeGuildMember(guildMember);
 		}
-		for (auto& valueNew: this->guild->channels) {
+		for (auto& valueNew: guildNew.channels) {
 			Channels::removeChannel(valueNew);
 		}
-		for (auto& valueNew: this->guild->roles) {
+		for (auto& valueNew: guildNew.roles) {
 			Roles::removeRole(valueNew);
 		}
 	}
@@ -270,13 +306,20 @@ namespace DiscordCoreAPI {
 	}
 
 	OnGuildMemberAddData::OnGuildMemberAddData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal,
-		DiscordCoreClient* client) {
-		this->guildMember = std::make_unique<GuildMemberData>(data.processJsonMessage<GuildMemberData>(dataReal, "d"));
+		DiscordCoreClient* client)
+		: OnGuildMemberAddData(data.processJsonMessage<GuildMemberData>(dataReal, "d"), client){};
+
+	OnGuildMemberAddData::OnGuildMemberAddData(GuildMemberData&& guildMemberNew, DiscordCoreClient* client) {
+		this->guildMember = std::make_unique<GuildMemberData>(std::move(guildMemberNew));
 		this->discordCoreClient = client;
+		OnGuildMemberAddData::updateCache(*this->guildMember);
+	}
+
+	void OnGuildMemberAddData::updateCache(GuildMemberData& guildMemberNew) {
 		if (GuildMembers::doWeCacheGuildMembers()) {
-			GuildMembers::insertGuildMember(*this->guildMember);
+			GuildMembers::insertGuildMember(guildMemberNew);
 			GuildData guild{};
-			guild.id = guildMember->guildId;
+			guild.id = guildMemberNew.guildId;
 			if (Guilds::getCache().contains(guild)) {
 				++Guilds::getCache()[guild].memberCount;
 			}
@@ -298,14 +341,18 @@ namespace DiscordCoreAPI {
 		this->discordCoreClient = client;
 		this->guildId = getId(dataReal["d"], "guild_id");
 		this->user = std::make_unique<UserData>(data.processJsonMessage<UserData>(dataReal["d"], "user"));
-		GuildMember guildMember = GuildMembers::getCachedGuildMember({ .guildMemberId = this->user->id, .guildId = this->guildId });
+		OnGuildMemberRemoveData::updateCache(this->guildId, *this->user);
+	}
+
+	void OnGuildMemberRemoveData::updateCache(Snowflake guildIdNew, UserData& userNew) {
+		GuildMember guildMember = GuildMembers::getCachedGuildMember({ .guildMemberId = userNew.id, .guildId = guildIdNew });
 		if (GuildMembers::doWeCacheGuildMembers()) {
 			GuildData guild{};
-			guild.id = this->guildId;
+			guild.id = guildIdNew;
 			GuildMembers::removeGuildMember(guildMember);
 			if (Guilds::getCache().contains(guild)) {
 				for (uint64_t x = 0; x < Guilds::getCache()[guild].members.size(); ++x) {
-					if (Guilds::getCache()[guild].members[x] == this->user->id) {
+					if (Guilds::getCache()[guild].members[x] == userNew.id) {
 						--Guilds::getCache()[guild].memberCount;
 						Guilds::getCache()[guild].members.erase(Guilds::getCache()[guild].members.begin() + x);
 					}
@@ -326,10 +373,17 @@ namespace DiscordCoreAPI {
 	}
 
 	OnGuildMemberUpdateData::OnGuildMemberUpdateData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal,
-		DiscordCoreClient* client) {
-		this->guildMember = std::make_unique<GuildMemberData>(data.processJsonMessage<GuildMemberData>(dataReal, "d"));
+		DiscordCoreClient* client)
+		: OnGuildMemberUpdateData(data.processJsonMessage<GuildMemberData>(dataReal, "d"), client){};
+
+	OnGuildMemberUpdateData::OnGuildMemberUpdateData(GuildMemberData&& guildMemberNew, DiscordCoreClient* client) {
+		this->guildMember = std::make_unique<GuildMemberData>(std::move(guildMemberNew));
+		OnGuildMemberUpdateData::updateCache(*this->guildMember);
+	}
+
+	void OnGuildMemberUpdateData::updateCache(GuildMemberData& guildMemberNew) {
 		if (GuildMembers::doWeCacheGuildMembers()) {
-			GuildMembers::insertGuildMember(*this->guildMember);
+			GuildMembers::insertGuildMember(guildMemberNew);
 		}
 	}
 
@@ -346,16 +400,24 @@ namespace DiscordCoreAPI {
 		this->chunkEventData = data.processJsonMessage<GuildMembersChunkEventData>(dataReal, "d");
 	}
 
+	OnGuildMembersChunkData::OnGuildMembersChunkData(GuildMembersChunkEventData&& chunkEventDataNew) {
+		this->chunkEventData = std::move(chunkEventDataNew);
+	}
+
 	OnRoleCreationData::OnRoleCreationData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal) {
 		this->guildId = getId(dataReal["d"], "guild_id");
 		this->role = std::make_unique<RoleData>(data.processJsonMessage<RoleData>(dataReal["d"], "role"));
+		OnRoleCreationData::updateCache(this->guildId, *this->role);
+	}
+
+	void OnRoleCreationData::updateCache(Snowflake guildIdNew, RoleData& roleNew) {
 		GuildData guild{};
-		guild.id = guildId;
+		guild.id = guildIdNew;
 		if (Guilds::getCache().contains(guild)) {
-			Guilds::getCache()[guild].roles.emplace_back(this->role->id);
+			Guilds::getCache()[guild].roles.emplace_back(roleNew.id);
 		}
 		if (Roles::doWeCacheRoles()) {
-			Roles::insertRole(*this->role);
+			Roles::insertRole(roleNew);
 		}
 	}
 
@@ -372,8 +434,12 @@ namespace DiscordCoreAPI {
 	OnRoleUpdateData::OnRoleUpdateData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal) {
 		this->guildId = getId(dataReal["d"], "guild_id");
 		this->role = std::make_unique<RoleData>(data.processJsonMessage<RoleData>(dataReal["d"], "role"));
+		OnRoleUpdateData::updateCache(this->guildId, *this->role);
+	}
+
+	void OnRoleUpdateData::updateCache(Snowflake guildIdNew, RoleData& roleNew) {
 		if (Roles::doWeCacheRoles()) {
-			Roles::insertRole(*this->role);
+			Roles::insertRole(roleNew);
 		}
 	}
 
@@ -388,16 +454,20 @@ namespace DiscordCoreAPI {
 	}
 
 	OnRoleDeletionData::OnRoleDeletionData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal) {
-		this->role->id = getId(dataReal["d"], "role_id");
+		Snowflake roleId = getId(dataReal["d"], "role_id");
 		this->guildId = getId(dataReal["d"], "guild_id");
-		this->role = std::make_unique<RoleData>(Roles::getCachedRole({ .guildId = this->guildId, .roleId = this->role->id }));
+		this->role = std::make_unique<RoleData>(Roles::getCachedRole({ .guildId = this->guildId, .roleId = roleId }));
+		OnRoleDeletionData::updateCache(this->guildId, roleId);
+	}
+
+	void OnRoleDeletionData::updateCache(Snowflake guildIdNew, Snowflake roleIdNew) {
 		GuildData guild{};
-		guild.id = this->guildId;
+		guild.id = guildIdNew;
 		if (Roles::doWeCacheRoles()) {
-			Roles::removeRole(this->role->id);
+			Roles::removeRole(roleIdNew);
 			if (Guilds::getCache().contains(guild)) {
 				for (uint64_t x = 0; x < Guilds::getCache()[guild].roles.size(); ++x) {
-					if (Guilds::getCache()[guild].roles[x] == this->role->id) {
+					if (Guilds::getCache()[guild].roles[x] == roleIdNew) {
 						Guilds::getCache()[guild].roles.erase(Guilds::getCache()[guild].roles.begin() + x);
 					}
 				}
@@ -429,20 +499,25 @@ namespace DiscordCoreAPI {
 		this->endpoint = getString(dataReal["d"], "endpoint");
 		this->guildId = getId(dataReal["d"], "guild_id");
 		this->token = getString(dataReal["d"], "token");
-		sslShard->voiceConnectionData.endPoint = this->endpoint;
-		sslShard->voiceConnectionData.token = this->token;
+		OnVoiceServerUpdateData::updateCache(this->guildId, this->endpoint, this->token, sslShard);
+	};
+
+	void OnVoiceServerUpdateData::updateCache(Snowflake guildIdNew, const std::string& endpointNew, const std::string& tokenNew,
+		DiscordCoreInternal::WebSocketClient* sslShard) {
+		sslShard->voiceConnectionData.endPoint = endpointNew;
+		sslShard->voiceConnectionData.token = tokenNew;
 		if (sslShard->areWeCollectingData && !sslShard->serverUpdateCollected && !sslShard->stateUpdateCollected) {
 			sslShard->voiceConnectionData = DiscordCoreInternal::VoiceConnectionData{};
 			sslShard->serverUpdateCollected = true;
 		} else if (sslShard->areWeCollectingData && !sslShard->serverUpdateCollected) {
-			if (sslShard->voiceConnectionDataBuffersMap.contains(this->guildId.operator size_t())) {
-				sslShard->voiceConnectionDataBuffersMap[this->guildId.operator size_t()]->send(sslShard->voiceConnectionData);
+			if (sslShard->voiceConnectionDataBuffersMap.contains(guildIdNew.operator size_t())) {
+				sslShard->voiceConnectionDataBuffersMap[guildIdNew.operator size_t()]->send(sslShard->voiceConnectionData);
 			}
 			sslShard->serverUpdateCollected = false;
 			sslShard->stateUpdateCollected = false;
 			sslShard->areWeCollectingData = false;
 		}
-	};
+	}
 
 	OnGuildScheduledEventCreationData::OnGuildScheduledEventCreationData(DiscordCoreInternal::WebSocketMessage& data,
 		simdjson::ondemand::value dataReal) {
@@ -641,8 +716,37 @@ namespace DiscordCoreAPI {
 		}
 	}
 
-	OnPresenceUpdateData::OnPresenceUpdateData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal) {
-		this->presenceData = data.processJsonMessage<PresenceUpdateData>(dataReal, "d");
+	OnPresenceUpdateData::OnPresenceUpdateData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal)
+		: OnPresenceUpdateData(data.processJsonMessage<PresenceUpdateData>(dataReal, "d")){};
+
+	OnPresenceUpdateData::OnPresenceUpdateData(PresenceUpdateData&& presenceDataNew) {
+		this->presenceData = std::move(presenceDataNew);
+		OnPresenceUpdateData::updateCache(this->presenceData);
+	}
+
+	void OnPresenceUpdateData::updateCache(PresenceUpdateData& presenceDataNew) {
+		if (GuildMembers::doWeCacheGuildMembers()) {
+			GuildData guild{};
+			guild.id = presenceDataNew.guildId;
+			uint64_t userId{ static_cast<uint64_t>(presenceDataNew.userId) };
+			Guilds::getCache().modify(guild, [&](GuildData& guildNew) {
+				auto& presences = guildNew.presences;
+				auto result = std::lower_bound(presences.begin(), presences.end(), userId, [](const PresenceUpdateDataLight& lhs, uint64_t rhs) {
+					return static_cast<uint64_t>(lhs.userId) < rhs;
+				});
+				bool isItCached{ result != presences.end() && static_cast<uint64_t>(result->userId) == userId };
+				// Guild creates leave out the presences of those who are offline, and so those who go offline are dropped here, too.
+				if (presenceDataNew.getStatus() == PresenceStatus::Offline) {
+					if (isItCached) {
+						presences.erase(result);
+					}
+				} else if (isItCached) {
+					*result = presenceDataNew;
+				} else {
+					presences.insert(result, presenceDataNew);
+				}
+			});
+		}
 	}
 
 	OnStageInstanceCreationData::OnStageInstanceCreationData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal) {
@@ -685,22 +789,26 @@ namespace DiscordCoreAPI {
 	OnVoiceStateUpdateData::OnVoiceStateUpdateData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal,
 		DiscordCoreInternal::WebSocketClient* sslShard) {
 		this->voiceStateData = data.processJsonMessage<VoiceStateData>(dataReal, "d");
-		sslShard->voiceConnectionData.sessionId = this->voiceStateData.sessionId;
+		OnVoiceStateUpdateData::updateCache(this->voiceStateData, sslShard);
+	}
+
+	void OnVoiceStateUpdateData::updateCache(VoiceStateData& voiceStateDataNew, DiscordCoreInternal::WebSocketClient* sslShard) {
+		sslShard->voiceConnectionData.sessionId = voiceStateDataNew.sessionId;
 		if (sslShard->areWeCollectingData && !sslShard->stateUpdateCollected && !sslShard->serverUpdateCollected &&
-			this->voiceStateData.userId == sslShard->userId) {
+			voiceStateDataNew.userId == sslShard->userId) {
 			sslShard->voiceConnectionData = DiscordCoreInternal::VoiceConnectionData{};
-			sslShard->voiceConnectionData.sessionId = this->voiceStateData.sessionId;
+			sslShard->voiceConnectionData.sessionId = voiceStateDataNew.sessionId;
 			sslShard->stateUpdateCollected = true;
 		} else if (sslShard->areWeCollectingData && !sslShard->stateUpdateCollected) {
-			sslShard->voiceConnectionData.sessionId = this->voiceStateData.sessionId;
-			if (sslShard->voiceConnectionDataBuffersMap.contains(this->voiceStateData.guildId.operator size_t())) {
-				sslShard->voiceConnectionDataBuffersMap[this->voiceStateData.guildId.operator size_t()]->send(sslShard->voiceConnectionData);
+			sslShard->voiceConnectionData.sessionId = voiceStateDataNew.sessionId;
+			if (sslShard->voiceConnectionDataBuffersMap.contains(voiceStateDataNew.guildId.operator size_t())) {
+				sslShard->voiceConnectionDataBuffersMap[voiceStateDataNew.guildId.operator size_t()]->send(sslShard->voiceConnectionData);
 			}
 			sslShard->serverUpdateCollected = false;
 			sslShard->stateUpdateCollected = false;
 			sslShard->areWeCollectingData = false;
 		}
-		GuildMembers::insertVoiceState(this->voiceStateData);
+		GuildMembers::insertVoiceState(voiceStateDataNew);
 	}
 
 	OnWebhookUpdateData::OnWebhookUpdateData(DiscordCoreInternal::WebSocketMessage& data, simdjson::ondemand::value dataReal) {
@@ -190,6 +190,18 @@ namespace DiscordCoreInternal {
 		this->t = DiscordCoreAPI::getString(jsonObjectData, "t");
 	}
 
+	WebSocketMessage::WebSocketMessage(DiscordCoreAPI::EtfValue etfObjectData) {
+		etfObjectData.forEachField([&](std::string_view key, DiscordCoreAPI::EtfValue value) {
+			if (key == "op") {
+				this->op = value.getUint64();
+			} else if (key == "s") {
+				this->s = value.getUint64();
+			} else if (key == "t") {
+				this->t = value.getString();
+			}
+		});
+	}
+
 	InvalidSessionData::InvalidSessionData(simdjson::ondemand::value jsonObjectData) {
 		this->d = DiscordCoreAPI::getBool(jsonObjectData, "d");
 	}
@@ -292,6 +304,41 @@ namespace DiscordCoreAPI {
 		this->discriminator = getString(jsonObjectData, "discriminator");
 	}
 
+	UserData::UserData(EtfValue etfObjectData) {
+		int32_t newFlags{};
+		uint32_t publicFlags{};
+		etfObjectData.forEachField([&](std::string_view key, EtfValue value) {
+			if (key == "id") {
+				this->id = value.getId();
+			} else if (key == "mfa_enabled") {
+				newFlags = setBool(newFlags, UserFlags::MFAEnabled, value.getBool());
+			} else if (key == "verified") {
+				newFlags = setBool(newFlags, UserFlags::Verified, value.getBool());
+			} else if (key == "system") {
+				newFlags = setBool(newFlags, UserFlags::System, value.getBool());
+			} else if (key == "bot") {
+				newFlags = setBool(newFlags, UserFlags::Bot, value.getBool());
+			} else if (key == "public_flags") {
+				publicFlags = static_cast<uint32_t>(value.getUint64());
+			} else if (key == "username") {
+				this->userName = value.getString();
+			} else if (key == "avatar") {
+				this->avatar = value.getString();
+			} else if (key == "discriminator") {
+				this->discriminator = value.getString();
+			}
+		});
+		if (this->id == 0) {
+			return;
+		}
+
+		newFlags += publicFlags;
+
+		newFlags = setBool(newFlags, this->flags, true);
+
+		this->flags = static_cast<UserFlags>(newFlags);
+	}
+
 	std::string UserData::getAvatarUrl() {
 		std::string stringNew{ "https://cdn.discordapp.com/" };
 		stringNew += "avatars/" + this->id + "/" + this->avatar.getIconHash();
@@ -488,6 +535,18 @@ namespace DiscordCoreAPI {
 		this->userId = getId(jsonObjectData, "user_id");
 	}
 
+	VoiceStateDataLight::VoiceStateDataLight(EtfValue etfObjectData) {
+		etfObjectData.forEachField([&](std::string_view key, EtfValue value) {
+			if (key == "channel_id") {
+				this->channelId = value.getId();
+			} else if (key == "guild_id") {
+				this->guildId = value.getId();
+			} else if (key == "user_id") {
+				this->userId = value.getId();
+			}
+		});
+	}
+
 	VoiceStateData::VoiceStateData(simdjson::ondemand::value jsonObjectData) {
 		this->requestToSpeakTimestamp = getString(jsonObjectData, "request_to_speak_timestamp");
 
@@ -546,6 +605,39 @@ namespace DiscordCoreAPI {
 		this->permissions = getString(jsonObjectData, "permissions");
 	}
 
+	RoleData::RoleData(EtfValue etfObjectData) {
+		uint8_t newFlags{};
+		etfObjectData.forEachField([&](std::string_view key, EtfValue value) {
+			if (key == "id") {
+				this->id = value.getId();
+			} else if (key == "name") {
+				this->name = value.getString();
+			} else if (key == "unicode_emoji") {
+				for (auto& valueNew: value.getString()) {
+					this->unicodeEmoji.emplace_back(valueNew);
+				}
+				if (this->unicodeEmoji.size() > 3) {
+					this->unicodeEmoji = static_cast<std::string>(this->unicodeEmoji).substr(1, this->unicodeEmoji.size() - 3);
+				}
+			} else if (key == "guild_id") {
+				this->guildId = value.getId();
+			} else if (key == "color") {
+				this->color = static_cast<uint32_t>(value.getUint64());
+			} else if (key == "hoist") {
+				newFlags = setBool(newFlags, RoleFlags::Hoist, value.getBool());
+			} else if (key == "managed") {
+				newFlags = setBool(newFlags, RoleFlags::Managed, value.getBool());
+			} else if (key == "mentionable") {
+				newFlags = setBool(newFlags, RoleFlags::Mentionable, value.getBool());
+			} else if (key == "position") {
+				this->position = static_cast<uint32_t>(value.getUint64());
+			} else if (key == "permissions") {
+				this->permissions = value.getString();
+			}
+		});
+		this->flags = static_cast<RoleFlags>(newFlags);
+	}
+
 	EmojiData::EmojiData(simdjson::ondemand::value jsonObjectData) {
 		this->id = getId(jsonObjectData, "id");
 
@@ -573,23 +665,122 @@ namespace DiscordCoreAPI {
 		this->available = getBool(jsonObjectData, "available");
 	}
 
+	std::unordered_map<std::string, uint32_t> PresenceActivities::indices{};
+	std::atomic_uint64_t PresenceActivities::failedInterns{};
+	std::deque<PresenceActivities::Activity> PresenceActivities::activities{};
+	std::shared_mutex PresenceActivities::accessMutex{};
+
+	uint32_t PresenceActivities::intern(ActivityType type, std::string_view name, std::string_view url) noexcept {
+		if (name.size() == 0) {
+			return 0;
+		}
+		std::string key{};
+		key.reserve(name.size() + url.size() + 2);
+		key.push_back(static_cast<char>(type));
+		key.append(name);
+		key.push_back('\0');
+		key.append(url);
+		std::shared_lock sharedLock{ PresenceActivities::accessMutex };
+		if (auto result = PresenceActivities::indices.find(key); result != PresenceActivities::indices.end()) {
+			return result->second;
+		}
+		sharedLock.unlock();
+		std::unique_lock uniqueLock{ PresenceActivities::accessMutex };
+		if (auto result = PresenceActivities::indices.find(key); result != PresenceActivities::indices.end()) {
+			return result->second;
+		}
+		if (PresenceActivities::activities.size() >= PresenceActivities::maxActivityCount) {
+			++PresenceActivities::failedInterns;
+			return 0;
+		}
+		PresenceActivities::activities.emplace_back(Activity{ std::string{ name }, std::string{ url }, type });
+		uint32_t index{ static_cast<uint32_t>(PresenceActivities::activities.size()) };
+		PresenceActivities::indices.emplace(std::move(key), index);
+		return index;
+	}
+
+	ActivityData PresenceActivities::getActivity(uint32_t index) noexcept {
+		ActivityData returnData{};
+		std::shared_lock sharedLock{ PresenceActivities::accessMutex };
+		if (index == 0 || index > PresenceActivities::activities.size()) {
+			return returnData;
+		}
+		Activity& activity = PresenceActivities::activities[index - 1];
+		returnData.name = activity.name;
+		returnData.type = activity.type;
+		returnData.url = activity.url;
+		return returnData;
+	}
+
+	uint64_t PresenceActivities::getFailedInternCount() noexcept {
+		return PresenceActivities::failedInterns.load();
+	}
+
+	PresenceStatus PresenceUpdateDataLight::getStatus(PresenceClient client) const noexcept {
+		return static_cast<PresenceStatus>((static_cast<uint8_t>(this->theStatus) >> static_cast<uint8_t>(client)) & 0b11);
+	}
+
+	ActivityData PresenceUpdateDataLight::getActivity() const noexcept {
+		return PresenceActivities::getActivity(this->activityIndex);
+	}
+
 	PresenceUpdateData::PresenceUpdateData(simdjson::ondemand::value jsonObjectData) {
 		this->guildId = getId(jsonObjectData, "guild_id");
 
-		auto stringNew = getString(jsonObjectData, "status");
+		simdjson::ondemand::value object{};
+		if (getObject(object, "user", jsonObjectData)) {
+			this->userId = getId(object, "id");
+		}
+
+		setPresenceStatus(this->theStatus, PresenceClient::All, getString(jsonObjectData, "status"));
 
-		if (stringNew == "online") {
-			uint8_t newFlags = setBool(uint8_t{}, PresenceUpdateFlags::Status_Online, true);
-			this->theStatus = static_cast<PresenceUpdateFlags>(newFlags);
-		} else if (stringNew == "idle") {
-			uint8_t newFlags = setBool(uint8_t{}, PresenceUpdateFlags::Status_Idle, true);
-			this->theStatus = static_cast<PresenceUpdateFlags>(newFlags);
-		} else if (stringNew == "dnd") {
-			uint8_t newFlags = setBool(uint8_t{}, PresenceUpdateFlags::Status_Dnd, true);
-			this->theStatus = static_cast<PresenceUpdateFlags>(newFlags);
+		simdjson::ondemand::array arrayValue{};
+		if (getArray(arrayValue, "activities", jsonObjectData)) {
+			for (simdjson::simdjson_result<simdjson::ondemand::value> value: arrayValue) {
+				// Only the first is kept, which is the one that clients show next to the user's name.
+				simdjson::ondemand::value activity{ value.value() };
+				this->activityIndex = PresenceActivities::intern(static_cast<ActivityType>(getUint8(activity, "type")), getString(activity, "name"),
+					getString(activity, "url"));
+				break;
+			}
 		}
 
-		parseObject(jsonObjectData, this->theStatus);
+		if (getObject(object, "client_status", jsonObjectData)) {
+			parseObject(object, this->theStatus);
+		}
+	}
+
+	PresenceUpdateData::PresenceUpdateData(EtfValue etfObjectData) {
+		etfObjectData.forEachField([&](std::string_view key, EtfValue value) {
+			if (key == "guild_id") {
+				this->guildId = value.getId();
+			} else if (key == "user") {
+				this->userId = value["id"].getId();
+			} else if (key == "status") {
+				setPresenceStatus(this->theStatus, PresenceClient::All, value.getStringView());
+			} else if (key == "activities") {
+				bool haveWeInterned{};
+				value.forEachElement([&](EtfValue valueNew) {
+					if (haveWeInterned) {
+						return;
+					}
+					EtfValue url{ valueNew["url"] };
+					this->activityIndex = PresenceActivities::intern(static_cast<ActivityType>(valueNew["type"].getInt64()),
+						valueNew["name"].getStringView(), url.isNull() ? std::string_view{} : url.getStringView());
+					haveWeInterned = true;
+				});
+			} else if (key == "client_status") {
+				value.forEachField([&](std::string_view keyNew, EtfValue valueNew) {
+					if (keyNew == "desktop") {
+						setPresenceStatus(this->theStatus, PresenceClient::Desktop, valueNew.getStringView());
+					} else if (keyNew == "mobile") {
+						setPresenceStatus(this->theStatus, PresenceClient::Mobile, valueNew.getStringView());
+					} else if (keyNew == "web") {
+						setPresenceStatus(this->theStatus, PresenceClient::Web, valueNew.getStringView());
+					}
+				});
+			}
+		});
 	}
 
 	GuildMemberData& GuildMemberData::operator=(GuildMemberData&& other) noexcept {
@@ -655,6 +846,49 @@ namespace DiscordCoreAPI {
 		*this = jsonObjectData;
 	}
 
+	GuildMemberData& GuildMemberData::operator=(EtfValue etfObjectData) {
+		uint8_t newFlags{};
+		uint8_t memberFlags{};
+		etfObjectData.forEachField([&](std::string_view key, EtfValue value) {
+			if (key == "pending") {
+				newFlags = setBool(newFlags, GuildMemberFlags::Pending, value.getBool());
+			} else if (key == "mute") {
+				newFlags = setBool(newFlags, GuildMemberFlags::Mute, value.getBool());
+			} else if (key == "deaf") {
+				newFlags = setBool(newFlags, GuildMemberFlags::Deaf, value.getBool());
+			} else if (key == "joined_at") {
+				this->joinedAt = value.getString();
+			} else if (key == "guild_id") {
+				this->guildId = value.getId();
+			} else if (key == "roles") {
+				this->roles.clear();
+				value.forEachElement([&](EtfValue valueNew) {
+					this->roles.emplace_back(valueNew.getId());
+				});
+			} else if (key == "permissions") {
+				this->permissions = value.getString();
+			} else if (key == "user") {
+				UserData user{ value };
+				this->id = user.id;
+				Users::insertUser(std::move(user));
+			} else if (key == "avatar") {
+				this->avatar = value.getString();
+			} else if (key == "flags") {
+				memberFlags = static_cast<uint8_t>(value.getUint64());
+			} else if (key == "nick") {
+				this->nick = value.getString();
+			}
+		});
+		newFlags += memberFlags;
+
+		this->flags = static_cast<GuildMemberFlags>(newFlags);
+		return *this;
+	}
+
+	GuildMemberData::GuildMemberData(EtfValue etfObjectData) {
+		*this = etfObjectData;
+	}
+
 	VoiceStateDataLight GuildMemberData::getVoiceStateData() {
 		VoiceStateDataLight dataToGet{};
 		dataToGet.guildId = this->guildId;
@@ -694,6 +928,20 @@ namespace DiscordCoreAPI {
 		this->type = static_cast<PermissionOverwritesType>(getUint8(jsonObjectData, "type"));
 	}
 
+	OverWriteData::OverWriteData(EtfValue etfObjectData) {
+		etfObjectData.forEachField([&](std::string_view key, EtfValue value) {
+			if (key == "id") {
+				this->id = value.getId();
+			} else if (key == "allow") {
+				this->allow = value.getUint64();
+			} else if (key == "deny") {
+				this->deny = value.getUint64();
+			} else if (key == "type") {
+				this->type = static_cast<PermissionOverwritesType>(value.getUint64());
+			}
+		});
+	}
+
 	DefaultReactionData::DefaultReactionData(simdjson::ondemand::value jsonObjectData) {
 		this->emojiId = getId(jsonObjectData, "emoji_id");
 
@@ -748,6 +996,44 @@ namespace DiscordCoreAPI {
 		this->name = getString(jsonObjectData, "name");
 	}
 
+	ChannelData::ChannelData(EtfValue etfObjectData) {
+		uint8_t newFlags{};
+		uint8_t channelFlags{};
+		etfObjectData.forEachField([&](std::string_view key, EtfValue value) {
+			if (key == "nsfw") {
+				newFlags = setBool(newFlags, ChannelFlags::NSFW, value.getBool());
+			} else if (key == "type") {
+				this->type = static_cast<ChannelType>(value.getUint64());
+			} else if (key == "default_sort_order") {
+				this->defaultSortOrder = static_cast<SortOrderTypes>(value.getUint64());
+			} else if (key == "member_count") {
+				this->memberCount = static_cast<uint32_t>(value.getUint64());
+			} else if (key == "owner_id") {
+				this->ownerId = value.getId();
+			} else if (key == "id") {
+				this->id = value.getId();
+			} else if (key == "flags") {
+				channelFlags = static_cast<uint8_t>(value.getUint64());
+			} else if (key == "parent_id") {
+				this->parentId = value.getId();
+			} else if (key == "guild_id") {
+				this->guildId = value.getId();
+			} else if (key == "position") {
+				this->position = static_cast<uint32_t>(value.getUint64());
+			} else if (key == "permission_overwrites") {
+				this->permissionOverwrites.clear();
+				value.forEachElement([&](EtfValue valueNew) {
+					this->permissionOverwrites.emplace_back(OverWriteData{ valueNew });
+				});
+			} else if (key == "name") {
+				this->name = value.getString();
+			}
+		});
+		newFlags += channelFlags;
+
+		this->flags = static_cast<ChannelFlags>(newFlags);
+	}
+
 	ActiveThreadsData::ActiveThreadsData(simdjson::ondemand::value jsonObjectData) {
 		simdjson::ondemand::array arrayValue{};
 		if (getArray(arrayValue, "threads", jsonObjectData)) {
@@ -1511,11 +1797,12 @@ namespace DiscordCoreAPI {
 			this->presences.clear();
 			if (getArray(arrayValue, "presences", jsonObjectData)) {
 				for (auto value: arrayValue) {
-					PresenceUpdateData newData{ value.value() };
-					newData.guildId = this->id;
-					this->presences.emplace_back(std::move(newData));
+					this->presences.emplace_back(PresenceUpdateData{ value.value() });
 				}
 			}
+			std::sort(this->presences.begin(), this->presences.end(), [](const auto& lhs, const auto& rhs) {
+				return static_cast<uint64_t>(lhs.userId) < static_cast<uint64_t>(rhs.userId);
+			});
 		}
 
 		if (Channels::doWeCacheChannels()) {
@@ -1531,6 +1818,121 @@ namespace DiscordCoreAPI {
 		}
 	}
 
+	GuildData::GuildData(EtfValue etfObjectData) {
+		uint8_t newFlags{};
+		EtfValue roles{};
+		EtfValue members{};
+		EtfValue voiceStates{};
+		EtfValue presences{};
+		EtfValue channels{};
+		etfObjectData.forEachField([&](std::string_view key, EtfValue value) {
+			if (key == "widget_enabled") {
+				newFlags = setBool(newFlags, GuildFlags::WidgetEnabled, value.getBool());
+			} else if (key == "unavailable") {
+				newFlags = setBool(newFlags, GuildFlags::Unavailable, value.getBool());
+			} else if (key == "owner") {
+				newFlags = setBool(newFlags, GuildFlags::Owner, value.getBool());
+			} else if (key == "large") {
+				newFlags = setBool(newFlags, GuildFlags::Large, value.getBool());
+			} else if (key == "owner_id") {
+				this->ownerId = value.getId();
+			} else if (key == "member_count") {
+				this->memberCount = static_cast<uint32_t>(value.getUint64());
+			} else if (key == "joined_at") {
+				this->joinedAt = value.getString();
+			} else if (key == "id") {
+				this->id = value.getId();
+			} else if (key == "icon") {
+				this->icon = value.getString();
+			} else if (key == "name") {
+				this->name = value.getString();
+			} else if (key == "threads") {
+				this->threads.clear();
+				value.forEachElement([&](EtfValue valueNew) {
+					this->threads.emplace_back(valueNew["id"].getId());
+				});
+			} else if (key == "stickers") {
+				this->stickers.clear();
+				value.forEachElement([&](EtfValue valueNew) {
+					this->stickers.emplace_back(valueNew["id"].getId());
+				});
+			} else if (key == "guild_scheduled_events") {
+				this->guildScheduledEvents.clear();
+				value.forEachElement([&](EtfValue valueNew) {
+					this->guildScheduledEvents.emplace_back(valueNew["id"].getId());
+				});
+			} else if (key == "stage_instances") {
+				this->stageInstances.clear();
+				value.forEachElement([&](EtfValue valueNew) {
+					this->stageInstances.emplace_back(valueNew["id"].getId());
+				});
+			} else if (key == "emoji") {
+				this->emoji.clear();
+				value.forEachElement([&](EtfValue valueNew) {
+					this->emoji.emplace_back(valueNew["id"].getId());
+				});
+			} else if (key == "roles") {
+				roles = value;
+			} else if (key == "members") {
+				members = value;
+			} else if (key == "voice_states") {
+				voiceStates = value;
+			} else if (key == "presences") {
+				presences = value;
+			} else if (key == "channels") {
+				channels = value;
+			}
+		});
+
+		this->flags = static_cast<GuildFlags>(newFlags);
+
+		if (Roles::doWeCacheRoles()) {
+			this->roles.clear();
+			roles.forEachElement([&](EtfValue value) {
+				RoleData newData{ value };
+				newData.guildId = this->id;
+				this->roles.emplace_back(newData.id);
+				Roles::insertRole(std::move(newData));
+			});
+		}
+
+		if (GuildMembers::doWeCacheGuildMembers()) {
+			this->members.clear();
+			members.forEachElement([&](EtfValue value) {
+				GuildMemberData newData{ value };
+				newData.guildId = this->id;
+				this->members.emplace_back(newData.id);
+				GuildMembers::insertGuildMember(std::move(newData));
+			});
+		}
+
+		voiceStates.forEachElement([&](EtfValue value) {
+			VoiceStateDataLight dataNew{ value };
+			dataNew.guildId = this->id;
+			GuildMembers::vsCache[dataNew] = dataNew;
+		});
+
+		if (GuildMembers::doWeCacheGuildMembers()) {
+			this->presences.clear();
+			presences.forEachElement([&](EtfValue value) {
+				this->presences.emplace_back(PresenceUpdateData{ value });
+			});
+			std::sort(this->presences.begin(), this->presences.end(), [](const auto& lhs, const auto& rhs) {
+				return static_cast<uint64_t>(lhs.userId) < static_cast<uint64_t>(rhs.userId);
+			});
+		}
+
+		if (Channels::doWeCacheChannels()) {
+			this->channels.clear();
+			channels.forEachElement([&](EtfValue value) {
+				ChannelData newData{ value };
+				newData.guildId = this->id;
+				this->channels.emplace_back(newData.id);
+				Channels::insertChannel(std::move(newData));
+			});
+		}
+	}
+
 	GuildDataVector::GuildDataVector(simdjson::ondemand::value jsonObjectData) {
 		if (jsonObjectData.type() != simdjson::ondemand::json_type::null) {
 			simdjson::ondemand::array arrayValue{};
@@ -2939,11 +3341,43 @@ namespace DiscordCoreAPI {
 		if (getArray(arrayValue, "members", jsonObjectData)) {
 			for (simdjson::simdjson_result<simdjson::ondemand::value> value: arrayValue) {
 				GuildMemberData newData{ value.value() };
+				newData.guildId = this->guildId;
 				this->members.emplace_back(std::move(newData));
 			}
 		}
 	}
 
+	GuildMembersChunkEventData::GuildMembersChunkEventData(EtfValue etfObjectData) {
+		EtfValue members{};
+		etfObjectData.forEachField([&](std::string_view key, EtfValue value) {
+			if (key == "guild_id") {
+				this->guildId = value.getId();
+			} else if (key == "nonce") {
+				this->nonce = value.getString();
+			} else if (key == "chunk_index") {
+				this->chunkIndex = static_cast<int32_t>(value.getInt64());
+			} else if (key == "chunk_count") {
+				this->chunkCount = static_cast<int32_t>(value.getInt64());
+			} else if (key == "presences") {
+				value.forEachElement([&](EtfValue valueNew) {
+					this->presences.emplace_back(valueNew);
+				});
+			} else if (key == "not_found") {
+				value.forEachElement([&](EtfValue valueNew) {
+					this->notFound.emplace_back(valueNew.getString());
+				});
+			} else if (key == "members") {
+				members = value;
+			}
+		});
+		// The members carry no guild_id of their own, so they wait until the chunk's is known.
+		members.forEachElement([&](EtfValue value) {
+			GuildMemberData newData{ value };
+			newData.guildId = this->guildId;
+			this->members.emplace_back(std::move(newData));
+		});
+	}
+
 	MediaTranscoding::MediaTranscoding(simdjson::ondemand::value jsonObjectData) {
 		this->thePreset = getString(jsonObjectData, "preset");
 
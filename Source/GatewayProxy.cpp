@@ -0,0 +1,384 @@
+/*
+	DiscordCoreAPI, A bot library for Discord, written in C++, and featuring explicit multithreading through the usage of custom, asynchronous C++ CoRoutines.
+
+	Copyright 2021, 2022 Chris M. (RealTimeChris)
+
+	This library is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 2.1 of the License, or (at your option) any later version.
+
+	This library is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+	USA
+*/
+/// GatewayProxy.cpp - Source file for sharing one process's gateway dispatches with other processes.
+/// Oct 17, 2022
+/// https://discordcoreapi.com
+/// \file GatewayProxy.cpp
+
+#include <discordcoreapi/GatewayProxy.hpp>
+#include <discordcoreapi/DiscordCoreClient.hpp>
+#include <sstream>
+
+namespace DiscordCoreInternal {
+
+	// Each connection opens with a handshake frame carrying "<total shards> <text format>", after which every frame is one dispatch payload,
+	// decompressed but otherwise just as the publisher's shard received it. The first of them are the GUILD_CREATEs of the guild snapshot.
+
+	GatewayProxyPublisher::GatewayProxyPublisher(DiscordCoreAPI::ConfigManager* configManagerNew) noexcept {
+		this->configManager = configManagerNew;
+	}
+
+	bool GatewayProxyPublisher::start() noexcept {
+#ifdef __linux__
+		DiscordCoreAPI::GatewayProxyOptions gatewayProxyOptions{ this->configManager->getGatewayProxyOptions() };
+		this->listenSocket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+		sockaddr_un address{};
+		address.sun_family = AF_UNIX;
+		if (this->listenSocket == SOCKET_ERROR || gatewayProxyOptions.socketPath.size() >= sizeof(address.sun_path)) {
+			if (this->configManager->doWePrintGeneralErrorMessages()) {
+				cout << DiscordCoreAPI::shiftToBrightRed() << "Failed to create the gateway proxy socket at " << gatewayProxyOptions.socketPath << "."
+					 << DiscordCoreAPI::reset() << endl
+					 << endl;
+			}
+			return false;
+		}
+		std::copy(gatewayProxyOptions.socketPath.begin(), gatewayProxyOptions.socketPath.end(), address.sun_path);
+		::unlink(gatewayProxyOptions.socketPath.c_str());
+		if (::bind(this->listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == SOCKET_ERROR ||
+			::listen(this->listenSocket, SOMAXCONN) == SOCKET_ERROR) {
+			if (this->configManager->doWePrintGeneralErrorMessages()) {
+				cout << DiscordCoreAPI::shiftToBrightRed() << "Failed to listen on the gateway proxy socket at " << gatewayProxyOptions.socketPath
+					 << "." << DiscordCoreAPI::reset() << endl
+					 << endl;
+			}
+			return false;
+		}
+		this->taskThread = std::make_unique<std::jthread>([this](std::stop_token token) {
+			this->run(token);
+		});
+		return true;
+#else
+		if (this->configManager->doWePrintGeneralErrorMessages()) {
+			cout << DiscordCoreAPI::shiftToBrightRed() << "The gateway proxy needs Unix domain sockets, which this platform does not have."
+				 << DiscordCoreAPI::reset() << endl
+				 << endl;
+		}
+		return false;
+#endif
+	}
+
+	void GatewayProxyPublisher::publish(uint32_t shardId, std::string_view frame, GatewayEventType eventType) noexcept {
+		if (eventType == GatewayEventType::Guild_Create || eventType == GatewayEventType::Guild_Delete) {
+			this->updateGuildSnapshot(shardId, frame, eventType);
+		}
+		if (this->activeConsumers.load() == 0) {
+			return;
+		}
+		GatewayProxyFrameHeader header{ .shardId = shardId, .size = static_cast<uint32_t>(frame.size()) };
+		uint64_t maxConsumerBacklog{ this->configManager->getGatewayProxyOptions().maxConsumerBacklog };
+		std::unique_lock lock{ this->accessMutex };
+		std::vector<std::pair<uint32_t, std::string>> consumersToRemove{};
+		for (auto& [key, value]: this->consumers) {
+			bool wasItIdle{ value.outputBuffer.size() == 0 };
+			value.outputBuffer.append(reinterpret_cast<const char*>(&header), sizeof(header));
+			value.outputBuffer.append(frame);
+			// A consumer that cannot keep up is cut loose, rather than being allowed to hold up the shards or to take all of the memory.
+			if (value.outputBuffer.size() > maxConsumerBacklog + value.snapshotBacklog) {
+				consumersToRemove.emplace_back(key, "fell too far behind");
+			} else if (wasItIdle && !this->writeData(value)) {
+				consumersToRemove.emplace_back(key, "disconnected");
+			}
+		}
+		for (auto& [key, value]: consumersToRemove) {
+			this->removeConsumer(key, value);
+		}
+	}
+
+	bool GatewayProxyPublisher::writeData(Consumer& consumer) noexcept {
+#ifdef __linux__
+		while (consumer.outputBuffer.size() > 0) {
+			auto bytesWritten =
+				::send(consumer.socket, consumer.outputBuffer.data(), consumer.outputBuffer.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+			if (bytesWritten == SOCKET_ERROR) {
+				if (errno == EINTR) {
+					continue;
+				}
+				return errno == EWOULDBLOCK || errno == EAGAIN;
+			}
+			consumer.outputBuffer.erase(0, static_cast<uint64_t>(bytesWritten));
+		}
+		consumer.snapshotBacklog = 0;
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	void GatewayProxyPublisher::removeConsumer(uint32_t consumerId, const std::string& reason) noexcept {
+		if (this->configManager->doWePrintGeneralErrorMessages()) {
+			cout << DiscordCoreAPI::shiftToBrightRed() << "Gateway proxy consumer " << consumerId << " " << reason << "." << DiscordCoreAPI::reset()
+				 << endl
+				 << endl;
+		}
+		this->consumers.erase(consumerId);
+		--this->activeConsumers;
+	}
+
+	void GatewayProxyPublisher::updateGuildSnapshot(uint32_t shardId, std::string_view frame, GatewayEventType eventType) noexcept {
+		if (!this->configManager->getGatewayProxyOptions().replayGuildCreates) {
+			return;
+		}
+		// The shard's own parsers are still in use on its thread.
+		thread_local simdjson::ondemand::parser parser{};
+		std::string frameNew{};
+		frameNew.reserve(frame.size() + simdjson::SIMDJSON_PADDING);
+		frameNew.append(frame);
+		uint64_t guildId{};
+		try {
+			if (this->configManager->getTextFormat() == DiscordCoreAPI::TextFormat::Etf) {
+				guildId = static_cast<uint64_t>(DiscordCoreAPI::EtfValue{ frameNew, 1 }["d"]["id"].getId());
+			} else {
+				simdjson::ondemand::value dValue{};
+				simdjson::ondemand::value object{};
+				if (parser.iterate(simdjson::padded_string_view(frameNew.data(), frameNew.length(), frameNew.capacity())).get(dValue) ==
+						simdjson::error_code::SUCCESS &&
+					DiscordCoreAPI::getObject(object, "d", dValue)) {
+					guildId = static_cast<uint64_t>(DiscordCoreAPI::getId(object, "id"));
+				}
+			}
+		} catch (...) {
+			DiscordCoreAPI::reportException("GatewayProxyPublisher::updateGuildSnapshot()");
+			return;
+		}
+		if (guildId == 0) {
+			return;
+		}
+		std::unique_lock lock{ this->accessMutex };
+		if (eventType == GatewayEventType::Guild_Create) {
+			this->guildSnapshot[guildId] = std::make_pair(shardId, std::move(frameNew));
+		} else {
+			this->guildSnapshot.erase(guildId);
+		}
+	}
+
+	void GatewayProxyPublisher::run(std::stop_token token) noexcept {
+#ifdef __linux__
+		while (!token.stop_requested()) {
+			std::vector<pollfd> polls{ pollfd{ this->listenSocket, POLLIN, 0 } };
+			std::vector<uint32_t> consumerIds{};
+			std::unique_lock lock{ this->accessMutex };
+			for (auto& [key, value]: this->consumers) {
+				int16_t events{ static_cast<int16_t>(value.outputBuffer.size() > 0 ? POLLIN | POLLOUT : POLLIN) };
+				polls.emplace_back(pollfd{ value.socket, events, 0 });
+				consumerIds.emplace_back(key);
+			}
+			lock.unlock();
+			// The shards write to idle consumers themselves, so this only has to catch backlogs and new consumers, and can afford to sleep a while.
+			if (::poll(polls.data(), polls.size(), 10) == SOCKET_ERROR && errno != EINTR) {
+				break;
+			}
+			lock.lock();
+			if (polls[0].revents & POLLIN) {
+				SOCKET socketNew = ::accept(this->listenSocket, nullptr, nullptr);
+				if (socketNew != SOCKET_ERROR) {
+					std::string handshake{ std::to_string(this->configManager->getTotalShardCount()) + " " +
+						std::to_string(static_cast<uint32_t>(this->configManager->getTextFormat())) };
+					GatewayProxyFrameHeader header{ .shardId = GatewayProxyFrameHeader::handshakeShardId,
+						.size = static_cast<uint32_t>(handshake.size()) };
+					Consumer& consumer = this->consumers[this->consumerCount];
+					consumer.socket = socketNew;
+					consumer.outputBuffer.append(reinterpret_cast<const char*>(&header), sizeof(header));
+					consumer.outputBuffer.append(handshake);
+					// Without these, a consumer that connects after the shards came online would never hear of the guilds that they already have.
+					for (auto& [key, value]: this->guildSnapshot) {
+						GatewayProxyFrameHeader frameHeader{ .shardId = value.first, .size = static_cast<uint32_t>(value.second.size()) };
+						consumer.outputBuffer.append(reinterpret_cast<const char*>(&frameHeader), sizeof(frameHeader));
+						consumer.outputBuffer.append(value.second);
+					}
+					consumer.snapshotBacklog = consumer.outputBuffer.size();
+					++this->activeConsumers;
+					if (this->configManager->doWePrintGeneralSuccessMessages()) {
+						cout << DiscordCoreAPI::shiftToBrightGreen() << "Gateway proxy consumer " << this->consumerCount << " connected."
+							 << DiscordCoreAPI::reset() << endl
+							 << endl;
+					}
+					++this->consumerCount;
+				}
+			}
+			for (uint64_t x = 1; x < polls.size(); ++x) {
+				uint32_t consumerId{ consumerIds[x - 1] };
+				if (!this->consumers.contains(consumerId)) {
+					continue;
+				}
+				Consumer& consumer = this->consumers[consumerId];
+				// Consumers never send anything, so anything readable on their sockets is them going away.
+				if (polls[x].revents & (POLLIN | POLLHUP | POLLERR)) {
+					char buffer[256]{};
+					auto bytesRead = ::recv(consumer.socket, buffer, sizeof(buffer), MSG_DONTWAIT);
+					if (bytesRead == 0 || (bytesRead == SOCKET_ERROR && errno != EINTR && errno != EWOULDBLOCK && errno != EAGAIN)) {
+						this->removeConsumer(consumerId, "disconnected");
+						continue;
+					}
+				}
+				if (consumer.outputBuffer.size() > 0 && !this->writeData(consumer)) {
+					this->removeConsumer(consumerId, "disconnected");
+				}
+			}
+		}
+		::unlink(this->configManager->getGatewayProxyOptions().socketPath.c_str());
+#endif
+	}
+
+	GatewayProxyPublisher::~GatewayProxyPublisher() noexcept {
+		this->taskThread.reset(nullptr);
+	}
+
+	GatewayProxyConsumer::GatewayProxyConsumer(DiscordCoreAPI::DiscordCoreClient* discordCoreClientNew, std::atomic_bool* doWeQuitNew) noexcept {
+		this->discordCoreClient = discordCoreClientNew;
+		this->doWeQuit = doWeQuitNew;
+	}
+
+	bool GatewayProxyConsumer::connect() noexcept {
+#ifdef __linux__
+		DiscordCoreAPI::GatewayProxyOptions gatewayProxyOptions{ this->discordCoreClient->configManager.getGatewayProxyOptions() };
+		this->socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+		this->inputBuffer.clear();
+		sockaddr_un address{};
+		address.sun_family = AF_UNIX;
+		if (this->socket == SOCKET_ERROR || gatewayProxyOptions.socketPath.size() >= sizeof(address.sun_path)) {
+			return false;
+		}
+		std::copy(gatewayProxyOptions.socketPath.begin(), gatewayProxyOptions.socketPath.end(), address.sun_path);
+		if (::connect(this->socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == SOCKET_ERROR) {
+			return false;
+		}
+		DiscordCoreAPI::StopWatch<Milliseconds> stopWatch{ 10000ms };
+		while (!stopWatch.hasTimePassed() && !this->doWeQuit->load()) {
+			pollfd readPoll{ this->socket, POLLIN, 0 };
+			if (::poll(&readPoll, 1, 100) <= 0) {
+				continue;
+			}
+			if (!this->readData()) {
+				return false;
+			}
+			if (this->inputBuffer.size() < sizeof(GatewayProxyFrameHeader)) {
+				continue;
+			}
+			GatewayProxyFrameHeader header{};
+			std::memcpy(&header, this->inputBuffer.data(), sizeof(header));
+			if (header.shardId != GatewayProxyFrameHeader::handshakeShardId || header.size > GatewayProxyFrameHeader::maxFrameSize) {
+				return false;
+			}
+			if (this->inputBuffer.size() < sizeof(header) + header.size) {
+				continue;
+			}
+			std::istringstream stream{ this->inputBuffer.substr(sizeof(header), header.size) };
+			uint32_t totalShardCount{};
+			uint32_t textFormat{};
+			if (!(stream >> totalShardCount >> textFormat) || totalShardCount == 0) {
+				return false;
+			}
+			// The frames are parsed by the same code that would have parsed them off of the gateway, which has to expect what the publisher got.
+			this->discordCoreClient->configManager.setTotalShardCount(totalShardCount);
+			this->discordCoreClient->configManager.setTextFormat(static_cast<DiscordCoreAPI::TextFormat>(textFormat));
+			this->inputBuffer.erase(0, sizeof(header) + header.size);
+			return true;
+		}
+		return false;
+#else
+		return false;
+#endif
+	}
+
+	void GatewayProxyConsumer::start() noexcept {
+		this->taskThread = std::make_unique<std::jthread>([this](std::stop_token token) {
+			this->run(token);
+		});
+	}
+
+	void GatewayProxyConsumer::stop() noexcept {
+		this->taskThread.reset(nullptr);
+	}
+
+	bool GatewayProxyConsumer::readData() noexcept {
+#ifdef __linux__
+		static constexpr uint64_t readSize{ 64 * 1024 };
+		uint64_t oldSize{ this->inputBuffer.size() };
+		this->inputBuffer.resize(oldSize + readSize);
+		auto bytesRead = ::recv(this->socket, this->inputBuffer.data() + oldSize, readSize, 0);
+		this->inputBuffer.resize(oldSize + static_cast<uint64_t>(std::max(bytesRead, static_cast<decltype(bytesRead)>(0))));
+		return bytesRead > 0 || (bytesRead == SOCKET_ERROR && (errno == EINTR || errno == EWOULDBLOCK));
+#else
+		return false;
+#endif
+	}
+
+	bool GatewayProxyConsumer::processFrames() noexcept {
+		// The JSON parser reads a little way past the end of each payload, including the last one.
+		this->inputBuffer.reserve(this->inputBuffer.size() + StringBuffer::paddingSize);
+		uint64_t offset{};
+		while (this->inputBuffer.size() - offset >= sizeof(GatewayProxyFrameHeader)) {
+			GatewayProxyFrameHeader header{};
+			std::memcpy(&header, this->inputBuffer.data() + offset, sizeof(header));
+			if (header.size > GatewayProxyFrameHeader::maxFrameSize || header.shardId == GatewayProxyFrameHeader::handshakeShardId) {
+				return false;
+			}
+			if (this->inputBuffer.size() - offset - sizeof(header) < header.size) {
+				break;
+			}
+			this->onFrame(header.shardId, std::string_view{ this->inputBuffer.data() + offset + sizeof(header), header.size });
+			offset += sizeof(header) + header.size;
+		}
+		this->inputBuffer.erase(0, offset);
+		return true;
+	}
+
+	void GatewayProxyConsumer::onFrame(uint32_t shardId, std::string_view frame) noexcept {
+		try {
+			if (!this->shardMap.contains(shardId)) {
+				this->shardMap[shardId] = std::make_unique<WebSocketClient>(this->discordCoreClient, shardId, this->doWeQuit);
+				this->shardMap[shardId]->areWeProxied = true;
+			}
+			this->shardMap[shardId]->onMessageReceived(frame);
+		} catch (...) {
+			DiscordCoreAPI::reportException("GatewayProxyConsumer::onFrame()");
+		}
+	}
+
+	void GatewayProxyConsumer::run(std::stop_token token) noexcept {
+#ifdef __linux__
+		while (!token.stop_requested() && !this->doWeQuit->load()) {
+			pollfd readPoll{ this->socket, POLLIN, 0 };
+			auto result = ::poll(&readPoll, 1, 100);
+			if (result == 0 || (result == SOCKET_ERROR && errno == EINTR)) {
+				continue;
+			}
+			if (result != SOCKET_ERROR && this->readData() && this->processFrames()) {
+				continue;
+			}
+			// Whatever the publisher's shards dispatch in the meantime is missed, as it would be by a shard of our own that had to reconnect.
+			if (this->discordCoreClient->configManager.doWePrintGeneralErrorMessages()) {
+				cout << DiscordCoreAPI::shiftToBrightRed() << "Lost the connection to the gateway proxy... reconnecting." << DiscordCoreAPI::reset()
+					 << endl
+					 << endl;
+			}
+			while (!token.stop_requested() && !this->doWeQuit->load() && !this->connect()) {
+				std::this_thread::sleep_for(1s);
+			}
+		}
+#endif
+	}
+
+	GatewayProxyConsumer::~GatewayProxyConsumer() noexcept {
+		this->stop();
+	}
+
+}
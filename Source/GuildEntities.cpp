@@ -152,9 +152,7 @@ namespace DiscordCoreAPI {
 				this->guildScheduledEvents.emplace_back(std::move(data));
 			}
 			for (auto& value: other.presences) {
-				PresenceUpdateData data{};
-				data.userId = value.userId;
-				this->presences.emplace(data.userId, std::move(data));
+				this->presences.emplace(static_cast<uint64_t>(value.userId), value);
 			}
 			for (auto& value: other.stageInstances) {
 				StageInstance data{};
@@ -216,9 +214,7 @@ namespace DiscordCoreAPI {
 				this->guildScheduledEvents.emplace_back(data);
 			}
 			for (auto& value: other.presences) {
-				PresenceUpdateData data{};
-				data.userId = value.userId;
-				this->presences.emplace(data.userId, data);
+				this->presences.emplace(static_cast<uint64_t>(value.userId), value);
 			}
 			for (auto& value: other.stageInstances) {
 				StageInstance data{};
@@ -615,7 +611,7 @@ namespace DiscordCoreAPI {
 			guild.discordCoreClient = Guilds::discordCoreClient;
 			return guild;
 		} else {
-			GuildData guild = Guilds::getCache().at(data);
+			GuildData guild = Guilds::getCache().copy(data);
 			guild.discordCoreClient = Guilds::discordCoreClient;
 			return guild;
 		}
@@ -376,6 +376,15 @@ namespace DiscordCoreAPI {
 		}
 	}
 
+	void GuildMembers::insertGuildMembers(std::vector<GuildMemberData>&& guildMembers) {
+		if (GuildMembers::doWeCacheGuildMembers()) {
+			std::erase_if(guildMembers, [](const GuildMemberData& value) {
+				return value.id == 0;
+			});
+			GuildMembers::cache.emplace(std::move(guildMembers));
+		}
+	}
+
 	void GuildMembers::removeGuildMember(GuildMemberData guildMember) {
 		GuildMembers::cache.erase(guildMember);
 	};
@@ -164,7 +164,413 @@ namespace DiscordCoreInternal {
 		return this->ptr;
 	}
 
-	bool SSLConnectionInterface::initialize() noexcept {
+	void DnsResolver::initialize(const std::unordered_map<std::string, std::string>& hostOverridesNew, Seconds ttlNew) noexcept {
+		std::unique_lock lock{ DnsResolver::accessMutex };
+		DnsResolver::hostOverrides = hostOverridesNew;
+		DnsResolver::ttl = ttlNew;
+		DnsResolver::cache.clear();
+	}
+
+	bool DnsResolver::resolve(const std::string& host, uint16_t port, int32_t socketType, addrinfoWrapper& address, Milliseconds timeToWait) noexcept {
+		std::unique_lock lock{ DnsResolver::accessMutex };
+		std::string hostNew{ DnsResolver::hostOverrides.contains(host) ? DnsResolver::hostOverrides[host] : host };
+		auto& entryNew = DnsResolver::cache[hostNew + ":" + std::to_string(port) + ":" + std::to_string(socketType)];
+		if (!entryNew) {
+			entryNew = std::make_shared<CacheEntry>();
+		}
+		auto entry = entryNew;
+		auto ttlNew = DnsResolver::ttl;
+		lock.unlock();
+
+		std::unique_lock entryLock{ entry->accessMutex };
+		bool isItFresh{ entry->expiry > std::chrono::steady_clock::now() };
+		if (!isItFresh && !entry->pendingLookup.valid()) {
+			entry->pendingLookup = DnsResolver::startLookup(entry, hostNew, port, socketType, ttlNew);
+		}
+		// Only a host that has never resolved waits on the lookup - an expired answer is served while it is refreshed.
+		if (!isItFresh && !entry->didItResolve) {
+			auto pendingLookup = entry->pendingLookup;
+			entryLock.unlock();
+			if (pendingLookup.wait_for(timeToWait) != std::future_status::ready) {
+				return false;
+			}
+			entryLock.lock();
+		}
+		if (!entry->didItResolve) {
+			return false;
+		}
+		address.storage = entry->address;
+		address.value = addrinfo{};
+		address.value.ai_family = AF_INET;
+		address.value.ai_socktype = socketType;
+		address.value.ai_protocol = socketType == SOCK_STREAM ? IPPROTO_TCP : IPPROTO_UDP;
+		address.value.ai_addrlen = entry->addressLength;
+		address.value.ai_addr = reinterpret_cast<sockaddr*>(&address.storage);
+		address.ptr = &address.value;
+		return true;
+	}
+
+	std::shared_future<void> DnsResolver::startLookup(std::shared_ptr<CacheEntry> entry, const std::string& host, uint16_t port, int32_t socketType,
+		Seconds ttlNew) noexcept {
+		std::promise<void> promise{};
+		auto returnValue = promise.get_future().share();
+		try {
+			std::thread{ [=, promise = std::move(promise)]() mutable {
+				addrinfoWrapper hints{};
+				hints->ai_family = AF_INET;
+				hints->ai_socktype = socketType;
+				hints->ai_protocol = socketType == SOCK_STREAM ? IPPROTO_TCP : IPPROTO_UDP;
+				addrinfo* result{};
+				auto errorValue = getaddrinfo(host.c_str(), std::to_string(port).c_str(), hints, &result);
+				std::unique_lock lock{ entry->accessMutex };
+				if (errorValue == 0 && result) {
+					std::memcpy(&entry->address, result->ai_addr, result->ai_addrlen);
+					entry->addressLength = static_cast<socklen_t>(result->ai_addrlen);
+					entry->expiry = std::chrono::steady_clock::now() + ttlNew;
+					entry->didItResolve = true;
+				} else {
+					// A host that resolved before keeps its last answer through a failed refresh.
+					entry->expiry = std::chrono::steady_clock::now() + DnsResolver::negativeTtl;
+				}
+				entry->pendingLookup = {};
+				lock.unlock();
+				if (result) {
+					freeaddrinfo(result);
+				}
+				promise.set_value();
+			} }.detach();
+		} catch (...) {
+			DiscordCoreAPI::reportException("DnsResolver::startLookup()");
+		}
+		return returnValue;
+	}
+
+#ifdef __linux__
+	EpollWrapper::EpollWrapper() noexcept {
+		this->epollFd = epoll_create1(EPOLL_CLOEXEC);
+		this->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (this->epollFd != SOCKET_ERROR && this->wakeFd != SOCKET_ERROR) {
+			epoll_event event{ .events = EPOLLIN | EPOLLET, .data = { .ptr = nullptr } };
+			epoll_ctl(this->epollFd, EPOLL_CTL_ADD, this->wakeFd, &event);
+		}
+		this->events.resize(64);
+	}
+
+	bool EpollWrapper::addSocket(SOCKET socketNew, TCPSSLClient* client) noexcept {
+		epoll_event event{ .events = EPOLLIN | EPOLLRDHUP | EPOLLET, .data = { .ptr = client } };
+		if (client->outputBuffer.getUsedSpace() > 0) {
+			event.events |= EPOLLOUT;
+		}
+		if (epoll_ctl(this->epollFd, EPOLL_CTL_ADD, socketNew, &event) == SOCKET_ERROR) {
+			if (errno != EEXIST || epoll_ctl(this->epollFd, EPOLL_CTL_MOD, socketNew, &event) == SOCKET_ERROR) {
+				return false;
+			}
+		} else {
+			++this->socketCount;
+		}
+		client->areWeWatchingForWrites = event.events & EPOLLOUT;
+		this->wakeUp();
+		return true;
+	}
+
+	bool EpollWrapper::modifySocket(SOCKET socketNew, TCPSSLClient* client, bool doWeWatchForWrites) noexcept {
+		epoll_event event{ .events = EPOLLIN | EPOLLRDHUP | EPOLLET, .data = { .ptr = client } };
+		if (doWeWatchForWrites) {
+			event.events |= EPOLLOUT;
+		}
+		return epoll_ctl(this->epollFd, EPOLL_CTL_MOD, socketNew, &event) != SOCKET_ERROR;
+	}
+
+	void EpollWrapper::removeSocket(SOCKET socketNew, TCPSSLClient* client) noexcept {
+		if (socketNew != SOCKET_ERROR && epoll_ctl(this->epollFd, EPOLL_CTL_DEL, socketNew, nullptr) != SOCKET_ERROR) {
+			--this->socketCount;
+		}
+		std::unique_lock lock{ this->accessMutex };
+		this->pendingReads.erase(client);
+	}
+
+	uint32_t EpollWrapper::getSocketCount() noexcept {
+		return this->socketCount.load();
+	}
+
+	int32_t EpollWrapper::wait(int32_t msToWait) noexcept {
+		std::unique_lock lock{ this->accessMutex };
+		if (this->pendingReads.size() > 0) {
+			msToWait = 0;
+		}
+		lock.unlock();
+		auto returnValue = epoll_wait(this->epollFd, this->events.data(), static_cast<int32_t>(this->events.size()), msToWait);
+		if (returnValue == static_cast<int32_t>(this->events.size())) {
+			this->events.resize(this->events.size() * 2);
+		}
+		return returnValue;
+	}
+
+	void EpollWrapper::wakeUp() noexcept {
+		uint64_t value{ 1 };
+		[[maybe_unused]] auto returnValue = write(this->wakeFd, &value, sizeof(value));
+	}
+
+	EpollWrapper::~EpollWrapper() noexcept {
+		if (this->wakeFd != SOCKET_ERROR) {
+			::close(this->wakeFd);
+		}
+		if (this->epollFd != SOCKET_ERROR) {
+			::close(this->epollFd);
+		}
+	}
+#endif
+
+#if defined(__linux__) && defined(DCA_IO_URING)
+	bool IoUringWrapper::initialize(uint32_t slotCountNew) noexcept {
+		io_uring_params params{};
+		uint32_t entryCount{ std::bit_ceil(std::max(slotCountNew * 4, 64u)) };
+		if (this->ringFd = static_cast<SOCKET>(syscall(__NR_io_uring_setup, entryCount, &params)); this->ringFd == SOCKET_ERROR) {
+			return false;
+		}
+		if (!(params.features & IORING_FEAT_SINGLE_MMAP) || !(params.features & IORING_FEAT_EXT_ARG)) {
+			::close(this->ringFd);
+			this->ringFd = SOCKET_ERROR;
+			return false;
+		}
+		this->ringSize = std::max(params.sq_off.array + params.sq_entries * sizeof(uint32_t), params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+		this->ring = mmap(nullptr, this->ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->ringFd, IORING_OFF_SQ_RING);
+		this->sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+		auto sqesNew = mmap(nullptr, this->sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, this->ringFd, IORING_OFF_SQES);
+		if (this->ring == MAP_FAILED || sqesNew == MAP_FAILED) {
+			if (this->ring != MAP_FAILED) {
+				munmap(this->ring, this->ringSize);
+			}
+			if (sqesNew != MAP_FAILED) {
+				munmap(sqesNew, this->sqesSize);
+			}
+			this->ring = nullptr;
+			::close(this->ringFd);
+			this->ringFd = SOCKET_ERROR;
+			return false;
+		}
+		auto ringBytes = static_cast<char*>(this->ring);
+		this->sqes = static_cast<io_uring_sqe*>(sqesNew);
+		this->sqHead = reinterpret_cast<uint32_t*>(ringBytes + params.sq_off.head);
+		this->sqTail = reinterpret_cast<uint32_t*>(ringBytes + params.sq_off.tail);
+		this->sqMask = *reinterpret_cast<uint32_t*>(ringBytes + params.sq_off.ring_mask);
+		this->sqArray = reinterpret_cast<uint32_t*>(ringBytes + params.sq_off.array);
+		this->cqHead = reinterpret_cast<uint32_t*>(ringBytes + params.cq_off.head);
+		this->cqTail = reinterpret_cast<uint32_t*>(ringBytes + params.cq_off.tail);
+		this->cqMask = *reinterpret_cast<uint32_t*>(ringBytes + params.cq_off.ring_mask);
+		this->cqes = reinterpret_cast<io_uring_cqe*>(ringBytes + params.cq_off.cqes);
+		this->sqEntries = params.sq_entries;
+
+		this->slots.resize(slotCountNew);
+		this->buffers = std::make_unique<char[]>(slotCountNew * 2 * IoUringWrapper::bufferSize);
+		std::vector<iovec> iovecs{};
+		for (uint32_t x = 0; x < slotCountNew * 2; ++x) {
+			iovecs.emplace_back(iovec{ .iov_base = this->buffers.get() + x * IoUringWrapper::bufferSize, .iov_len = IoUringWrapper::bufferSize });
+		}
+		if (syscall(__NR_io_uring_register, this->ringFd, IORING_REGISTER_BUFFERS, iovecs.data(), static_cast<uint32_t>(iovecs.size())) ==
+			SOCKET_ERROR) {
+			munmap(this->sqes, this->sqesSize);
+			munmap(this->ring, this->ringSize);
+			this->ring = nullptr;
+			::close(this->ringFd);
+			this->ringFd = SOCKET_ERROR;
+			return false;
+		}
+		return true;
+	}
+
+	bool IoUringWrapper::addSocket(TCPSSLClient* client) noexcept {
+		std::unique_lock lock{ this->accessMutex };
+		for (uint32_t x = 0; x < this->slots.size(); ++x) {
+			if (!this->slots[x].client && this->slots[x].opsInFlight == 0) {
+				this->slots[x] = Slot{ .client = client };
+				client->ioUringSlot = x;
+				return this->submitRead(x) && this->submit() != SOCKET_ERROR;
+			}
+		}
+		return false;
+	}
+
+	void IoUringWrapper::removeSocket(TCPSSLClient* client) noexcept {
+		std::unique_lock lock{ this->accessMutex };
+		this->pendingReads.erase(client);
+		auto& slot = this->slots[client->ioUringSlot];
+		if (slot.client != client) {
+			return;
+		}
+		slot.client = nullptr;
+		// The slot is only reused once the kernel has handed back both of its buffers.
+		if (slot.opsInFlight > 0) {
+			io_uring_sqe sqe{};
+			sqe.opcode = IORING_OP_ASYNC_CANCEL;
+			sqe.fd = -1;
+			sqe.addr = (static_cast<uint64_t>(client->ioUringSlot) << 2) | std::to_underlying(OpType::Read);
+			sqe.user_data = std::to_underlying(OpType::Cancel);
+			if (this->pushSqe(sqe)) {
+				this->submit();
+			}
+		}
+	}
+
+	bool IoUringWrapper::submitWrite(TCPSSLClient* client) noexcept {
+		std::unique_lock lock{ this->accessMutex };
+		auto& slot = this->slots[client->ioUringSlot];
+		if (slot.client != client || slot.isWriteInFlight) {
+			return true;
+		}
+		if (!this->fillWriteBuffer(client->ioUringSlot)) {
+			return true;
+		}
+		// Writes go out straight away, since they may come from threads other than the one waiting on the ring.
+		return this->submit() != SOCKET_ERROR;
+	}
+
+	int32_t IoUringWrapper::wait(int32_t msToWait) noexcept {
+		std::unique_lock lock{ this->accessMutex };
+		if (this->pendingReads.size() > 0) {
+			msToWait = 0;
+		}
+		// Anything queued since the last wait, such as re-armed reads, goes out with this same call. The count has to be exact, because the
+		// kernel skips the wait whenever it submits fewer entries than it was asked to.
+		auto toSubmit = std::exchange(this->pendingSqes, 0);
+		lock.unlock();
+		auto returnValue = this->enter(toSubmit, msToWait > 0 ? 1 : 0, IORING_ENTER_GETEVENTS, msToWait);
+		auto errorValue = errno;
+		if (static_cast<uint32_t>(std::max(returnValue, 0)) < toSubmit) {
+			lock.lock();
+			this->pendingSqes += toSubmit - static_cast<uint32_t>(std::max(returnValue, 0));
+			lock.unlock();
+		}
+		if (returnValue == SOCKET_ERROR && errorValue != ETIME && errorValue != EINTR) {
+			return SOCKET_ERROR;
+		}
+		this->events.clear();
+		auto head = *this->cqHead;
+		auto tail = std::atomic_ref{ *this->cqTail }.load(std::memory_order_acquire);
+		for (; head != tail; ++head) {
+			this->events.emplace_back(this->cqes[head & this->cqMask]);
+		}
+		std::atomic_ref{ *this->cqHead }.store(head, std::memory_order_release);
+		return static_cast<int32_t>(this->events.size());
+	}
+
+	bool IoUringWrapper::isItAvailable() noexcept {
+		return this->ringFd != SOCKET_ERROR;
+	}
+
+	void IoUringWrapper::wakeUp() noexcept {
+		std::unique_lock lock{ this->accessMutex };
+		io_uring_sqe sqe{};
+		sqe.opcode = IORING_OP_NOP;
+		sqe.user_data = std::to_underlying(OpType::Wake);
+		if (this->pushSqe(sqe)) {
+			this->submit();
+		}
+	}
+
+	bool IoUringWrapper::pushSqe(const io_uring_sqe& sqe) noexcept {
+		auto head = std::atomic_ref{ *this->sqHead }.load(std::memory_order_acquire);
+		auto tail = *this->sqTail;
+		if (tail - head >= this->sqEntries) {
+			if (this->submit() == SOCKET_ERROR) {
+				return false;
+			}
+			head = std::atomic_ref{ *this->sqHead }.load(std::memory_order_acquire);
+			if (tail - head >= this->sqEntries) {
+				return false;
+			}
+		}
+		// The entry is only published once it is complete, since a wait on another thread may submit it at any moment.
+		this->sqes[tail & this->sqMask] = sqe;
+		this->sqArray[tail & this->sqMask] = tail & this->sqMask;
+		std::atomic_ref{ *this->sqTail }.store(tail + 1, std::memory_order_release);
+		++this->pendingSqes;
+		return true;
+	}
+
+	int32_t IoUringWrapper::submit() noexcept {
+		auto toSubmit = std::exchange(this->pendingSqes, 0);
+		if (toSubmit == 0) {
+			return 0;
+		}
+		auto returnValue = this->enter(toSubmit, 0, 0, 0);
+		this->pendingSqes += toSubmit - static_cast<uint32_t>(std::max(returnValue, 0));
+		return returnValue;
+	}
+
+	bool IoUringWrapper::submitRead(uint32_t slotIndex) noexcept {
+		io_uring_sqe sqe{};
+		sqe.opcode = IORING_OP_READ_FIXED;
+		sqe.fd = static_cast<SOCKET>(this->slots[slotIndex].client->socket);
+		sqe.addr = reinterpret_cast<uint64_t>(this->getReadBuffer(slotIndex));
+		sqe.len = IoUringWrapper::bufferSize;
+		sqe.buf_index = static_cast<uint16_t>(slotIndex * 2);
+		sqe.user_data = (static_cast<uint64_t>(slotIndex) << 2) | std::to_underlying(OpType::Read);
+		if (!this->pushSqe(sqe)) {
+			return false;
+		}
+		++this->slots[slotIndex].opsInFlight;
+		return true;
+	}
+
+	bool IoUringWrapper::fillWriteBuffer(uint32_t slotIndex) noexcept {
+		auto& slot = this->slots[slotIndex];
+		if (slot.bytesWritten == slot.bytesToWrite) {
+			auto bytesRead = BIO_read(SSL_get_wbio(slot.client->ssl), this->getWriteBuffer(slotIndex), IoUringWrapper::bufferSize);
+			if (bytesRead <= 0) {
+				return false;
+			}
+			slot.bytesToWrite = static_cast<uint64_t>(bytesRead);
+			slot.bytesWritten = 0;
+		}
+		io_uring_sqe sqe{};
+		sqe.opcode = IORING_OP_WRITE_FIXED;
+		sqe.fd = static_cast<SOCKET>(slot.client->socket);
+		sqe.addr = reinterpret_cast<uint64_t>(this->getWriteBuffer(slotIndex) + slot.bytesWritten);
+		sqe.len = static_cast<uint32_t>(slot.bytesToWrite - slot.bytesWritten);
+		sqe.buf_index = static_cast<uint16_t>(slotIndex * 2 + 1);
+		sqe.user_data = (static_cast<uint64_t>(slotIndex) << 2) | std::to_underlying(OpType::Write);
+		if (!this->pushSqe(sqe)) {
+			return false;
+		}
+		++slot.opsInFlight;
+		slot.isWriteInFlight = true;
+		return true;
+	}
+
+	int32_t IoUringWrapper::enter(uint32_t toSubmit, uint32_t minComplete, uint32_t flags, int32_t msToWait) noexcept {
+		__kernel_timespec timeout{};
+		timeout.tv_sec = msToWait / 1000;
+		timeout.tv_nsec = (msToWait % 1000) * 1000000ll;
+		io_uring_getevents_arg argument{};
+		argument.ts = reinterpret_cast<uint64_t>(&timeout);
+		if (flags & IORING_ENTER_GETEVENTS) {
+			flags |= IORING_ENTER_EXT_ARG;
+		}
+		return static_cast<int32_t>(syscall(__NR_io_uring_enter, this->ringFd, toSubmit, minComplete, flags,
+			flags & IORING_ENTER_EXT_ARG ? &argument : nullptr, sizeof(argument)));
+	}
+
+	char* IoUringWrapper::getReadBuffer(uint32_t slotIndex) noexcept {
+		return this->buffers.get() + (slotIndex * 2) * IoUringWrapper::bufferSize;
+	}
+
+	char* IoUringWrapper::getWriteBuffer(uint32_t slotIndex) noexcept {
+		return this->buffers.get() + (slotIndex * 2 + 1) * IoUringWrapper::bufferSize;
+	}
+
+	IoUringWrapper::~IoUringWrapper() noexcept {
+		if (this->ring) {
+			munmap(this->sqes, this->sqesSize);
+			munmap(this->ring, this->ringSize);
+		}
+		if (this->ringFd != SOCKET_ERROR) {
+			::close(this->ringFd);
+		}
+	}
+#endif
+
+	bool SSLConnectionInterface::initialize(bool doWeUseKernelTls) noexcept {
 		if (SSLConnectionInterface::context = SSL_CTX_new(TLS_client_method()); !SSLConnectionInterface::context) {
 			return false;
 		}
@@ -179,9 +585,50 @@ namespace DiscordCoreInternal {
 			return false;
 		}
 #endif
+
+		// Sessions are kept per host:port by storeSession(), rather than in OpenSSL's internal cache, which servers' tickets bypass anyway.
+		SSL_CTX_set_session_cache_mode(SSLConnectionInterface::context, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+		SSL_CTX_sess_set_new_cb(SSLConnectionInterface::context, &SSLConnectionInterface::storeSession);
+
+#ifdef SSL_OP_ENABLE_KTLS
+		if (doWeUseKernelTls) {
+			SSL_CTX_set_options(SSLConnectionInterface::context, SSL_OP_ENABLE_KTLS);
+		}
+#endif
 		return true;
 	}
 
+	DiscordCoreAPI::TlsSessionCacheData SSLConnectionInterface::getSessionCacheData() noexcept {
+		return { .hits = SSLConnectionInterface::sessionCacheHits.load(), .misses = SSLConnectionInterface::sessionCacheMisses.load() };
+	}
+
+	int32_t SSLConnectionInterface::storeSession(SSL* ssl, SSL_SESSION* session) noexcept {
+		auto connection = static_cast<SSLConnectionInterface*>(SSL_get_app_data(ssl));
+		if (!connection || connection->sessionCacheKey == "") {
+			return 0;
+		}
+		std::unique_lock lock{ SSLConnectionInterface::sessionCacheMutex };
+		auto& value = SSLConnectionInterface::sessionCache[connection->sessionCacheKey];
+		if (value) {
+			SSL_SESSION_free(value);
+		}
+		value = session;
+		return 1;
+	}
+
+	void SSLConnectionInterface::loadSession() noexcept {
+		SSL_set_app_data(this->ssl, this);
+		std::unique_lock lock{ SSLConnectionInterface::sessionCacheMutex };
+		if (auto iterator = SSLConnectionInterface::sessionCache.find(this->sessionCacheKey); iterator != SSLConnectionInterface::sessionCache.end()) {
+			if (SSL_SESSION_is_resumable(iterator->second)) {
+				SSL_set_session(this->ssl, iterator->second);
+			} else {
+				SSL_SESSION_free(iterator->second);
+				SSLConnectionInterface::sessionCache.erase(iterator);
+			}
+		}
+	}
+
 	bool TCPSSLClient::connect(const std::string& baseUrl, const uint16_t portNew, bool doWePrintErrorsNew, bool areWeAStandaloneSocketNew) noexcept {
 		this->areWeAStandaloneSocket = areWeAStandaloneSocketNew;
 		this->doWePrintErrorMessages = doWePrintErrorsNew;
@@ -198,14 +645,10 @@ namespace DiscordCoreInternal {
 		} else {
 			addressString = baseUrl;
 		}
-		addrinfoWrapper hints{}, address{};
-		hints->ai_family = AF_INET;
-		hints->ai_socktype = SOCK_STREAM;
-		hints->ai_protocol = IPPROTO_TCP;
-
-		if (getaddrinfo(addressString.c_str(), std::to_string(portNew).c_str(), hints, address)) {
+		addrinfoWrapper address{};
+		if (!DnsResolver::resolve(addressString, portNew, SOCK_STREAM, address)) {
 			if (this->doWePrintErrorMessages) {
-				cout << reportError("TCPSSLClient::connect::getaddrinfo(), to: " + baseUrl) << endl;
+				cout << reportError("TCPSSLClient::connect::DnsResolver::resolve(), to: " + baseUrl) << endl;
 			}
 			return false;
 		}
@@ -263,6 +706,9 @@ namespace DiscordCoreInternal {
 			return false;
 		}
 
+		this->sessionCacheKey = addressString + ":" + std::to_string(portNew);
+		this->loadSession();
+
 		if (auto result{ SSL_connect(this->ssl) }; result != 1) {
 			if (this->doWePrintErrorMessages) {
 				cout << reportSSLError("TCPSSLClient::connect::SSL_connect(), to: " + baseUrl, result, this->ssl) << endl;
@@ -270,6 +716,12 @@ namespace DiscordCoreInternal {
 			return false;
 		}
 
+		if (SSL_session_reused(this->ssl)) {
+			++SSLConnectionInterface::sessionCacheHits;
+		} else {
+			++SSLConnectionInterface::sessionCacheMisses;
+		}
+
 #ifdef _WIN32
 		u_long value02{ 1 };
 		if (auto returnValue{ ioctlsocket(this->socket, FIONBIO, &value02) }; returnValue == SOCKET_ERROR) {
@@ -346,15 +798,232 @@ namespace DiscordCoreInternal {
 		return returnValue;
 	}
 
+#ifdef __linux__
+	std::vector<TCPSSLClient*> TCPSSLClient::processIO(EpollWrapper& epoll, int32_t msToWait, std::unique_lock<std::mutex>* lockToRelease) noexcept {
+		std::vector<TCPSSLClient*> returnValue{};
+		if (lockToRelease) {
+			lockToRelease->unlock();
+		}
+		auto eventCount = epoll.wait(msToWait);
+		if (lockToRelease) {
+			lockToRelease->lock();
+		}
+		if (eventCount == SOCKET_ERROR && errno != EINTR) {
+			return returnValue;
+		}
+		std::unordered_map<TCPSSLClient*, uint32_t> readyClients{};
+		std::unique_lock lock{ epoll.accessMutex };
+		for (auto& value: epoll.pendingReads) {
+			readyClients[value] |= EPOLLIN;
+		}
+		epoll.pendingReads.clear();
+		lock.unlock();
+		for (int32_t x = 0; x < eventCount; ++x) {
+			if (!epoll.events[x].data.ptr) {
+				uint64_t value{};
+				[[maybe_unused]] auto result = read(epoll.wakeFd, &value, sizeof(value));
+				continue;
+			}
+			readyClients[static_cast<TCPSSLClient*>(epoll.events[x].data.ptr)] |= epoll.events[x].events;
+		}
+		for (auto& [key, value]: readyClients) {
+			if (!key->areWeStillConnected()) {
+				continue;
+			}
+			if (value & EPOLLERR || value & EPOLLHUP) {
+				returnValue.emplace_back(key);
+				continue;
+			}
+			if (value & EPOLLOUT) {
+				auto usedSpace = key->outputBuffer.getUsedSpace();
+				while (usedSpace > 0) {
+					if (!key->processWriteData()) {
+						break;
+					}
+					if (key->outputBuffer.getUsedSpace() == usedSpace) {
+						break;
+					}
+					usedSpace = key->outputBuffer.getUsedSpace();
+				}
+				if (!key->areWeStillConnected()) {
+					returnValue.emplace_back(key);
+					continue;
+				}
+			}
+			if (value & EPOLLIN || value & EPOLLRDHUP) {
+				if (!key->processReadData()) {
+					returnValue.emplace_back(key);
+					continue;
+				}
+				if (key->inputBuffer.isItFull() || SSL_pending(key->ssl)) {
+					lock.lock();
+					epoll.pendingReads.emplace(key);
+					lock.unlock();
+				}
+			}
+		}
+		return returnValue;
+	}
+
+	void TCPSSLClient::setEpoll(EpollWrapper* epollNew) noexcept {
+		this->epoll = epollNew;
+		this->areWeWatchingForWrites = false;
+		if (this->epoll && this->areWeStillConnected()) {
+			this->epoll->addSocket(this->socket, this);
+			// A connection moved over from another agent may hold decrypted bytes that no readiness event will announce.
+			if (SSL_pending(this->ssl) || this->inputBuffer.isItFull()) {
+				std::unique_lock lock{ this->epoll->accessMutex };
+				this->epoll->pendingReads.emplace(this);
+				lock.unlock();
+				this->epoll->wakeUp();
+			}
+		}
+	}
+#endif
+
+#if defined(__linux__) && defined(DCA_IO_URING)
+	std::vector<TCPSSLClient*> TCPSSLClient::processIO(IoUringWrapper& ioUring, int32_t msToWait,
+		std::unique_lock<std::mutex>* lockToRelease) noexcept {
+		std::vector<TCPSSLClient*> returnValue{};
+		if (lockToRelease) {
+			lockToRelease->unlock();
+		}
+		auto eventCount = ioUring.wait(msToWait);
+		if (lockToRelease) {
+			lockToRelease->lock();
+		}
+		if (eventCount == SOCKET_ERROR) {
+			return returnValue;
+		}
+		std::unordered_set<TCPSSLClient*> readyClients{};
+		std::unordered_set<TCPSSLClient*> erroredClients{};
+		std::unique_lock lock{ ioUring.accessMutex };
+		readyClients.swap(ioUring.pendingReads);
+		for (auto& value: ioUring.events) {
+			auto opType = static_cast<IoUringWrapper::OpType>(value.user_data & 3);
+			if (opType == IoUringWrapper::OpType::Wake || opType == IoUringWrapper::OpType::Cancel) {
+				continue;
+			}
+			auto slotIndex = static_cast<uint32_t>(value.user_data >> 2);
+			auto& slot = ioUring.slots[slotIndex];
+			--slot.opsInFlight;
+			if (opType == IoUringWrapper::OpType::Write) {
+				slot.isWriteInFlight = false;
+			}
+			if (!slot.client) {
+				continue;
+			}
+			if (value.res == -EAGAIN || value.res == -EINTR) {
+				if (opType == IoUringWrapper::OpType::Read) {
+					ioUring.submitRead(slotIndex);
+				} else {
+					ioUring.fillWriteBuffer(slotIndex);
+				}
+			} else if (value.res < 0 || (opType == IoUringWrapper::OpType::Read && value.res == 0)) {
+				erroredClients.emplace(slot.client);
+			} else if (opType == IoUringWrapper::OpType::Read) {
+				BIO_write(SSL_get_rbio(slot.client->ssl), ioUring.getReadBuffer(slotIndex), value.res);
+				readyClients.emplace(slot.client);
+				ioUring.submitRead(slotIndex);
+			} else {
+				slot.bytesWritten += static_cast<uint64_t>(value.res);
+				ioUring.fillWriteBuffer(slotIndex);
+			}
+		}
+		lock.unlock();
+		for (auto& value: erroredClients) {
+			readyClients.erase(value);
+			returnValue.emplace_back(value);
+		}
+		for (auto& value: readyClients) {
+			if (!value->areWeStillConnected()) {
+				continue;
+			}
+			if (!value->processReadData()) {
+				returnValue.emplace_back(value);
+				continue;
+			}
+			// Reading can leave TLS records of our own to send, such as a key update.
+			if (BIO_ctrl_pending(SSL_get_wbio(value->ssl)) > 0 && !ioUring.submitWrite(value)) {
+				returnValue.emplace_back(value);
+				continue;
+			}
+			if (value->inputBuffer.isItFull() || SSL_pending(value->ssl) || BIO_ctrl_pending(SSL_get_rbio(value->ssl)) > 0) {
+				lock.lock();
+				ioUring.pendingReads.emplace(value);
+				lock.unlock();
+			}
+		}
+		return returnValue;
+	}
+
+	bool TCPSSLClient::setIoUring(IoUringWrapper* ioUringNew) noexcept {
+		// Memory BIOs would bypass the kernel's record layer, so a kTLS connection stays on epoll.
+		if (!ioUringNew || !ioUringNew->isItAvailable() || !this->areWeStillConnected() || this->isKernelTlsSendActive() ||
+			this->isKernelTlsReceiveActive()) {
+			return false;
+		}
+		auto readBio = BIO_new(BIO_s_mem());
+		auto writeBio = BIO_new(BIO_s_mem());
+		if (!readBio || !writeBio) {
+			BIO_free(readBio);
+			BIO_free(writeBio);
+			return false;
+		}
+		// An empty read BIO has to mean "try again later", rather than EOF.
+		BIO_set_mem_eof_return(readBio, -1);
+		SSL_set_bio(this->ssl, readBio, writeBio);
+		this->ioUring = ioUringNew;
+		if (!this->ioUring->addSocket(this)) {
+			this->ioUring->removeSocket(this);
+			this->ioUring = nullptr;
+			SSL_set_fd(this->ssl, this->socket);
+			return false;
+		}
+		if (SSL_pending(this->ssl)) {
+			std::unique_lock lock{ this->ioUring->accessMutex };
+			this->ioUring->pendingReads.emplace(this);
+			lock.unlock();
+			this->ioUring->wakeUp();
+		}
+		return this->processWriteData();
+	}
+#endif
+
+	void TCPSSLClient::updateWriteInterest() noexcept {
+#if defined(__linux__) && defined(DCA_IO_URING)
+		if (this->ioUring) {
+			if (this->areWeStillConnected() && this->outputBuffer.getUsedSpace() > 0) {
+				this->processWriteData();
+			}
+			return;
+		}
+#endif
+#ifdef __linux__
+		if (this->epoll && this->areWeStillConnected()) {
+			bool doWeWatchForWrites{ this->outputBuffer.getUsedSpace() > 0 };
+			if (doWeWatchForWrites != this->areWeWatchingForWrites) {
+				if (this->epoll->modifySocket(this->socket, this, doWeWatchForWrites)) {
+					this->areWeWatchingForWrites = doWeWatchForWrites;
+				}
+			}
+		}
+#endif
+	}
+
+	void TCPSSLClient::makeRoomInOutputBuffer() noexcept {
+		if (this->outputBuffer.getFreeSpace() == 0) {
+			this->outputBuffer.getCurrentTail()->clear();
+			this->outputBuffer.modifyReadOrWritePosition(RingBufferAccessType::Read, 1);
+			++this->outputBufferDrops;
+		}
+	}
+
 	ProcessIOResult TCPSSLClient::writeData(std::string_view dataToWrite, bool priority) noexcept {
 		if (this->areWeStillConnected()) {
 			if (dataToWrite.size() > 0 && this->ssl) {
 				if (priority && dataToWrite.size() < this->maxBufferSize) {
-					this->outputBuffer.clear();
-					if (this->outputBuffer.getFreeSpace() == 0) {
-						this->outputBuffer.getCurrentTail()->clear();
-						this->outputBuffer.modifyReadOrWritePosition(RingBufferAccessType::Read, 1);
-					}
+					this->makeRoomInOutputBuffer();
 					std::copy(dataToWrite.data(), dataToWrite.data() + dataToWrite.size(), this->outputBuffer.getCurrentHead()->getCurrentHead());
 					this->outputBuffer.getCurrentHead()->modifyReadOrWritePosition(RingBufferAccessType::Write, dataToWrite.size());
 					this->outputBuffer.modifyReadOrWritePosition(RingBufferAccessType::Write, 1);
@@ -372,10 +1041,7 @@ namespace DiscordCoreInternal {
 							} else {
 								amountToCollect = dataToWrite.size();
 							}
-							if (this->outputBuffer.getFreeSpace() == 0) {
-								this->outputBuffer.getCurrentTail()->clear();
-								this->outputBuffer.modifyReadOrWritePosition(RingBufferAccessType::Read, 1);
-							}
+							this->makeRoomInOutputBuffer();
 							std::copy(dataToWrite.data() + amountCollected, dataToWrite.data() + amountCollected + amountToCollect,
 								this->outputBuffer.getCurrentHead()->getCurrentHead());
 							this->outputBuffer.getCurrentHead()->modifyReadOrWritePosition(RingBufferAccessType::Write, amountToCollect);
@@ -385,15 +1051,40 @@ namespace DiscordCoreInternal {
 							amountCollected += amountToCollect;
 						}
 					} else {
-						if (this->outputBuffer.getFreeSpace() == 0) {
-							this->outputBuffer.getCurrentTail()->clear();
-							this->outputBuffer.modifyReadOrWritePosition(RingBufferAccessType::Read, 1);
-						}
+						this->makeRoomInOutputBuffer();
 						std::copy(dataToWrite.data(), dataToWrite.data() + dataToWrite.size(), this->outputBuffer.getCurrentHead()->getCurrentHead());
 						this->outputBuffer.getCurrentHead()->modifyReadOrWritePosition(RingBufferAccessType::Write, dataToWrite.size());
 						this->outputBuffer.modifyReadOrWritePosition(RingBufferAccessType::Write, 1);
 					}
 				}
+				this->updateWriteInterest();
+			}
+			return ProcessIOResult::No_Error;
+		} else {
+			return ProcessIOResult::Error;
+		}
+	}
+
+	ProcessIOResult TCPSSLClient::writeData(std::string_view header, std::string_view dataToWrite, bool priority) noexcept {
+		if (header.size() + dataToWrite.size() >= this->maxBufferSize) {
+			std::string frame{};
+			frame.reserve(header.size() + dataToWrite.size());
+			frame.append(header);
+			frame.append(dataToWrite);
+			return this->writeData(frame, priority);
+		}
+		if (this->areWeStillConnected()) {
+			if (this->ssl) {
+				this->makeRoomInOutputBuffer();
+				std::copy(header.data(), header.data() + header.size(), this->outputBuffer.getCurrentHead()->getCurrentHead());
+				this->outputBuffer.getCurrentHead()->modifyReadOrWritePosition(RingBufferAccessType::Write, header.size());
+				std::copy(dataToWrite.data(), dataToWrite.data() + dataToWrite.size(), this->outputBuffer.getCurrentHead()->getCurrentHead());
+				this->outputBuffer.getCurrentHead()->modifyReadOrWritePosition(RingBufferAccessType::Write, dataToWrite.size());
+				this->outputBuffer.modifyReadOrWritePosition(RingBufferAccessType::Write, 1);
+				if (priority && !this->processWriteData()) {
+					return ProcessIOResult::Error;
+				}
+				this->updateWriteInterest();
 			}
 			return ProcessIOResult::No_Error;
 		} else {
@@ -459,6 +1150,25 @@ namespace DiscordCoreInternal {
 	}
 
 	bool TCPSSLClient::processWriteData() noexcept {
+#if defined(__linux__) && defined(DCA_IO_URING)
+		// On the ring, SSL_write only encrypts into the write BIO, so it never blocks and the whole queue can go at once.
+		if (this->ioUring) {
+			while (this->outputBuffer.getUsedSpace() > 0) {
+				uint64_t writtenBytes{};
+				auto returnValue{ SSL_write_ex(this->ssl, this->outputBuffer.getCurrentTail()->getCurrentTail(),
+					this->outputBuffer.getCurrentTail()->getUsedSpace(), &writtenBytes) };
+				if (returnValue != 1) {
+					if (this->doWePrintErrorMessages) {
+						cout << reportSSLError("TCPSSLClient::processWriteData()", SSL_get_error(this->ssl, returnValue), this->ssl) << endl;
+					}
+					return false;
+				}
+				this->outputBuffer.getCurrentTail()->clear();
+				this->outputBuffer.modifyReadOrWritePosition(RingBufferAccessType::Read, 1);
+			}
+			return this->ioUring->submitWrite(this);
+		}
+#endif
 		if (this->outputBuffer.getUsedSpace() > 0) {
 			uint64_t bytesToWrite{ this->outputBuffer.getCurrentTail()->getUsedSpace() };
 
@@ -476,6 +1186,7 @@ namespace DiscordCoreInternal {
 					if (writtenBytes > 0) {
 						this->outputBuffer.getCurrentTail()->clear();
 						this->outputBuffer.modifyReadOrWritePosition(RingBufferAccessType::Read, 1);
+						this->updateWriteInterest();
 					}
 					return true;
 				}
@@ -498,8 +1209,18 @@ namespace DiscordCoreInternal {
 
 	bool TCPSSLClient::processReadData() noexcept {
 		if (!this->inputBuffer.isItFull()) {
+#ifdef __linux__
+			// Edge-triggered sockets only signal once, so they have to be read until they would block.
+			bool doWeDrainTheSocket{ this->epoll != nullptr };
+	#ifdef DCA_IO_URING
+			doWeDrainTheSocket |= this->ioUring != nullptr;
+	#endif
+#else
+			bool doWeDrainTheSocket{};
+#endif
+			uint64_t readBytes{};
 			do {
-				uint64_t readBytes{};
+				readBytes = 0;
 				uint64_t bytesToRead{ this->maxBufferSize };
 				auto returnValue{ SSL_read_ex(this->ssl, this->inputBuffer.getCurrentHead()->getCurrentHead(), bytesToRead, &readBytes) };
 				auto errorValue{ SSL_get_error(this->ssl, returnValue) };
@@ -534,7 +1255,8 @@ namespace DiscordCoreInternal {
 						return false;
 					}
 				}
-			} while (this->areWeStillConnected() && SSL_pending(this->ssl) && !this->inputBuffer.isItFull());
+			} while (this->areWeStillConnected() && (SSL_pending(this->ssl) || (doWeDrainTheSocket && readBytes > 0)) &&
+				!this->inputBuffer.isItFull());
 		}
 		if (!this->areWeAStandaloneSocket) {
 			this->handleBuffer();
@@ -546,6 +1268,24 @@ namespace DiscordCoreInternal {
 		return this->bytesRead;
 	}
 
+	bool TCPSSLClient::isKernelTlsSendActive() noexcept {
+#ifdef SSL_OP_ENABLE_KTLS
+		if (this->areWeStillConnected()) {
+			return BIO_get_ktls_send(SSL_get_wbio(this->ssl));
+		}
+#endif
+		return false;
+	}
+
+	bool TCPSSLClient::isKernelTlsReceiveActive() noexcept {
+#ifdef SSL_OP_ENABLE_KTLS
+		if (this->areWeStillConnected()) {
+			return BIO_get_ktls_recv(SSL_get_rbio(this->ssl));
+		}
+#endif
+		return false;
+	}
+
 	UDPConnection::UDPConnection(DiscordCoreAPI::StreamType streamTypeNew, bool doWePrintErrorsNew) noexcept {
 		this->doWePrintErrors = doWePrintErrorsNew;
 		this->streamType = streamTypeNew;
@@ -592,9 +1332,9 @@ namespace DiscordCoreInternal {
 #endif
 
 		if (this->streamType == DiscordCoreAPI::StreamType::None) {
-			if (getaddrinfo(baseUrlNew.c_str(), std::to_string(portNew).c_str(), hints, this->address)) {
+			if (!DnsResolver::resolve(baseUrlNew, portNew, SOCK_DGRAM, this->address)) {
 				if (this->doWePrintErrors) {
-					cout << reportError("UDPConnection::connect::getaddrinfo(), to: " + baseUrlNew) << endl;
+					cout << reportError("UDPConnection::connect::DnsResolver::resolve(), to: " + baseUrlNew) << endl;
 				}
 				return false;
 			}
@@ -605,9 +1345,9 @@ namespace DiscordCoreInternal {
 				return false;
 			}
 		} else if (this->streamType == DiscordCoreAPI::StreamType::Client) {
-			if (getaddrinfo(baseUrlNew.c_str(), std::to_string(portNew).c_str(), hints, this->address)) {
+			if (!DnsResolver::resolve(baseUrlNew, portNew, SOCK_DGRAM, this->address)) {
 				if (this->doWePrintErrors) {
-					cout << reportError("UDPConnection::connect::getaddrinfo(), to: " + baseUrlNew) << endl;
+					cout << reportError("UDPConnection::connect::DnsResolver::resolve(), to: " + baseUrlNew) << endl;
 				}
 				return false;
 			}
@@ -814,6 +1554,15 @@ namespace DiscordCoreInternal {
 		this->inputBuffer.clear();
 	}
 
+	std::unordered_map<std::string, std::shared_ptr<DnsResolver::CacheEntry>> DnsResolver::cache{};
+	std::unordered_map<std::string, std::string> DnsResolver::hostOverrides{};
+	const Seconds DnsResolver::negativeTtl{ 5 };
+	std::mutex DnsResolver::accessMutex{};
+	Seconds DnsResolver::ttl{ 60 };
+	std::unordered_map<std::string, SSL_SESSION*> SSLConnectionInterface::sessionCache{};
+	std::atomic_uint64_t SSLConnectionInterface::sessionCacheMisses{};
+	std::atomic_uint64_t SSLConnectionInterface::sessionCacheHits{};
+	std::mutex SSLConnectionInterface::sessionCacheMutex{};
 	SSL_CTXWrapper SSLConnectionInterface::context{};
 	std::mutex SSLConnectionInterface::mutex{};
 }
\ No newline at end of file
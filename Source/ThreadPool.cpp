@@ -144,4 +144,46 @@ namespace DiscordCoreInternal {
 		}
 	}
 
+	SerialTaskPool::SerialTaskPool(uint32_t threadCountNew) {
+		this->threadCount = std::max(threadCountNew, 1u);
+		this->taskQueues = std::make_unique<TaskQueue[]>(this->threadCount);
+		for (uint32_t x = 0; x < this->threadCount; ++x) {
+			this->taskQueues[x].thread = std::jthread([=, this](std::stop_token token) {
+				this->threadFunction(token, this->taskQueues[x]);
+			});
+		}
+	}
+
+	void SerialTaskPool::submitTask(uint64_t key, std::function<void()> task) noexcept {
+		auto& taskQueue = this->taskQueues[key % this->threadCount];
+		std::unique_lock lock{ taskQueue.accessMutex };
+		taskQueue.tasks.emplace_back(std::move(task));
+		lock.unlock();
+		taskQueue.condVar.notify_one();
+	}
+
+	void SerialTaskPool::threadFunction(std::stop_token token, TaskQueue& taskQueue) {
+		while (!token.stop_requested()) {
+			std::unique_lock lock{ taskQueue.accessMutex };
+			if (!taskQueue.condVar.wait(lock, token, [&] {
+					return taskQueue.tasks.size() > 0;
+				})) {
+				return;
+			}
+			std::function<void()> task = std::move(taskQueue.tasks.front());
+			taskQueue.tasks.pop_front();
+			lock.unlock();
+			task();
+		}
+	}
+
+	SerialTaskPool::~SerialTaskPool() noexcept {
+		for (uint32_t x = 0; x < this->threadCount; ++x) {
+			this->taskQueues[x].thread.request_stop();
+			if (this->taskQueues[x].thread.joinable()) {
+				this->taskQueues[x].thread.join();
+			}
+		}
+	}
+
 }
\ No newline at end of file
@@ -116,40 +116,122 @@ namespace DiscordCoreAPI {
 		if (this->baseSocketAgent) {
 			std::string string{};
 			uint32_t shardId = (dataPackage.guildId.operator size_t() >> 22) % this->baseSocketAgent->configManager->getTotalShardCount();
-			uint32_t basesocketAgentIndex{ shardId % this->baseSocketAgent->configManager->getTotalShardCount() };
+			auto shard = this->baseSocketAgent->discordCoreClient->getShard(shardId);
+			if (!shard) {
+				return;
+			}
 			auto serializer = dataPackage.operator Jsonifier();
-			if (static_cast<DiscordCoreInternal::WebSocketOpCode>(
-					this->baseSocketAgent->discordCoreClient->baseSocketAgentsMap[basesocketAgentIndex]->shardMap[shardId]->dataOpCode) ==
-				DiscordCoreInternal::WebSocketOpCode::Op_Binary) {
+			if (static_cast<DiscordCoreInternal::WebSocketOpCode>(shard->dataOpCode) == DiscordCoreInternal::WebSocketOpCode::Op_Binary) {
 				serializer.refreshString(JsonifierSerializeType::Etf);
 			} else {
 				serializer.refreshString(JsonifierSerializeType::Json);
 			}
 			string = serializer.operator std::string();
-			this->baseSocketAgent->discordCoreClient->baseSocketAgentsMap[basesocketAgentIndex]->shardMap[shardId]->createHeader(string,
-				this->baseSocketAgent->discordCoreClient->baseSocketAgentsMap[basesocketAgentIndex]->shardMap[shardId].get()->dataOpCode);
-			this->baseSocketAgent->discordCoreClient->baseSocketAgentsMap[basesocketAgentIndex]->shardMap[shardId]->sendMessage(string, false);
+			shard->sendMessage(string, DiscordCoreInternal::SendLane::State_Update);
 		}
 	}
 
 	void BotUser::updatePresence(UpdatePresenceData& dataPackage) {
 		if (this->baseSocketAgent) {
 			std::string string{};
-			uint32_t shardId = 0;
-			uint32_t basesocketAgentIndex{};
+			auto shard = this->baseSocketAgent->discordCoreClient->getShard(this->baseSocketAgent->configManager->getStartingShard());
+			if (!shard) {
+				return;
+			}
 			auto serializer = dataPackage.operator Jsonifier();
-			if (static_cast<DiscordCoreInternal::WebSocketOpCode>(
-					this->baseSocketAgent->discordCoreClient->baseSocketAgentsMap[basesocketAgentIndex]->shardMap[shardId]->dataOpCode) ==
-				DiscordCoreInternal::WebSocketOpCode::Op_Binary) {
+			if (static_cast<DiscordCoreInternal::WebSocketOpCode>(shard->dataOpCode) == DiscordCoreInternal::WebSocketOpCode::Op_Binary) {
 				serializer.refreshString(JsonifierSerializeType::Etf);
 			} else {
 				serializer.refreshString(JsonifierSerializeType::Json);
 			}
 			string = serializer.operator std::string();
-			this->baseSocketAgent->discordCoreClient->baseSocketAgentsMap[basesocketAgentIndex]->shardMap[shardId]->createHeader(string,
-				this->baseSocketAgent->discordCoreClient->baseSocketAgentsMap[basesocketAgentIndex]->shardMap[shardId].get()->dataOpCode);
-			this->baseSocketAgent->discordCoreClient->baseSocketAgentsMap[basesocketAgentIndex]->shardMap[shardId]->sendMessage(string, false);
+			shard->sendMessage(string, DiscordCoreInternal::SendLane::State_Update);
+		}
+	}
+
+	CoRoutine<std::vector<GuildMembersProgressData>> BotUser::requestGuildMembersAsync(RequestGuildMembersData dataPackage) {
+		struct MemberRequest {
+			UnboundedMessageBlock<GuildMembersProgressData> buffer{};
+			DiscordCoreInternal::WebSocketClient* shard{ nullptr };
+			StopWatch<Milliseconds> stopWatch{ 0ms };
+			GuildMembersProgressData progress{};
+			std::string nonce{};
+		};
+		static std::atomic_uint64_t nonceCount{};
+		auto baseSocketAgentNew = this->baseSocketAgent;
+		co_await NewThreadAwaitable<std::vector<GuildMembersProgressData>>();
+		std::vector<GuildMembersProgressData> returnData{};
+		if (!baseSocketAgentNew) {
+			co_return returnData;
+		}
+		auto discordCoreClient = baseSocketAgentNew->discordCoreClient;
+		std::deque<Snowflake> guildIds{ dataPackage.guildIds.begin(), dataPackage.guildIds.end() };
+		std::vector<std::unique_ptr<MemberRequest>> requests{};
+		auto removeRequest = [&](MemberRequest& request) {
+			std::unique_lock lock{ request.shard->memberRequestMutex };
+			request.shard->memberRequestBuffersMap.erase(request.nonce);
+		};
+		while (guildIds.size() > 0 || requests.size() > 0) {
+			while (guildIds.size() > 0 && requests.size() < std::max(dataPackage.maxConcurrentRequests, 1u)) {
+				std::unique_ptr<MemberRequest> request{ std::make_unique<MemberRequest>() };
+				request->progress.guildId = guildIds.front();
+				guildIds.pop_front();
+				uint32_t shardId = (request->progress.guildId.operator size_t() >> 22) % discordCoreClient->configManager.getTotalShardCount();
+				request->shard = discordCoreClient->getShard(shardId);
+				if (!request->shard) {
+					returnData.emplace_back(request->progress);
+					continue;
+				}
+				request->nonce = std::to_string(nonceCount.fetch_add(1));
+				request->stopWatch = StopWatch<Milliseconds>{ Milliseconds{ dataPackage.chunkTimeoutInMs } };
+				{
+					std::unique_lock lock{ request->shard->memberRequestMutex };
+					request->shard->memberRequestBuffersMap[request->nonce] = &request->buffer;
+				}
+				Jsonifier serializer{};
+				serializer["op"] = 8;
+				serializer["d"]["guild_id"] = request->progress.guildId;
+				serializer["d"]["query"] = "";
+				serializer["d"]["limit"] = 0;
+				serializer["d"]["presences"] = dataPackage.includePresences;
+				serializer["d"]["nonce"] = request->nonce;
+				if (request->shard->dataOpCode == DiscordCoreInternal::WebSocketOpCode::Op_Binary) {
+					serializer.refreshString(JsonifierSerializeType::Etf);
+				} else {
+					serializer.refreshString(JsonifierSerializeType::Json);
+				}
+				std::string string = serializer.operator std::string();
+				if (!request->shard->sendMessage(string, DiscordCoreInternal::SendLane::Bulk)) {
+					removeRequest(*request);
+					returnData.emplace_back(request->progress);
+					continue;
+				}
+				requests.emplace_back(std::move(request));
+			}
+			for (auto iterator = requests.begin(); iterator != requests.end();) {
+				auto& request = **iterator;
+				GuildMembersProgressData chunkData{};
+				while (request.buffer.tryReceive(chunkData)) {
+					request.progress.membersReceived += chunkData.membersReceived;
+					request.progress.chunkCount = chunkData.chunkCount;
+					++request.progress.chunksReceived;
+					request.progress.isItComplete = request.progress.chunksReceived >= request.progress.chunkCount;
+					request.stopWatch.resetTimer();
+					if (dataPackage.onProgress) {
+						dataPackage.onProgress(request.progress);
+					}
+				}
+				if (request.progress.isItComplete || request.stopWatch.hasTimePassed()) {
+					removeRequest(request);
+					returnData.emplace_back(request.progress);
+					iterator = requests.erase(iterator);
+				} else {
+					++iterator;
+				}
+			}
+			std::this_thread::sleep_for(1ms);
 		}
+		co_return returnData;
 	}
 
 	BotUser::BotUser(UserData dataPackage, DiscordCoreInternal::BaseSocketAgent* baseSocketAgentNew) : User(dataPackage) {
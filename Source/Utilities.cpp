@@ -971,10 +971,66 @@ namespace DiscordCoreAPI {
 		return this->config.textFormat;
 	}
 
+	const GatewayCompression ConfigManager::getGatewayCompression() const {
+		return this->config.compression;
+	}
+
 	const GatewayIntents ConfigManager::getGatewayIntents() {
 		return this->config.intents;
 	}
 
+	const std::string ConfigManager::getSessionStorePath() const {
+		return this->config.sessionStorePath;
+	}
+
+	const bool ConfigManager::doWeUseKernelTls() const {
+		return this->config.enableKernelTls;
+	}
+
+	const std::unordered_map<std::string, std::string> ConfigManager::getHostOverrides() const {
+		return this->config.hostOverrides;
+	}
+
+	const Seconds ConfigManager::getDnsCacheTtl() const {
+		return this->config.dnsCacheTtl;
+	}
+
+	const uint64_t ConfigManager::getDispatchOffloadThreshold() const {
+		return this->config.dispatchOffloadThreshold;
+	}
+
+	const Milliseconds ConfigManager::getShardRebalanceInterval() const {
+		return this->config.shardRebalanceInterval;
+	}
+
+	const ClusterOptions ConfigManager::getClusterOptions() const {
+		return this->config.clusterOptions;
+	}
+
+	void ConfigManager::setTotalShardCount(uint32_t totalShardCountNew) {
+		this->config.shardOptions.totalNumberOfShards = totalShardCountNew;
+	}
+
+	const GatewayProxyOptions ConfigManager::getGatewayProxyOptions() const {
+		return this->config.gatewayProxyOptions;
+	}
+
+	void ConfigManager::setTextFormat(TextFormat textFormatNew) {
+		this->config.textFormat = textFormatNew;
+	}
+
+	const EventJournalOptions ConfigManager::getEventJournalOptions() const {
+		return this->config.eventJournalOptions;
+	}
+
+	const std::unordered_map<std::string, EventBudget> ConfigManager::getEventBudgets() const {
+		return this->config.eventBudgets;
+	}
+
+	const Milliseconds ConfigManager::getPresenceCoalesceWindow() const {
+		return this->config.presenceCoalesceWindow;
+	}
+
 	StringWrapper& StringWrapper::operator=(StringWrapper&& other) noexcept {
 		if (this != &other) {
 			this->ptr.reset(nullptr);
@@ -2135,33 +2191,39 @@ namespace DiscordCoreInternal {
 	}
 
 	std::string_view StringBuffer::operator[](LengthData size) {
-		std::string_view string{ this->string.data() + size.offSet, size.length };
+		std::string_view string{ this->string.data() + this->offset + size.offSet, size.length };
 		return string;
 	}
 
 	char StringBuffer::operator[](uint64_t index) {
-		return this->string[index];
+		return this->string[this->offset + index];
 	}
 
 	void StringBuffer::writeData(const char* ptr, uint64_t size) {
-		if (this->sizeValue + size > this->string.size()) {
-			this->string.resize(this->string.size() + size);
+		if (this->offset + this->sizeValue + size + paddingSize > this->string.size()) {
+			if (this->offset > 0) {
+				std::memmove(this->string.data(), this->string.data() + this->offset, this->sizeValue);
+				this->offset = 0;
+			}
+			if (this->sizeValue + size + paddingSize > this->string.size()) {
+				this->string.resize(std::max(this->string.size() * 2, this->sizeValue + size + paddingSize));
+			}
 		}
-		std::copy(ptr, ptr + size, this->string.data() + this->sizeValue);
+		std::copy(ptr, ptr + size, this->string.data() + this->offset + this->sizeValue);
 		this->sizeValue += size;
 	}
 
 	std::string::iterator StringBuffer::begin() {
-		return this->string.begin();
+		return this->string.begin() + this->offset;
 	}
 
 	std::string::iterator StringBuffer::end() {
-		return this->string.end();
+		return this->string.begin() + this->offset + this->sizeValue;
 	}
 
 	void StringBuffer::erase(uint64_t amount) {
-		std::copy(this->string.data() + amount, this->string.data() + this->sizeValue, this->string.data());
-		this->sizeValue = this->sizeValue - amount;
+		this->sizeValue -= amount;
+		this->offset = this->sizeValue == 0 ? 0 : this->offset + amount;
 	}
 
 	uint64_t StringBuffer::size() {
@@ -2169,10 +2231,11 @@ namespace DiscordCoreInternal {
 	}
 
 	char* StringBuffer::data() {
-		return this->string.data();
+		return this->string.data() + this->offset;
 	}
 
 	void StringBuffer::clear() {
 		this->sizeValue = 0;
+		this->offset = 0;
 	}
 }
@@ -243,8 +243,7 @@ namespace DiscordCoreAPI {
 			data["op"] = 3;
 			data.refreshString(JsonifierSerializeType::Json);
 			std::string string{ data.operator std::string() };
-			this->createHeader(string, this->dataOpCode);
-			if (!this->sendMessage(string, true)) {
+			if (!this->sendMessage(string, this->dataOpCode, true)) {
 				this->onClosed();
 				return;
 			}
@@ -254,11 +253,10 @@ namespace DiscordCoreAPI {
 	}
 
 	bool VoiceConnection::onMessageReceived(std::string_view data) noexcept {
-		std::string string{ data };
-		string.reserve(string.size() + simdjson::SIMDJSON_PADDING);
 		DiscordCoreInternal::WebSocketMessage message{};
 		simdjson::ondemand::value value{};
-		if (this->parser.iterate(string.data(), string.length(), string.capacity()).get(value) == simdjson::error_code::SUCCESS) {
+		if (this->parser.iterate(data.data(), data.size(), data.size() + DiscordCoreInternal::StringBuffer::paddingSize).get(value) ==
+			simdjson::error_code::SUCCESS) {
 			message = DiscordCoreInternal::WebSocketMessage{ value };
 		}
 
@@ -344,8 +342,7 @@ namespace DiscordCoreAPI {
 		auto serializer = data.operator Jsonifier();
 		serializer.refreshString(JsonifierSerializeType::Json);
 		std::string string{ serializer.operator std::string() };
-		this->createHeader(string, this->dataOpCode);
-		this->sendMessage(string, true);
+		this->sendMessage(string, this->dataOpCode, true);
 	}
 
 	void VoiceConnection::runVoice(std::stop_token token) noexcept {
@@ -674,8 +671,7 @@ namespace DiscordCoreAPI {
 				auto serializer = data.operator Jsonifier();
 				serializer.refreshString(JsonifierSerializeType::Json);
 				std::string string{ serializer.operator std::string() };
-				this->createHeader(string, this->dataOpCode);
-				if (!WebSocketCore::sendMessage(string, true)) {
+				if (!WebSocketCore::sendMessage(string, this->dataOpCode, true)) {
 					++this->currentReconnectTries;
 					this->onClosed();
 					return;
@@ -720,8 +716,7 @@ namespace DiscordCoreAPI {
 				auto serializer = data.operator Jsonifier();
 				serializer.refreshString(JsonifierSerializeType::Json);
 				std::string string{ serializer.operator std::string() };
-				this->createHeader(string, this->dataOpCode);
-				if (!WebSocketCore::sendMessage(string, true)) {
+				if (!WebSocketCore::sendMessage(string, this->dataOpCode, true)) {
 					++this->currentReconnectTries;
 					this->onClosed();
 					return;
@@ -27,6 +27,7 @@
 #include <discordcoreapi/EventManager.hpp>
 #include <discordcoreapi/DiscordCoreClient.hpp>
 #include <random>
+#include <bit>
 
 namespace DiscordCoreAPI {
 	namespace Globals {
@@ -43,154 +44,420 @@ namespace DiscordCoreInternal {
 	const uint8_t webSocketMaxPayloadLengthSmall{ 125u };
 	const uint8_t webSocketFinishBit{ (1u << 7u) };
 	const uint8_t webSocketMaskBit{ (1u << 7u) };
+	const uint8_t webSocketMaskKeySize{ 4u };
+	const Milliseconds clusterGrantPollInterval{ 25ms };
 
-	EventConverter::EventConverter(std::string newEvent) {
-		this->eventValue = newEvent;
-	}
-
-	EventConverter::operator int32_t() {
-		if (this->eventValue == "READY") {
-			return 1;
-		} else if (this->eventValue == "RESUMED") {
-			return 2;
-		} else if (this->eventValue == "APPLICATION_COMMAND_PERMISSIONS_UPDATE") {
-			return 3;
-		} else if (this->eventValue == "AUTO_MODERATION_RULE_CREATE") {
-			return 4;
-		} else if (this->eventValue == "AUTO_MODERATION_RULE_UPDATE") {
-			return 5;
-		} else if (this->eventValue == "AUTO_MODERATION_RULE_DELETE") {
-			return 6;
-		} else if (this->eventValue == "AUTO_MODERATION_ACTION_EXECUTION") {
-			return 7;
-		} else if (this->eventValue == "CHANNEL_CREATE") {
-			return 8;
-		} else if (this->eventValue == "CHANNEL_UPDATE") {
-			return 9;
-		} else if (this->eventValue == "CHANNEL_DELETE") {
-			return 10;
-		} else if (this->eventValue == "CHANNEL_PINS_UPDATE") {
-			return 11;
-		} else if (this->eventValue == "THREAD_CREATE") {
-			return 12;
-		} else if (this->eventValue == "THREAD_UPDATE") {
-			return 13;
-		} else if (this->eventValue == "THREAD_DELETE") {
-			return 14;
-		} else if (this->eventValue == "THREAD_LIST_SYNC") {
-			return 15;
-		} else if (this->eventValue == "THREAD_MEMBER_UPDATE") {
-			return 16;
-		} else if (this->eventValue == "THREAD_MEMBERS_UPDATE") {
-			return 17;
-		} else if (this->eventValue == "GUILD_CREATE") {
-			return 18;
-		} else if (this->eventValue == "GUILD_UPDATE") {
-			return 19;
-		} else if (this->eventValue == "GUILD_DELETE") {
-			return 20;
-		} else if (this->eventValue == "GUILD_BAN_ADD") {
-			return 21;
-		} else if (this->eventValue == "GUILD_BAN_REMOVE") {
-			return 22;
-		} else if (this->eventValue == "GUILD_EMOJIS_UPDATE") {
-			return 23;
-		} else if (this->eventValue == "GUILD_STICKERS_UPDATE") {
-			return 24;
-		} else if (this->eventValue == "GUILD_INTEGRATIONS_UPDATE") {
-			return 25;
-		} else if (this->eventValue == "GUILD_MEMBER_ADD") {
-			return 26;
-		} else if (this->eventValue == "GUILD_MEMBER_REMOVE") {
-			return 27;
-		} else if (this->eventValue == "GUILD_MEMBER_UPDATE") {
-			return 28;
-		} else if (this->eventValue == "GUILD_MEMBERS_CHUNK") {
-			return 29;
-		} else if (this->eventValue == "GUILD_ROLE_CREATE") {
-			return 30;
-		} else if (this->eventValue == "GUILD_ROLE_UPDATE") {
-			return 31;
-		} else if (this->eventValue == "GUILD_ROLE_DELETE") {
-			return 32;
-		} else if (this->eventValue == "GUILD_SCHEDULED_EVENT_CREATE") {
-			return 33;
-		} else if (this->eventValue == "GUILD_SCHEDULED_EVENT_UPDATE") {
-			return 34;
-		} else if (this->eventValue == "GUILD_SCHEDULED_EVENT_DELETE") {
-			return 35;
-		} else if (this->eventValue == "GUILD_SCHEDULED_EVENT_USER_ADD") {
-			return 36;
-		} else if (this->eventValue == "GUILD_SCHEDULED_EVENT_USER_REMOVE") {
-			return 37;
-		} else if (this->eventValue == "INTEGRATION_CREATE") {
-			return 38;
-		} else if (this->eventValue == "INTEGRATION_UPDATE") {
-			return 39;
-		} else if (this->eventValue == "INTEGRATION_DELETE") {
-			return 40;
-		} else if (this->eventValue == "INTERACTION_CREATE") {
-			return 41;
-		} else if (this->eventValue == "INVITE_CREATE") {
-			return 42;
-		} else if (this->eventValue == "INVITE_DELETE") {
-			return 43;
-		} else if (this->eventValue == "MESSAGE_CREATE") {
-			return 44;
-		} else if (this->eventValue == "MESSAGE_UPDATE") {
-			return 45;
-		} else if (this->eventValue == "MESSAGE_DELETE") {
-			return 46;
-		} else if (this->eventValue == "MESSAGE_DELETE_BULK") {
-			return 47;
-		} else if (this->eventValue == "MESSAGE_REACTION_ADD") {
-			return 48;
-		} else if (this->eventValue == "MESSAGE_REACTION_REMOVE") {
-			return 49;
-		} else if (this->eventValue == "MESSAGE_REACTION_REMOVE_ALL") {
-			return 50;
-		} else if (this->eventValue == "MESSAGE_REACTION_REMOVE_EMOJI") {
-			return 51;
-		} else if (this->eventValue == "PRESENCE_UPDATE") {
-			return 52;
-		} else if (this->eventValue == "STAGE_INSTANCE_CREATE") {
-			return 53;
-		} else if (this->eventValue == "STAGE_INSTANCE_UPDATE") {
-			return 54;
-		} else if (this->eventValue == "STAGE_INSTANCE_DELETE") {
-			return 55;
-		} else if (this->eventValue == "TYPING_START") {
-			return 56;
-		} else if (this->eventValue == "USER_UPDATE") {
-			return 57;
-		} else if (this->eventValue == "VOICE_STATE_UPDATE") {
-			return 58;
-		} else if (this->eventValue == "VOICE_SERVER_UPDATE") {
-			return 59;
-		} else if (this->eventValue == "WEBHOOKS_UPDATE") {
-			return 60;
+	static_assert(StringBuffer::paddingSize >= simdjson::SIMDJSON_PADDING, "Received frames must be parseable in place by simdjson.");
+	static_assert(WebSocketCore::maxFrameHeaderSize >= maxHeaderSize + webSocketMaskKeySize);
+
+	constexpr std::array<std::string_view, 60> eventNames{
+		"READY",
+		"RESUMED",
+		"APPLICATION_COMMAND_PERMISSIONS_UPDATE",
+		"AUTO_MODERATION_RULE_CREATE",
+		"AUTO_MODERATION_RULE_UPDATE",
+		"AUTO_MODERATION_RULE_DELETE",
+		"AUTO_MODERATION_ACTION_EXECUTION",
+		"CHANNEL_CREATE",
+		"CHANNEL_UPDATE",
+		"CHANNEL_DELETE",
+		"CHANNEL_PINS_UPDATE",
+		"THREAD_CREATE",
+		"THREAD_UPDATE",
+		"THREAD_DELETE",
+		"THREAD_LIST_SYNC",
+		"THREAD_MEMBER_UPDATE",
+		"THREAD_MEMBERS_UPDATE",
+		"GUILD_CREATE",
+		"GUILD_UPDATE",
+		"GUILD_DELETE",
+		"GUILD_BAN_ADD",
+		"GUILD_BAN_REMOVE",
+		"GUILD_EMOJIS_UPDATE",
+		"GUILD_STICKERS_UPDATE",
+		"GUILD_INTEGRATIONS_UPDATE",
+		"GUILD_MEMBER_ADD",
+		"GUILD_MEMBER_REMOVE",
+		"GUILD_MEMBER_UPDATE",
+		"GUILD_MEMBERS_CHUNK",
+		"GUILD_ROLE_CREATE",
+		"GUILD_ROLE_UPDATE",
+		"GUILD_ROLE_DELETE",
+		"GUILD_SCHEDULED_EVENT_CREATE",
+		"GUILD_SCHEDULED_EVENT_UPDATE",
+		"GUILD_SCHEDULED_EVENT_DELETE",
+		"GUILD_SCHEDULED_EVENT_USER_ADD",
+		"GUILD_SCHEDULED_EVENT_USER_REMOVE",
+		"INTEGRATION_CREATE",
+		"INTEGRATION_UPDATE",
+		"INTEGRATION_DELETE",
+		"INTERACTION_CREATE",
+		"INVITE_CREATE",
+		"INVITE_DELETE",
+		"MESSAGE_CREATE",
+		"MESSAGE_UPDATE",
+		"MESSAGE_DELETE",
+		"MESSAGE_DELETE_BULK",
+		"MESSAGE_REACTION_ADD",
+		"MESSAGE_REACTION_REMOVE",
+		"MESSAGE_REACTION_REMOVE_ALL",
+		"MESSAGE_REACTION_REMOVE_EMOJI",
+		"PRESENCE_UPDATE",
+		"STAGE_INSTANCE_CREATE",
+		"STAGE_INSTANCE_UPDATE",
+		"STAGE_INSTANCE_DELETE",
+		"TYPING_START",
+		"USER_UPDATE",
+		"VOICE_STATE_UPDATE",
+		"VOICE_SERVER_UPDATE",
+		"WEBHOOKS_UPDATE",
+	};
+
+	constexpr uint64_t eventNameHash(std::string_view eventName, uint64_t seed) noexcept {
+		uint64_t hash{ 14695981039346656037ull ^ seed };
+		for (auto& value: eventName) {
+			hash ^= static_cast<uint8_t>(value);
+			hash *= 1099511628211ull;
+		}
+		return hash ^ (hash >> 29);
+	}
+
+	template<size_t size> struct EventNameTable {
+		std::array<uint8_t, size> slots{};
+		uint64_t seed{};
+	};
+
+	/// Searches for a seed under which every event name lands in its own slot, so a lookup costs one hash and one comparison.
+	template<size_t size> constexpr EventNameTable<size> generateEventNameTable() noexcept {
+		EventNameTable<size> table{};
+		for (uint64_t seed = 0;; ++seed) {
+			table.slots.fill(0);
+			table.seed = seed;
+			bool didWeCollide{};
+			for (size_t x = 0; x < eventNames.size(); ++x) {
+				auto& slot = table.slots[eventNameHash(eventNames[x], seed) % size];
+				if (slot != 0) {
+					didWeCollide = true;
+					break;
+				}
+				slot = static_cast<uint8_t>(x + 1);
+			}
+			if (!didWeCollide) {
+				return table;
+			}
+		}
+	}
+
+	constexpr auto eventNameTable{ generateEventNameTable<256>() };
+
+	EventConverter::EventConverter(std::string_view newEvent) noexcept {
+		auto index = eventNameTable.slots[eventNameHash(newEvent, eventNameTable.seed) % eventNameTable.slots.size()];
+		if (index != 0 && eventNames[index - 1] == newEvent) {
+			this->eventValue = static_cast<GatewayEventType>(index);
+		}
+	}
+
+	EventConverter::operator GatewayEventType() const noexcept {
+		return this->eventValue;
+	}
+
+	bool ZlibDecompressor::initialize() noexcept {
+		if (this->haveWeInitialized) {
+			inflateEnd(&this->stream);
+		}
+		this->stream = z_stream{};
+		this->haveWeInitialized = inflateInit(&this->stream) == Z_OK;
+		this->areWeComplete = false;
+		this->outputSize = 0;
+		return this->haveWeInitialized;
+	}
+
+	bool ZlibDecompressor::decompress(std::string_view dataToDecompress) noexcept {
+		this->stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(dataToDecompress.data()));
+		this->stream.avail_in = static_cast<uInt>(dataToDecompress.size());
+		do {
+			if (this->outputBuffer.size() - this->outputSize < 1024 * 16) {
+				this->outputBuffer.resize(std::max(this->outputBuffer.size() * 2, this->outputSize + 1024 * 16));
+			}
+			this->stream.next_out = reinterpret_cast<Bytef*>(this->outputBuffer.data() + this->outputSize);
+			this->stream.avail_out = static_cast<uInt>(this->outputBuffer.size() - this->outputSize);
+			auto result = inflate(&this->stream, Z_SYNC_FLUSH);
+			this->outputSize = this->outputBuffer.size() - this->stream.avail_out;
+			if (result == Z_BUF_ERROR) {
+				break;
+			} else if (result != Z_OK) {
+				return false;
+			}
+		} while (this->stream.avail_in > 0 || this->stream.avail_out == 0);
+		if (this->outputBuffer.size() - this->outputSize < StringBuffer::paddingSize) {
+			this->outputBuffer.resize(this->outputSize + StringBuffer::paddingSize);
+		}
+		this->areWeComplete = dataToDecompress.ends_with(zlibSuffix);
+		return true;
+	}
+
+	std::string_view ZlibDecompressor::getDecompressedData() noexcept {
+		return std::string_view{ this->outputBuffer.data(), this->outputSize };
+	}
+
+	bool ZlibDecompressor::isItInitialized() noexcept {
+		return this->haveWeInitialized;
+	}
+
+	bool ZlibDecompressor::isItComplete() noexcept {
+		return this->areWeComplete;
+	}
+
+	void ZlibDecompressor::clearOutput() noexcept {
+		this->areWeComplete = false;
+		this->outputSize = 0;
+	}
+
+	ZlibDecompressor::~ZlibDecompressor() noexcept {
+		if (this->haveWeInitialized) {
+			inflateEnd(&this->stream);
+		}
+	}
+
+	TimerWheel::TimerWheel() noexcept {
+		this->startTime = std::chrono::steady_clock::now();
+	}
+
+	void TimerWheel::schedule(uint32_t shardId, TimerType type, uint64_t generation, Milliseconds delay) noexcept {
+		std::unique_lock lock{ this->accessMutex };
+		TimerEntry entry{};
+		entry.deadline = this->getCurrentTick() + static_cast<uint64_t>(std::max(delay.count(), static_cast<Milliseconds::rep>(0)));
+		entry.generation = generation;
+		entry.shardId = shardId;
+		entry.type = type;
+		this->insertEntry(std::move(entry));
+	}
+
+	Milliseconds TimerWheel::getTimeUntilNextDeadline(Milliseconds maxTimeToWait) noexcept {
+		std::unique_lock lock{ this->accessMutex };
+		if (this->dueEntries.size() > 0) {
+			return 0ms;
+		}
+		uint64_t nextTick{ this->getNextSlotTick() };
+		uint64_t tickNow{ this->getCurrentTick() };
+		if (nextTick <= tickNow) {
+			return 0ms;
+		} else if (nextTick - tickNow > static_cast<uint64_t>(maxTimeToWait.count())) {
+			return maxTimeToWait;
 		} else {
-			return 0;
+			return Milliseconds{ nextTick - tickNow };
+		}
+	}
+
+	std::vector<TimerEntry> TimerWheel::collectExpired() noexcept {
+		std::unique_lock lock{ this->accessMutex };
+		uint64_t tickNow{ this->getCurrentTick() };
+		for (uint64_t nextTick = this->getNextSlotTick(); nextTick <= tickNow; nextTick = this->getNextSlotTick()) {
+			this->currentTick = nextTick;
+			for (uint64_t x = levelCount; x-- > 0;) {
+				if (this->occupiedSlots[x] == 0) {
+					continue;
+				}
+				uint64_t shift{ x * slotBits };
+				uint64_t slot{ static_cast<uint64_t>(std::countr_zero(this->occupiedSlots[x])) };
+				if ((((this->currentTick >> (shift + slotBits)) << (shift + slotBits)) | (slot << shift)) != nextTick) {
+					continue;
+				}
+				std::vector<TimerEntry> entries = std::move(this->slots[x][slot]);
+				this->slots[x][slot].clear();
+				this->occupiedSlots[x] &= ~(1ull << slot);
+				for (auto& value: entries) {
+					this->insertEntry(std::move(value));
+				}
+			}
+			if ((this->currentTick & (wheelSpan - 1)) == 0) {
+				this->reinsertOverflow();
+			}
+		}
+		this->currentTick = std::max(this->currentTick, tickNow);
+		this->reinsertOverflow();
+		std::vector<TimerEntry> returnData = std::move(this->dueEntries);
+		this->dueEntries.clear();
+		return returnData;
+	}
+
+	uint64_t TimerWheel::getCurrentTick() noexcept {
+		return static_cast<uint64_t>(std::chrono::duration_cast<Milliseconds>(std::chrono::steady_clock::now() - this->startTime).count());
+	}
+
+	void TimerWheel::insertEntry(TimerEntry&& entry) noexcept {
+		if (entry.deadline <= this->currentTick) {
+			this->dueEntries.emplace_back(std::move(entry));
+			return;
+		}
+		// The highest bit on which the deadline and the current tick differ decides the level, and the deadline's digit on that level the slot.
+		uint64_t level{ static_cast<uint64_t>(std::bit_width(entry.deadline ^ this->currentTick) - 1) / slotBits };
+		if (level >= levelCount) {
+			this->overflowEntries.emplace_back(std::move(entry));
+			return;
+		}
+		uint64_t slot{ (entry.deadline >> (level * slotBits)) & (slotCount - 1) };
+		this->slots[level][slot].emplace_back(std::move(entry));
+		this->occupiedSlots[level] |= 1ull << slot;
+	}
+
+	void TimerWheel::reinsertOverflow() noexcept {
+		if (this->overflowEntries.size() > 0) {
+			std::vector<TimerEntry> entries = std::move(this->overflowEntries);
+			this->overflowEntries.clear();
+			for (auto& value: entries) {
+				this->insertEntry(std::move(value));
+			}
+		}
+	}
+
+	uint64_t TimerWheel::getNextSlotTick() noexcept {
+		// Every occupied slot lies ahead of the current tick's digit on its level, so the lowest one on each level is the next to come due.
+		// Overflowed timers get another look once the current tick crosses into the next span of the wheel.
+		uint64_t nextTick{ std::numeric_limits<uint64_t>::max() };
+		if (this->overflowEntries.size() > 0) {
+			nextTick = ((this->currentTick / wheelSpan) + 1) * wheelSpan;
+		}
+		for (uint64_t x = 0; x < levelCount; ++x) {
+			if (this->occupiedSlots[x] != 0) {
+				uint64_t shift{ x * slotBits };
+				uint64_t slot{ static_cast<uint64_t>(std::countr_zero(this->occupiedSlots[x])) };
+				nextTick = std::min(nextTick, ((this->currentTick >> (shift + slotBits)) << (shift + slotBits)) | (slot << shift));
+			}
+		}
+		return nextTick;
+	}
+
+	void LatencyHistogram::record(Nanoseconds value) noexcept {
+		uint64_t valueNew{ static_cast<uint64_t>(std::max(value.count(), static_cast<Nanoseconds::rep>(0))) };
+		std::unique_lock lock{ this->accessMutex };
+		this->rotateWindows();
+		++this->windows[0].counts[getBucketIndex(valueNew)];
+		++this->windows[0].sampleCount;
+		this->windows[0].maxValue = std::max(this->windows[0].maxValue, valueNew);
+	}
+
+	DiscordCoreAPI::LatencySummary LatencyHistogram::getSummary() noexcept {
+		std::unique_lock lock{ this->accessMutex };
+		this->rotateWindows();
+		DiscordCoreAPI::LatencySummary returnData{};
+		uint64_t maxValue{ std::max(this->windows[0].maxValue, this->windows[1].maxValue) };
+		returnData.sampleCount = this->windows[0].sampleCount + this->windows[1].sampleCount;
+		returnData.max = Nanoseconds{ maxValue };
+		if (returnData.sampleCount == 0) {
+			return returnData;
+		}
+		uint64_t p50Rank{ (returnData.sampleCount + 1) / 2 };
+		uint64_t p99Rank{ (returnData.sampleCount * 99 + 99) / 100 };
+		uint64_t currentRank{};
+		for (uint64_t x = 0; x < bucketCount; ++x) {
+			uint64_t previousRank{ currentRank };
+			currentRank += this->windows[0].counts[x] + this->windows[1].counts[x];
+			if (previousRank < p50Rank && currentRank >= p50Rank) {
+				returnData.p50 = Nanoseconds{ std::min(getBucketUpperBound(x), maxValue) };
+			}
+			if (previousRank < p99Rank && currentRank >= p99Rank) {
+				returnData.p99 = Nanoseconds{ std::min(getBucketUpperBound(x), maxValue) };
+				break;
+			}
+		}
+		return returnData;
+	}
+
+	uint64_t LatencyHistogram::getBucketIndex(uint64_t value) noexcept {
+		if (value < (1ull << subBucketBits)) {
+			return value;
+		}
+		// The top bit picks the power of two, and the bits below it the sub-bucket.
+		uint64_t exponent{ static_cast<uint64_t>(std::bit_width(value)) - 1 };
+		uint64_t subBucket{ (value >> (exponent - subBucketBits)) & ((1ull << subBucketBits) - 1) };
+		return ((exponent - subBucketBits + 1) << subBucketBits) | subBucket;
+	}
+
+	uint64_t LatencyHistogram::getBucketUpperBound(uint64_t index) noexcept {
+		if (index < (1ull << subBucketBits)) {
+			return index;
+		}
+		uint64_t exponent{ (index >> subBucketBits) + subBucketBits - 1 };
+		uint64_t subBucket{ index & ((1ull << subBucketBits) - 1) };
+		uint64_t bucketWidth{ 1ull << (exponent - subBucketBits) };
+		return (((1ull << subBucketBits) + subBucket) * bucketWidth) + (bucketWidth - 1);
+	}
+
+	void LatencyHistogram::rotateWindows() noexcept {
+		auto timeElapsed = std::chrono::steady_clock::now() - this->windowStart;
+		if (timeElapsed >= windowLength * 2) {
+			this->windows = {};
+			this->windowStart = std::chrono::steady_clock::now();
+		} else if (timeElapsed >= windowLength) {
+			this->windows[1] = this->windows[0];
+			this->windows[0] = {};
+			this->windowStart += windowLength;
+		}
+	}
+
+	void EventBudgetState::flushHeldEvent() noexcept {
+		std::unique_lock lock{ this->heldEventMutex };
+		std::function<void()> heldEventNew{ std::move(this->heldEvent) };
+		this->heldEvent = nullptr;
+		lock.unlock();
+		if (heldEventNew) {
+			try {
+				heldEventNew();
+			} catch (...) {
+				DiscordCoreAPI::reportException("EventBudgetState::flushHeldEvent()");
+			}
 		}
 	}
 
+	bool EventBudgetState::tryTakeToken() noexcept {
+		this->refillTokens();
+		if (this->tokens < 1.0) {
+			return false;
+		}
+		this->tokens -= 1.0;
+		return true;
+	}
+
+	Milliseconds EventBudgetState::getTimeUntilNextToken() noexcept {
+		this->refillTokens();
+		double secondsUntilNextToken{ std::max(1.0 - this->tokens, 0.0) / static_cast<double>(this->budget.maxEventsPerSecond) };
+		return Milliseconds{ static_cast<int64_t>(std::ceil(secondsUntilNextToken * 1000.0)) };
+	}
+
+	void EventBudgetState::refillTokens() noexcept {
+		auto currentTime = std::chrono::steady_clock::now();
+		double secondsElapsed{ std::chrono::duration<double>(currentTime - this->lastRefill).count() };
+		double maxTokens{ static_cast<double>(this->budget.maxEventsPerSecond) };
+		this->tokens = std::min(this->tokens + secondsElapsed * maxTokens, maxTokens);
+		this->lastRefill = currentTime;
+	}
+
 	WebSocketCore::WebSocketCore(DiscordCoreAPI::ConfigManager* configManagerNew, WebSocketType typeOfWebSocketNew) {
 		this->wsType = typeOfWebSocketNew;
 		this->configManager = configManagerNew;
 	}
 
-	bool WebSocketCore::connect(const std::string& baseUrl, const std::string& relativePath, const uint16_t portNew, bool doWePrintErrorsNew,
-		bool areWeAStandaloneSocketNew) noexcept {
-		TCPSSLClient::connect(baseUrl, portNew, doWePrintErrorsNew, areWeAStandaloneSocket);
-		DiscordCoreAPI::StopWatch stopWatch{ 5s };
+	bool WebSocketCore::startConnecting(const std::string& baseUrl, const std::string& relativePath, const uint16_t portNew,
+		bool doWePrintErrorsNew, bool areWeAStandaloneSocketNew) noexcept {
+		if (!TCPSSLClient::connect(baseUrl, portNew, doWePrintErrorsNew, areWeAStandaloneSocketNew)) {
+			return false;
+		}
 		std::string sendString{ "GET " + relativePath + " HTTP/1.1\r\nHost: " + baseUrl +
 			"\r\nPragma: no-cache\r\nUser-Agent: DiscordCoreAPI/1.0\r\nUpgrade: WebSocket\r\nConnection: "
 			"Upgrade\r\nSec-WebSocket-Key: " +
 			DiscordCoreAPI::generateBase64EncodedKey() + "\r\nSec-WebSocket-Version: 13\r\n\r\n" };
-		size_t readOrWrittenBytes{};
-		this->writeData(sendString, true);
+		// Nothing left over from a previous connection may go out ahead of the upgrade request.
+		this->outputBuffer.clear();
+		return this->writeData(sendString, true) == ProcessIOResult::No_Error;
+	}
 
-		std::string_view buffer{};
+	bool WebSocketCore::connect(const std::string& baseUrl, const std::string& relativePath, const uint16_t portNew, bool doWePrintErrorsNew,
+		bool areWeAStandaloneSocketNew) noexcept {
+		if (!this->startConnecting(baseUrl, relativePath, portNew, doWePrintErrorsNew, areWeAStandaloneSocketNew)) {
+			return false;
+		}
+		DiscordCoreAPI::StopWatch stopWatch{ 5s };
 		do {
 			if (stopWatch.hasTimePassed()) {
 				return false;
@@ -201,30 +468,57 @@ namespace DiscordCoreInternal {
 		return true;
 	}
 
-	void WebSocketCore::createHeader(std::string& outBuffer, WebSocketOpCode opCode) noexcept {
-		size_t originalSize{ outBuffer.size() };
-		outBuffer.insert(outBuffer.begin(), static_cast<uint8_t>(opCode) | webSocketFinishBit);
-
-		int32_t indexCount{};
-		if (originalSize <= webSocketMaxPayloadLengthSmall) {
-			outBuffer.insert(outBuffer.begin() + 1, static_cast<uint8_t>(originalSize));
+	uint64_t WebSocketCore::createHeader(char* header, uint64_t payloadSize, WebSocketOpCode opCode) noexcept {
+		header[0] = static_cast<char>(static_cast<uint8_t>(opCode) | webSocketFinishBit);
+		uint64_t indexCount{};
+		if (payloadSize <= webSocketMaxPayloadLengthSmall) {
+			header[1] = static_cast<char>(payloadSize);
 			indexCount = 0;
-		} else if (originalSize <= webSocketMaxPayloadLengthLarge) {
-			outBuffer.insert(outBuffer.begin() + 1, static_cast<uint8_t>(webSocketPayloadLengthMagicLarge));
+		} else if (payloadSize <= webSocketMaxPayloadLengthLarge) {
+			header[1] = static_cast<char>(webSocketPayloadLengthMagicLarge);
 			indexCount = 2;
 		} else {
-			outBuffer.insert(outBuffer.begin() + 1, static_cast<uint8_t>(webSocketPayloadLengthMagicHuge));
+			header[1] = static_cast<char>(webSocketPayloadLengthMagicHuge);
 			indexCount = 8;
 		}
-		for (int32_t x = indexCount - 1; x >= 0; x--) {
-			outBuffer.insert(outBuffer.begin() + 1 + indexCount - x, static_cast<uint8_t>(originalSize >> x * 8));
+		for (uint64_t x = 0; x < indexCount; ++x) {
+			header[2 + x] = static_cast<char>(payloadSize >> ((indexCount - 1 - x) * 8));
 		}
+		header[1] |= webSocketMaskBit;
+		std::fill(header + 2 + indexCount, header + 2 + indexCount + webSocketMaskKeySize, 0);
+		return 2 + indexCount + webSocketMaskKeySize;
+	}
+
+	void WebSocketCore::createHeader(std::string& outBuffer, WebSocketOpCode opCode) noexcept {
+		char header[maxFrameHeaderSize]{};
+		uint64_t headerSize{ WebSocketCore::createHeader(header, outBuffer.size(), opCode) };
+		outBuffer.insert(0, header, headerSize);
+	}
 
-		outBuffer[1] |= webSocketMaskBit;
-		outBuffer.insert(outBuffer.begin() + 2 + indexCount, 0);
-		outBuffer.insert(outBuffer.begin() + 3 + indexCount, 0);
-		outBuffer.insert(outBuffer.begin() + 4 + indexCount, 0);
-		outBuffer.insert(outBuffer.begin() + 5 + indexCount, 0);
+	bool WebSocketCore::sendMessage(std::string_view dataToSend, WebSocketOpCode opCode, bool priority) noexcept {
+		if (dataToSend.size() == 0) {
+			return false;
+		}
+		if (this->configManager->doWePrintWebSocketSuccessMessages()) {
+			std::string webSocketTitle = this->wsType == WebSocketType::Voice ? "Voice WebSocket" : "WebSocket";
+			cout << DiscordCoreAPI::shiftToBrightBlue()
+				 << "Sending " + webSocketTitle + " [" + std::to_string(this->shard[0]) + "," + std::to_string(this->shard[1]) + "]" +
+					std::string("'s Message: ")
+				 << dataToSend << DiscordCoreAPI::reset() << endl
+				 << endl;
+		}
+		char header[maxFrameHeaderSize]{};
+		std::string_view headerView{ header, WebSocketCore::createHeader(header, dataToSend.size(), opCode) };
+		ProcessIOResult didWeWrite{};
+		DiscordCoreAPI::StopWatch stopWatch{ 5000ms };
+		do {
+			if (stopWatch.hasTimePassed()) {
+				this->onClosed();
+				return false;
+			}
+			didWeWrite = this->writeData(headerView, dataToSend, priority);
+		} while (didWeWrite == ProcessIOResult::Error);
+		return true;
 	}
 
 	bool WebSocketCore::sendMessage(std::string& dataToSend, bool priority) noexcept {
@@ -277,12 +571,12 @@ namespace DiscordCoreInternal {
 				data.refreshString(DiscordCoreAPI::JsonifierSerializeType::Json);
 			}
 			string = data.operator std::string();
-			this->createHeader(string, this->dataOpCode);
-			if (!this->sendMessage(string, true)) {
+			if (!this->sendMessage(string, this->dataOpCode, true)) {
 				return false;
 			}
 			this->haveWeReceivedHeartbeatAck = false;
 			this->heartBeatStopWatch.resetTimer();
+			this->heartbeatSentTime = std::chrono::steady_clock::now();
 			return true;
 		} else {
 			return false;
@@ -299,10 +593,10 @@ namespace DiscordCoreInternal {
 				return;
 			}
 
-			this->dataOpCode = static_cast<WebSocketOpCode>(this->currentMessage[0] & ~webSocketFinishBit);
+			auto opCode = static_cast<WebSocketOpCode>(this->currentMessage[0] & ~webSocketFinishBit);
 			this->messageLength = 0;
 			this->messageOffset = 0;
-			switch (this->dataOpCode) {
+			switch (opCode) {
 				case WebSocketOpCode::Op_Continuation:
 					[[fallthrough]];
 				case WebSocketOpCode::Op_Text:
@@ -340,12 +634,36 @@ namespace DiscordCoreInternal {
 					if (this->currentMessage.size() < this->messageOffset + this->messageLength) {
 						return;
 					} else {
-						if (this->onMessageReceived(
-								this->currentMessage[LengthData{ .offSet = this->messageOffset, .length = this->messageLength }])) {
+						auto startTime = std::chrono::steady_clock::now();
+						std::string_view payload{ this->currentMessage[LengthData{ .offSet = this->messageOffset, .length = this->messageLength }] };
+						if (this->zlibDecompressor.isItInitialized() && opCode != WebSocketOpCode::Op_Ping && opCode != WebSocketOpCode::Op_Pong) {
+							if (!this->zlibDecompressor.decompress(payload)) {
+								if (this->configManager->doWePrintWebSocketErrorMessages()) {
+									cout << DiscordCoreAPI::shiftToBrightRed()
+										 << "Failed to inflate a message for WebSocket [" + std::to_string(this->shard[0]) + "," +
+											std::to_string(this->shard[1]) + "]."
+										 << DiscordCoreAPI::reset() << endl
+										 << endl;
+								}
+								this->onClosed();
+								return;
+							}
+							if (!this->zlibDecompressor.isItComplete()) {
+								this->currentMessage.erase(this->messageLength + this->messageOffset);
+								this->messageOffset = 0;
+								this->messageLength = 0;
+								return;
+							}
+							payload = this->zlibDecompressor.getDecompressedData();
+						}
+						if (this->onMessageReceived(payload)) {
 							this->currentMessage.erase(this->messageLength + this->messageOffset);
 							this->messageOffset = 0;
 							this->messageLength = 0;
 						}
+						this->zlibDecompressor.clearOutput();
+						this->processingTime += static_cast<uint64_t>(Nanoseconds{ std::chrono::steady_clock::now() - startTime }.count());
+						++this->messagesProcessed;
 						return;
 					}
 				}
@@ -407,6 +725,139 @@ namespace DiscordCoreInternal {
 				this->dataOpCode = WebSocketOpCode::Op_Text;
 			}
 		}
+		for (auto& [key, value]: this->configManager->getEventBudgets()) {
+			GatewayEventType eventType{ EventConverter{ key } };
+			switch (eventType) {
+				// Without these, shards, interactions, member requests, or voice connections stall, so they are never held back.
+				case GatewayEventType::Unknown:
+					[[fallthrough]];
+				case GatewayEventType::Ready:
+					[[fallthrough]];
+				case GatewayEventType::Resumed:
+					[[fallthrough]];
+				case GatewayEventType::Interaction_Create:
+					[[fallthrough]];
+				case GatewayEventType::Guild_Members_Chunk:
+					[[fallthrough]];
+				case GatewayEventType::Voice_State_Update:
+					[[fallthrough]];
+				case GatewayEventType::Voice_Server_Update: {
+					break;
+				}
+				default: {
+					EventBudgetState& eventBudget = this->eventBudgets[eventType];
+					eventBudget.tokens = static_cast<double>(value.maxEventsPerSecond);
+					eventBudget.eventName = key;
+					eventBudget.budget = value;
+					break;
+				}
+			}
+		}
+	}
+
+	EventDecodeMode WebSocketClient::applyEventBudget(GatewayEventType eventType, EventDecodeMode decodeMode) noexcept {
+		if (decodeMode != EventDecodeMode::Full || !this->eventBudgets.contains(eventType)) {
+			return decodeMode;
+		}
+		// Whatever goes over budget still reaches the caches, so that they stay correct; only the handlers miss out.
+		EventDecodeMode shedDecodeMode{ this->getEventDecodeMode(eventType, true) };
+		EventBudgetState& eventBudget = this->eventBudgets[eventType];
+		if (eventBudget.budget.maxQueueDepth > 0 && eventBudget.pendingDispatches.load() >= eventBudget.budget.maxQueueDepth) {
+			++eventBudget.droppedForQueueDepth;
+			return shedDecodeMode;
+		}
+		if (eventBudget.budget.maxEventsPerSecond == 0 || eventBudget.tryTakeToken()) {
+			// A held event is older than this one, so dispatchEvent() drops it in this one's favour, in this one's turn.
+			eventBudget.isItHolding = false;
+			return decodeMode;
+		}
+		// Stand-ins have no timer wheel to flush from, and so they drop instead. A held event is built, and the caches are updated from it,
+		// in its turn, just as any other event is; only the handing of it to the handlers waits for the flush.
+		if (eventBudget.budget.policy == DiscordCoreAPI::EventShedPolicy::Coalesce && this->timerWheel) {
+			eventBudget.isItHolding = true;
+			if (!this->isItFlushScheduled) {
+				this->timerWheel->schedule(this->shard[0], TimerType::Event_Flush, this->timerGeneration.load(), eventBudget.getTimeUntilNextToken());
+				this->isItFlushScheduled = true;
+			}
+			return EventDecodeMode::Held;
+		}
+		++eventBudget.droppedForRate;
+		return shedDecodeMode;
+	}
+
+	void WebSocketClient::flushHeldEvents() noexcept {
+		this->isItFlushScheduled = false;
+		std::optional<Milliseconds> timeUntilNextFlush{};
+		for (auto& [key, value]: this->eventBudgets) {
+			if (!value.isItHolding) {
+				continue;
+			}
+			if (!value.tryTakeToken()) {
+				timeUntilNextFlush = std::min(timeUntilNextFlush.value_or(Milliseconds::max()), value.getTimeUntilNextToken());
+				continue;
+			}
+			value.isItHolding = false;
+			// The held event may still be on its way through the dispatch pool, so the flush goes after whatever of the shard's is on there.
+			if (this->discordCoreClient->dispatchPool && this->pendingDispatches.load() > 0) {
+				++this->pendingDispatches;
+				++value.pendingDispatches;
+				EventBudgetState* eventBudget{ &value };
+				this->discordCoreClient->dispatchPool->submitTask(this->shard[0], [=, this]() mutable {
+					eventBudget->flushHeldEvent();
+					--eventBudget->pendingDispatches;
+					--this->pendingDispatches;
+				});
+			} else {
+				value.flushHeldEvent();
+			}
+		}
+		if (timeUntilNextFlush && this->timerWheel) {
+			this->timerWheel->schedule(this->shard[0], TimerType::Event_Flush, this->timerGeneration.load(), *timeUntilNextFlush);
+			this->isItFlushScheduled = true;
+		}
+	}
+
+	void WebSocketClient::holdPresenceUpdate(std::string_view payload, uint64_t guildId, uint64_t userId, EventDecodeMode decodeMode) noexcept {
+		HeldPresenceUpdate& heldUpdate = this->heldPresenceUpdates[std::pair{ guildId, userId }];
+		if (heldUpdate.payload.size() > 0) {
+			++this->presenceUpdatesCoalesced;
+		}
+		heldUpdate.payload.clear();
+		heldUpdate.payload.reserve(payload.size() + simdjson::SIMDJSON_PADDING);
+		heldUpdate.payload.append(payload);
+		heldUpdate.decodeMode = decodeMode;
+		if (!this->isItPresenceFlushScheduled) {
+			this->timerWheel->schedule(this->shard[0], TimerType::Presence_Flush, this->timerGeneration.load(),
+				this->configManager->getPresenceCoalesceWindow());
+			this->isItPresenceFlushScheduled = true;
+		}
+	}
+
+	void WebSocketClient::flushHeldPresenceUpdates() noexcept {
+		this->isItPresenceFlushScheduled = false;
+		auto heldPresenceUpdatesNew = std::move(this->heldPresenceUpdates);
+		this->heldPresenceUpdates.clear();
+		GatewayEventType eventType{ GatewayEventType::Presence_Update };
+		EventBudgetState* eventBudget{ this->eventBudgets.contains(eventType) ? &this->eventBudgets[eventType] : nullptr };
+		for (auto& [key, value]: heldPresenceUpdatesNew) {
+			// Held updates go after whatever of the shard's is already on the dispatch pool, and are kept off of the shard's thread, which
+			// could otherwise be held up by a whole window's worth of them at once.
+			if (this->discordCoreClient->dispatchPool) {
+				if (eventBudget) {
+					++eventBudget->pendingDispatches;
+				}
+				++this->pendingDispatches;
+				this->discordCoreClient->dispatchPool->submitTask(this->shard[0], [=, this, heldUpdate = std::move(value)]() mutable {
+					this->onOffloadedDispatch(heldUpdate.payload, eventType, heldUpdate.decodeMode);
+					if (eventBudget) {
+						--eventBudget->pendingDispatches;
+					}
+					--this->pendingDispatches;
+				});
+			} else {
+				this->onOffloadedDispatch(value.payload, eventType, value.decodeMode);
+			}
+		}
 	}
 
 	void WebSocketClient::getVoiceConnectionData(const DiscordCoreAPI::VoiceConnectInitData& doWeCollect) noexcept {
@@ -430,8 +881,7 @@ namespace DiscordCoreInternal {
 				serializer.refreshString(DiscordCoreAPI::JsonifierSerializeType::Json);
 			}
 			std::string string = serializer.operator std::string();
-			this->createHeader(string, this->dataOpCode);
-			if (!this->sendMessage(string, false)) {
+			if (!this->sendMessage(string, SendLane::State_Update)) {
 				return;
 			}
 		}
@@ -445,35 +895,1118 @@ namespace DiscordCoreInternal {
 		} else {
 			serializer.refreshString(DiscordCoreAPI::JsonifierSerializeType::Json);
 		}
-		std::string string = serializer.operator std::string();
-		this->createHeader(string, this->dataOpCode);
-		this->areWeCollectingData = true;
-		if (!this->sendMessage(string, false)) {
-			return;
+		std::string string = serializer.operator std::string();
+		this->areWeCollectingData = true;
+		if (!this->sendMessage(string, SendLane::State_Update)) {
+			return;
+		}
+		DiscordCoreAPI::StopWatch<Milliseconds> stopWatch{ 5500ms };
+		while (this->areWeCollectingData) {
+			if (stopWatch.hasTimePassed()) {
+				break;
+			}
+			std::this_thread::sleep_for(1ms);
+		}
+	}
+
+	/// Guild events stay at least Cache_Only regardless of the cache settings, since parsing a GuildData is what fills the
+	/// member, channel, role, and voice-state caches. Ignoring the subscribers gives what an event that is kept from them still needs.
+	EventDecodeMode WebSocketClient::getEventDecodeMode(GatewayEventType eventType, bool doWeIgnoreSubscribers) noexcept {
+		bool doWeHaveSubscribers{};
+		bool doWeUpdateTheCache{};
+		switch (eventType) {
+			case GatewayEventType::Ready:
+				[[fallthrough]];
+			case GatewayEventType::Resumed:
+				[[fallthrough]];
+			case GatewayEventType::Interaction_Create:
+				[[fallthrough]];
+			case GatewayEventType::Message_Create:
+				[[fallthrough]];
+			case GatewayEventType::Message_Update: {
+				if (doWeIgnoreSubscribers) {
+					return EventDecodeMode::Skip;
+				}
+				return EventDecodeMode::Full;
+			}
+			// Both feed the voice connections that are collecting their data, whether or not anyone subscribes to them.
+			case GatewayEventType::Voice_State_Update: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onVoiceStateUpdateEvent.functions.size() > 0;
+				doWeUpdateTheCache = true;
+				break;
+			}
+			case GatewayEventType::Voice_Server_Update: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onVoiceServerUpdateEvent.functions.size() > 0;
+				doWeUpdateTheCache = true;
+				break;
+			}
+			case GatewayEventType::Application_Command_Permissions_Update: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onApplicationCommandPermissionsUpdateEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Auto_Moderation_Rule_Create: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onAutoModerationRuleCreationEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Auto_Moderation_Rule_Update: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onAutoModerationRuleUpdateEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Auto_Moderation_Rule_Delete: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onAutoModerationRuleDeletionEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Auto_Moderation_Action_Execution: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onAutoModerationActionExecutionEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Channel_Create: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onChannelCreationEvent.functions.size() > 0;
+				doWeUpdateTheCache = DiscordCoreAPI::Channels::doWeCacheChannels();
+				break;
+			}
+			case GatewayEventType::Channel_Update: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onChannelUpdateEvent.functions.size() > 0;
+				doWeUpdateTheCache = DiscordCoreAPI::Channels::doWeCacheChannels();
+				break;
+			}
+			case GatewayEventType::Channel_Delete: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onChannelDeletionEvent.functions.size() > 0;
+				doWeUpdateTheCache = DiscordCoreAPI::Channels::doWeCacheChannels();
+				break;
+			}
+			case GatewayEventType::Channel_Pins_Update: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onChannelPinsUpdateEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Thread_Create: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onThreadCreationEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Thread_Update: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onThreadUpdateEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Thread_Delete: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onThreadDeletionEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Thread_List_Sync: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onThreadListSyncEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Thread_Member_Update: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onThreadMemberUpdateEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Thread_Members_Update: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onThreadMembersUpdateEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Guild_Create: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onGuildCreationEvent.functions.size() > 0;
+				doWeUpdateTheCache = true;
+				break;
+			}
+			case GatewayEventType::Guild_Update: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onGuildUpdateEvent.functions.size() > 0;
+				doWeUpdateTheCache = true;
+				break;
+			}
+			case GatewayEventType::Guild_Delete: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onGuildDeletionEvent.functions.size() > 0;
+				doWeUpdateTheCache = true;
+				break;
+			}
+			case GatewayEventType::Guild_Ban_Add: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onGuildBanAddEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Guild_Ban_Remove: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onGuildBanRemoveEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Guild_Emojis_Update: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onGuildEmojisUpdateEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Guild_Stickers_Update: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onGuildStickersUpdateEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Guild_Integrations_Update: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onGuildIntegrationsUpdateEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Guild_Member_Add: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onGuildMemberAddEvent.functions.size() > 0;
+				doWeUpdateTheCache = DiscordCoreAPI::GuildMembers::doWeCacheGuildMembers();
+				break;
+			}
+			case GatewayEventType::Guild_Member_Remove: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onGuildMemberRemoveEvent.functions.size() > 0;
+				doWeUpdateTheCache = DiscordCoreAPI::GuildMembers::doWeCacheGuildMembers();
+				break;
+			}
+			case GatewayEventType::Guild_Member_Update: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onGuildMemberUpdateEvent.functions.size() > 0;
+				doWeUpdateTheCache = DiscordCoreAPI::GuildMembers::doWeCacheGuildMembers();
+				break;
+			}
+			case GatewayEventType::Guild_Members_Chunk: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onGuildMembersChunkEvent.functions.size() > 0;
+				std::unique_lock lock{ this->memberRequestMutex };
+				doWeUpdateTheCache = DiscordCoreAPI::GuildMembers::doWeCacheGuildMembers() || this->memberRequestBuffersMap.size() > 0;
+				break;
+			}
+			case GatewayEventType::Guild_Role_Create: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onRoleCreationEvent.functions.size() > 0;
+				doWeUpdateTheCache = DiscordCoreAPI::Roles::doWeCacheRoles() || DiscordCoreAPI::Guilds::doWeCacheGuilds();
+				break;
+			}
+			case GatewayEventType::Guild_Role_Update: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onRoleUpdateEvent.functions.size() > 0;
+				doWeUpdateTheCache = DiscordCoreAPI::Roles::doWeCacheRoles() || DiscordCoreAPI::Guilds::doWeCacheGuilds();
+				break;
+			}
+			case GatewayEventType::Guild_Role_Delete: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onRoleDeletionEvent.functions.size() > 0;
+				doWeUpdateTheCache = DiscordCoreAPI::Roles::doWeCacheRoles() || DiscordCoreAPI::Guilds::doWeCacheGuilds();
+				break;
+			}
+			case GatewayEventType::Guild_Scheduled_Event_Create: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onGuildScheduledEventCreationEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Guild_Scheduled_Event_Update: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onGuildScheduledEventUpdateEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Guild_Scheduled_Event_Delete: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onGuildScheduledEventDeletionEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Guild_Scheduled_Event_User_Add: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onGuildScheduledEventUserAddEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Guild_Scheduled_Event_User_Remove: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onGuildScheduledEventUserRemoveEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Integration_Create: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onIntegrationCreationEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Integration_Update: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onIntegrationUpdateEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Integration_Delete: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onIntegrationDeletionEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Invite_Create: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onInviteCreationEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Invite_Delete: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onInviteDeletionEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Message_Delete: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onMessageDeletionEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Message_Delete_Bulk: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onMessageDeleteBulkEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Message_Reaction_Add: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onReactionAddEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Message_Reaction_Remove: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onReactionRemoveEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Message_Reaction_Remove_All: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onReactionRemoveAllEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Message_Reaction_Remove_Emoji: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onReactionRemoveEmojiEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Presence_Update: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onPresenceUpdateEvent.functions.size() > 0;
+				doWeUpdateTheCache = DiscordCoreAPI::GuildMembers::doWeCacheGuildMembers();
+				break;
+			}
+			case GatewayEventType::Stage_Instance_Create: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onStageInstanceCreationEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Stage_Instance_Update: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onStageInstanceUpdateEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Stage_Instance_Delete: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onStageInstanceDeletionEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Typing_Start: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onTypingStartEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::User_Update: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onUserUpdateEvent.functions.size() > 0;
+				break;
+			}
+			case GatewayEventType::Webhooks_Update: {
+				doWeHaveSubscribers = this->discordCoreClient->eventManager.onWebhookUpdateEvent.functions.size() > 0;
+				break;
+			}
+			default: {
+				return EventDecodeMode::Skip;
+			}
+		}
+		if (doWeHaveSubscribers && !doWeIgnoreSubscribers) {
+			return EventDecodeMode::Full;
+		} else if (doWeUpdateTheCache) {
+			return EventDecodeMode::Cache_Only;
+		} else {
+			return EventDecodeMode::Skip;
+		}
+	}
+
+	/// Events whose payloads can be built straight from the ETF, without first being converted to Json.
+	bool isItDecodableFromEtf(GatewayEventType eventType) noexcept {
+		switch (eventType) {
+			case GatewayEventType::Channel_Create:
+				[[fallthrough]];
+			case GatewayEventType::Channel_Update:
+				[[fallthrough]];
+			case GatewayEventType::Channel_Delete:
+				[[fallthrough]];
+			case GatewayEventType::Guild_Create:
+				[[fallthrough]];
+			case GatewayEventType::Guild_Update:
+				[[fallthrough]];
+			case GatewayEventType::Guild_Member_Add:
+				[[fallthrough]];
+			case GatewayEventType::Guild_Member_Update:
+				[[fallthrough]];
+			case GatewayEventType::Guild_Members_Chunk:
+				[[fallthrough]];
+			case GatewayEventType::Presence_Update: {
+				return true;
+			}
+			default: {
+				return false;
+			}
+		}
+	}
+
+	bool WebSocketClient::onEtfDispatch(GatewayEventType eventType, EventDecodeMode decodeMode, DiscordCoreAPI::EtfValue dValue) {
+		switch (eventType) {
+			case GatewayEventType::Channel_Create: {
+				DiscordCoreAPI::ChannelData channel{ dValue };
+				if (decodeMode == EventDecodeMode::Cache_Only) {
+					DiscordCoreAPI::OnChannelCreationData::updateCache(channel);
+				} else {
+					std::unique_ptr<DiscordCoreAPI::OnChannelCreationData> dataPackage{ std::make_unique<DiscordCoreAPI::OnChannelCreationData>(
+						std::move(channel)) };
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onChannelCreationEvent, dataPackage);
+				}
+				return true;
+			}
+			case GatewayEventType::Channel_Update: {
+				DiscordCoreAPI::ChannelData channel{ dValue };
+				if (decodeMode == EventDecodeMode::Cache_Only) {
+					DiscordCoreAPI::OnChannelUpdateData::updateCache(channel);
+				} else {
+					std::unique_ptr<DiscordCoreAPI::OnChannelUpdateData> dataPackage{ std::make_unique<DiscordCoreAPI::OnChannelUpdateData>(std::move(channel)) };
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onChannelUpdateEvent, dataPackage);
+				}
+				return true;
+			}
+			case GatewayEventType::Channel_Delete: {
+				DiscordCoreAPI::ChannelData channel{ dValue };
+				if (decodeMode == EventDecodeMode::Cache_Only) {
+					DiscordCoreAPI::OnChannelDeletionData::updateCache(channel);
+				} else {
+					std::unique_ptr<DiscordCoreAPI::OnChannelDeletionData> dataPackage{ std::make_unique<DiscordCoreAPI::OnChannelDeletionData>(
+						std::move(channel)) };
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onChannelDeletionEvent, dataPackage);
+				}
+				return true;
+			}
+			case GatewayEventType::Guild_Create: {
+				DiscordCoreAPI::GuildData guild{ dValue };
+				if (decodeMode == EventDecodeMode::Cache_Only) {
+					DiscordCoreAPI::OnGuildCreationData::updateCache(guild, this->discordCoreClient);
+				} else {
+					std::unique_ptr<DiscordCoreAPI::OnGuildCreationData> dataPackage{ std::make_unique<DiscordCoreAPI::OnGuildCreationData>(
+						std::move(guild), this->discordCoreClient) };
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onGuildCreationEvent, dataPackage);
+				}
+				return true;
+			}
+			case GatewayEventType::Guild_Update: {
+				DiscordCoreAPI::GuildData guild{ dValue };
+				if (decodeMode == EventDecodeMode::Cache_Only) {
+					DiscordCoreAPI::OnGuildUpdateData::updateCache(guild, this->discordCoreClient);
+				} else {
+					std::unique_ptr<DiscordCoreAPI::OnGuildUpdateData> dataPackage{ std::make_unique<DiscordCoreAPI::OnGuildUpdateData>(
+						std::move(guild), this->discordCoreClient) };
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onGuildUpdateEvent, dataPackage);
+				}
+				return true;
+			}
+			case GatewayEventType::Guild_Member_Add: {
+				DiscordCoreAPI::GuildMemberData guildMember{ dValue };
+				if (decodeMode == EventDecodeMode::Cache_Only) {
+					DiscordCoreAPI::OnGuildMemberAddData::updateCache(guildMember);
+				} else {
+					std::unique_ptr<DiscordCoreAPI::OnGuildMemberAddData> dataPackage{ std::make_unique<DiscordCoreAPI::OnGuildMemberAddData>(
+						std::move(guildMember), this->discordCoreClient) };
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onGuildMemberAddEvent, dataPackage);
+				}
+				return true;
+			}
+			case GatewayEventType::Guild_Member_Update: {
+				DiscordCoreAPI::GuildMemberData guildMember{ dValue };
+				if (decodeMode == EventDecodeMode::Cache_Only) {
+					DiscordCoreAPI::OnGuildMemberUpdateData::updateCache(guildMember);
+				} else {
+					std::unique_ptr<DiscordCoreAPI::OnGuildMemberUpdateData> dataPackage{ std::make_unique<DiscordCoreAPI::OnGuildMemberUpdateData>(
+						std::move(guildMember), this->discordCoreClient) };
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onGuildMemberUpdateEvent, dataPackage);
+				}
+				return true;
+			}
+			case GatewayEventType::Guild_Members_Chunk: {
+				this->onGuildMembersChunk(DiscordCoreAPI::GuildMembersChunkEventData{ dValue }, decodeMode);
+				return true;
+			}
+			case GatewayEventType::Presence_Update: {
+				DiscordCoreAPI::PresenceUpdateData presenceData{ dValue };
+				if (decodeMode == EventDecodeMode::Cache_Only) {
+					DiscordCoreAPI::OnPresenceUpdateData::updateCache(presenceData);
+				} else {
+					std::unique_ptr<DiscordCoreAPI::OnPresenceUpdateData> dataPackage{ std::make_unique<DiscordCoreAPI::OnPresenceUpdateData>(
+						std::move(presenceData)) };
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onPresenceUpdateEvent, dataPackage);
+				}
+				return true;
+			}
+			default: {
+				return false;
+			}
+		}
+	}
+
+	bool WebSocketClient::doWeOffloadDispatch(GatewayEventType eventType, uint64_t payloadSize) noexcept {
+		if (!this->discordCoreClient->dispatchPool || this->configManager->doWePrintWebSocketSuccessMessages()) {
+			return false;
+		}
+		// These two change the state of the shard itself, which everything after them relies on.
+		if (eventType == GatewayEventType::Ready || eventType == GatewayEventType::Resumed) {
+			return false;
+		}
+		// Once a dispatch has been handed off, the ones after it follow it until the queue drains, so that none of them overtakes it.
+		return this->pendingDispatches.load() > 0 || payloadSize >= this->configManager->getDispatchOffloadThreshold();
+	}
+
+	void WebSocketClient::onOffloadedDispatch(std::string& payload, GatewayEventType eventType, EventDecodeMode decodeMode) noexcept {
+		// The shard's own parsers are still in use on its thread.
+		thread_local simdjson::ondemand::parser parserNew{};
+		thread_local ErlParser erlParser{};
+		try {
+			if (this->configManager->getTextFormat() == DiscordCoreAPI::TextFormat::Etf) {
+				if (isItDecodableFromEtf(eventType)) {
+					this->onEtfDispatch(eventType, decodeMode, DiscordCoreAPI::EtfValue{ payload, 1 }["d"]);
+					return;
+				}
+				std::string payloadNew{ erlParser.parseEtfToJson(payload) };
+				payloadNew.reserve(payloadNew.size() + simdjson::SIMDJSON_PADDING);
+				payload = std::move(payloadNew);
+			}
+			simdjson::ondemand::value dValue{};
+			if (parserNew.iterate(simdjson::padded_string_view(payload.data(), payload.length(), payload.capacity())).get(dValue) ==
+				simdjson::error_code::SUCCESS) {
+				WebSocketMessage message{ dValue };
+				this->onJsonDispatch(eventType, decodeMode, message, dValue);
+			}
+		} catch (...) {
+			DiscordCoreAPI::reportException("WebSocketClient::onOffloadedDispatch()");
+		}
+	}
+
+	void WebSocketClient::onJsonDispatch(GatewayEventType eventType, EventDecodeMode decodeMode, WebSocketMessage& message,
+		simdjson::ondemand::value dValue) {
+		switch (eventType) {
+			case GatewayEventType::Ready: {
+				ReadyData data{ message.processJsonMessage<ReadyData>(dValue, "d") };
+				this->currentState.store(WebSocketState::Authenticated);
+				this->sessionId = data.sessionId;
+				this->resumeUrl = data.resumeGatewayUrl;
+				auto& baseSocketAgents = this->discordCoreClient->baseSocketAgentsMap;
+				// Shards are handed out to the agents round-robin in addShards(), so this finds one without inserting into the map.
+				auto baseSocketAgent = baseSocketAgents.end();
+				if (baseSocketAgents.size() > 0) {
+					baseSocketAgent = baseSocketAgents.find(this->shard[0] % static_cast<uint32_t>(baseSocketAgents.size()));
+				}
+				this->discordCoreClient->currentUser =
+					DiscordCoreAPI::BotUser{ data.user, baseSocketAgent != baseSocketAgents.end() ? baseSocketAgent->second.get() : nullptr };
+				DiscordCoreAPI::Users::insertUser(std::move(data.user));
+				this->currentReconnectTries = 0;
+				break;
+			}
+			case GatewayEventType::Resumed: {
+				this->currentState.store(WebSocketState::Authenticated);
+				this->currentReconnectTries = 0;
+				break;
+			}
+			case GatewayEventType::Application_Command_Permissions_Update: {
+				if (this->discordCoreClient->eventManager.onApplicationCommandPermissionsUpdateEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnApplicationCommandPermissionsUpdateData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnApplicationCommandPermissionsUpdateData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode,
+						this->discordCoreClient->eventManager.onApplicationCommandPermissionsUpdateEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Auto_Moderation_Rule_Create: {
+				if (this->discordCoreClient->eventManager.onAutoModerationRuleCreationEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnAutoModerationRuleCreationData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnAutoModerationRuleCreationData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onAutoModerationRuleCreationEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Auto_Moderation_Rule_Update: {
+				if (this->discordCoreClient->eventManager.onAutoModerationRuleUpdateEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnAutoModerationRuleUpdateData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnAutoModerationRuleUpdateData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onAutoModerationRuleUpdateEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Auto_Moderation_Rule_Delete: {
+				if (this->discordCoreClient->eventManager.onAutoModerationRuleDeletionEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnAutoModerationRuleDeletionData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnAutoModerationRuleDeletionData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onAutoModerationRuleDeletionEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Auto_Moderation_Action_Execution: {
+				if (this->discordCoreClient->eventManager.onAutoModerationActionExecutionEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnAutoModerationActionExecutionData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnAutoModerationActionExecutionData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode,
+						this->discordCoreClient->eventManager.onAutoModerationActionExecutionEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Channel_Create: {
+				if (decodeMode == EventDecodeMode::Cache_Only) {
+					DiscordCoreAPI::ChannelData channel{ message.processJsonMessage<DiscordCoreAPI::ChannelData>(dValue, "d") };
+					DiscordCoreAPI::OnChannelCreationData::updateCache(channel);
+				} else {
+					std::unique_ptr<DiscordCoreAPI::OnChannelCreationData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnChannelCreationData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onChannelCreationEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Channel_Update: {
+				if (decodeMode == EventDecodeMode::Cache_Only) {
+					DiscordCoreAPI::ChannelData channel{ message.processJsonMessage<DiscordCoreAPI::ChannelData>(dValue, "d") };
+					DiscordCoreAPI::OnChannelUpdateData::updateCache(channel);
+				} else {
+					std::unique_ptr<DiscordCoreAPI::OnChannelUpdateData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnChannelUpdateData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onChannelUpdateEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Channel_Delete: {
+				if (decodeMode == EventDecodeMode::Cache_Only) {
+					DiscordCoreAPI::ChannelData channel{ message.processJsonMessage<DiscordCoreAPI::ChannelData>(dValue, "d") };
+					DiscordCoreAPI::OnChannelDeletionData::updateCache(channel);
+				} else {
+					std::unique_ptr<DiscordCoreAPI::OnChannelDeletionData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnChannelDeletionData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onChannelDeletionEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Channel_Pins_Update: {
+				if (this->discordCoreClient->eventManager.onChannelPinsUpdateEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnChannelPinsUpdateData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnChannelPinsUpdateData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onChannelPinsUpdateEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Thread_Create: {
+				if (this->discordCoreClient->eventManager.onThreadCreationEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnThreadCreationData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnThreadCreationData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onThreadCreationEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Thread_Update: {
+				if (this->discordCoreClient->eventManager.onThreadUpdateEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnThreadUpdateData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnThreadUpdateData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onThreadUpdateEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Thread_Delete: {
+				if (this->discordCoreClient->eventManager.onThreadDeletionEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnThreadDeletionData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnThreadDeletionData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onThreadDeletionEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Thread_List_Sync: {
+				if (this->discordCoreClient->eventManager.onThreadListSyncEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnThreadListSyncData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnThreadListSyncData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onThreadListSyncEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Thread_Member_Update: {
+				if (this->discordCoreClient->eventManager.onThreadMemberUpdateEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnThreadMemberUpdateData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnThreadMemberUpdateData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onThreadMemberUpdateEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Thread_Members_Update: {
+				if (this->discordCoreClient->eventManager.onThreadMembersUpdateEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnThreadMembersUpdateData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnThreadMembersUpdateData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onThreadMembersUpdateEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Guild_Create: {
+				if (decodeMode == EventDecodeMode::Cache_Only) {
+					DiscordCoreAPI::GuildData guild{ message.processJsonMessage<DiscordCoreAPI::GuildData>(dValue, "d") };
+					DiscordCoreAPI::OnGuildCreationData::updateCache(guild, this->discordCoreClient);
+				} else {
+					std::unique_ptr<DiscordCoreAPI::OnGuildCreationData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnGuildCreationData>(message, dValue, this->discordCoreClient)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onGuildCreationEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Guild_Update: {
+				if (decodeMode == EventDecodeMode::Cache_Only) {
+					DiscordCoreAPI::GuildData guild{ message.processJsonMessage<DiscordCoreAPI::GuildData>(dValue, "d") };
+					DiscordCoreAPI::OnGuildUpdateData::updateCache(guild, this->discordCoreClient);
+				} else {
+					std::unique_ptr<DiscordCoreAPI::OnGuildUpdateData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnGuildUpdateData>(message, dValue, this->discordCoreClient)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onGuildUpdateEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Guild_Delete: {
+				if (decodeMode == EventDecodeMode::Cache_Only) {
+					DiscordCoreAPI::GuildData guild{ message.processJsonMessage<DiscordCoreAPI::GuildData>(dValue, "d") };
+					DiscordCoreAPI::OnGuildDeletionData::updateCache(guild);
+				} else {
+					std::unique_ptr<DiscordCoreAPI::OnGuildDeletionData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnGuildDeletionData>(message, dValue, this->discordCoreClient)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onGuildDeletionEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Guild_Ban_Add: {
+				if (this->discordCoreClient->eventManager.onGuildBanAddEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnGuildBanAddData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnGuildBanAddData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onGuildBanAddEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Guild_Ban_Remove: {
+				if (this->discordCoreClient->eventManager.onGuildBanRemoveEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnGuildBanRemoveData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnGuildBanRemoveData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onGuildBanRemoveEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Guild_Emojis_Update: {
+				if (this->discordCoreClient->eventManager.onGuildEmojisUpdateEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnGuildEmojisUpdateData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnGuildEmojisUpdateData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onGuildEmojisUpdateEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Guild_Stickers_Update: {
+				if (this->discordCoreClient->eventManager.onGuildStickersUpdateEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnGuildStickersUpdateData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnGuildStickersUpdateData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onGuildStickersUpdateEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Guild_Integrations_Update: {
+				if (this->discordCoreClient->eventManager.onGuildIntegrationsUpdateEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnGuildIntegrationsUpdateData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnGuildIntegrationsUpdateData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onGuildIntegrationsUpdateEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Guild_Member_Add: {
+				if (decodeMode == EventDecodeMode::Cache_Only) {
+					DiscordCoreAPI::GuildMemberData guildMember{ message.processJsonMessage<DiscordCoreAPI::GuildMemberData>(dValue, "d") };
+					DiscordCoreAPI::OnGuildMemberAddData::updateCache(guildMember);
+				} else {
+					std::unique_ptr<DiscordCoreAPI::OnGuildMemberAddData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnGuildMemberAddData>(message, dValue, this->discordCoreClient)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onGuildMemberAddEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Guild_Member_Remove: {
+				if (decodeMode == EventDecodeMode::Cache_Only) {
+					DiscordCoreAPI::Snowflake guildId{ DiscordCoreAPI::getId(dValue["d"], "guild_id") };
+					DiscordCoreAPI::UserData user{ message.processJsonMessage<DiscordCoreAPI::UserData>(dValue["d"], "user") };
+					DiscordCoreAPI::OnGuildMemberRemoveData::updateCache(guildId, user);
+				} else {
+					std::unique_ptr<DiscordCoreAPI::OnGuildMemberRemoveData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnGuildMemberRemoveData>(message, dValue, this->discordCoreClient)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onGuildMemberRemoveEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Guild_Member_Update: {
+				if (decodeMode == EventDecodeMode::Cache_Only) {
+					DiscordCoreAPI::GuildMemberData guildMember{ message.processJsonMessage<DiscordCoreAPI::GuildMemberData>(dValue, "d") };
+					DiscordCoreAPI::OnGuildMemberUpdateData::updateCache(guildMember);
+				} else {
+					std::unique_ptr<DiscordCoreAPI::OnGuildMemberUpdateData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnGuildMemberUpdateData>(message, dValue, this->discordCoreClient)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onGuildMemberUpdateEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Guild_Members_Chunk: {
+				this->onGuildMembersChunk(message.processJsonMessage<DiscordCoreAPI::GuildMembersChunkEventData>(dValue, "d"),
+					decodeMode);
+				break;
+			}
+			case GatewayEventType::Guild_Role_Create: {
+				if (decodeMode == EventDecodeMode::Cache_Only) {
+					DiscordCoreAPI::Snowflake guildId{ DiscordCoreAPI::getId(dValue["d"], "guild_id") };
+					DiscordCoreAPI::RoleData role{ message.processJsonMessage<DiscordCoreAPI::RoleData>(dValue["d"], "role") };
+					DiscordCoreAPI::OnRoleCreationData::updateCache(guildId, role);
+				} else {
+					std::unique_ptr<DiscordCoreAPI::OnRoleCreationData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnRoleCreationData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onRoleCreationEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Guild_Role_Update: {
+				if (decodeMode == EventDecodeMode::Cache_Only) {
+					DiscordCoreAPI::Snowflake guildId{ DiscordCoreAPI::getId(dValue["d"], "guild_id") };
+					DiscordCoreAPI::RoleData role{ message.processJsonMessage<DiscordCoreAPI::RoleData>(dValue["d"], "role") };
+					DiscordCoreAPI::OnRoleUpdateData::updateCache(guildId, role);
+				} else {
+					std::unique_ptr<DiscordCoreAPI::OnRoleUpdateData> dataPackage{ std::make_unique<DiscordCoreAPI::OnRoleUpdateData>(
+						message, dValue) };
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onRoleUpdateEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Guild_Role_Delete: {
+				if (decodeMode == EventDecodeMode::Cache_Only) {
+					DiscordCoreAPI::Snowflake roleId{ DiscordCoreAPI::getId(dValue["d"], "role_id") };
+					DiscordCoreAPI::Snowflake guildId{ DiscordCoreAPI::getId(dValue["d"], "guild_id") };
+					DiscordCoreAPI::OnRoleDeletionData::updateCache(guildId, roleId);
+				} else {
+					std::unique_ptr<DiscordCoreAPI::OnRoleDeletionData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnRoleDeletionData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onRoleDeletionEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Guild_Scheduled_Event_Create: {
+				if (this->discordCoreClient->eventManager.onGuildScheduledEventCreationEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnGuildScheduledEventCreationData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnGuildScheduledEventCreationData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onGuildScheduledEventCreationEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Guild_Scheduled_Event_Update: {
+				if (this->discordCoreClient->eventManager.onGuildScheduledEventUpdateEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnGuildScheduledEventUpdateData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnGuildScheduledEventUpdateData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onGuildScheduledEventUpdateEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Guild_Scheduled_Event_Delete: {
+				if (this->discordCoreClient->eventManager.onGuildScheduledEventDeletionEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnGuildScheduledEventDeletionData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnGuildScheduledEventDeletionData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onGuildScheduledEventDeletionEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Guild_Scheduled_Event_User_Add: {
+				if (this->discordCoreClient->eventManager.onGuildScheduledEventUserAddEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnGuildScheduledEventUserAddData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnGuildScheduledEventUserAddData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onGuildScheduledEventUserAddEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Guild_Scheduled_Event_User_Remove: {
+				if (this->discordCoreClient->eventManager.onGuildScheduledEventUserRemoveEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnGuildScheduledEventUserRemoveData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnGuildScheduledEventUserRemoveData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode,
+						this->discordCoreClient->eventManager.onGuildScheduledEventUserRemoveEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Integration_Create: {
+				if (this->discordCoreClient->eventManager.onIntegrationCreationEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnIntegrationCreationData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnIntegrationCreationData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onIntegrationCreationEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Integration_Update: {
+				if (this->discordCoreClient->eventManager.onIntegrationUpdateEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnIntegrationUpdateData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnIntegrationUpdateData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onIntegrationUpdateEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Integration_Delete: {
+				if (this->discordCoreClient->eventManager.onIntegrationDeletionEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnIntegrationDeletionData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnIntegrationDeletionData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onIntegrationDeletionEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Interaction_Create: {
+				std::unique_ptr<DiscordCoreAPI::OnInteractionCreationData> dataPackage{
+					std::make_unique<DiscordCoreAPI::OnInteractionCreationData>(message, dValue, this->discordCoreClient)
+				};
+				if (this->discordCoreClient->eventManager.onInteractionCreationEvent.functions.size() > 0) {
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onInteractionCreationEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Invite_Create: {
+				if (this->discordCoreClient->eventManager.onInviteCreationEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnInviteCreationData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnInviteCreationData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onInviteCreationEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Invite_Delete: {
+				if (this->discordCoreClient->eventManager.onInviteDeletionEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnInviteDeletionData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnInviteDeletionData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onInviteDeletionEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Message_Create: {
+				std::unique_ptr<DiscordCoreAPI::OnMessageCreationData> dataPackage{
+					std::make_unique<DiscordCoreAPI::OnMessageCreationData>(message, dValue)
+				};
+				if (this->discordCoreClient->eventManager.onMessageCreationEvent.functions.size() > 0) {
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onMessageCreationEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Message_Update: {
+				std::unique_ptr<DiscordCoreAPI::OnMessageUpdateData> dataPackage{
+					std::make_unique<DiscordCoreAPI::OnMessageUpdateData>(message, dValue)
+				};
+				if (this->discordCoreClient->eventManager.onMessageUpdateEvent.functions.size() > 0) {
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onMessageUpdateEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Message_Delete: {
+				if (this->discordCoreClient->eventManager.onMessageDeletionEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnMessageDeletionData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnMessageDeletionData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onMessageDeletionEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Message_Delete_Bulk: {
+				if (this->discordCoreClient->eventManager.onMessageDeleteBulkEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnMessageDeleteBulkData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnMessageDeleteBulkData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onMessageDeleteBulkEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Message_Reaction_Add: {
+				if (this->discordCoreClient->eventManager.onReactionAddEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnReactionAddData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnReactionAddData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onReactionAddEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Message_Reaction_Remove: {
+				if (this->discordCoreClient->eventManager.onReactionRemoveEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnReactionRemoveData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnReactionRemoveData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onReactionRemoveEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Message_Reaction_Remove_All: {
+				if (this->discordCoreClient->eventManager.onReactionRemoveAllEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnReactionRemoveAllData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnReactionRemoveAllData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onReactionRemoveAllEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Message_Reaction_Remove_Emoji: {
+				if (this->discordCoreClient->eventManager.onReactionRemoveEmojiEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnReactionRemoveEmojiData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnReactionRemoveEmojiData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onReactionRemoveEmojiEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Presence_Update: {
+				if (decodeMode == EventDecodeMode::Cache_Only) {
+					DiscordCoreAPI::PresenceUpdateData presenceData{ message.processJsonMessage<DiscordCoreAPI::PresenceUpdateData>(dValue, "d") };
+					DiscordCoreAPI::OnPresenceUpdateData::updateCache(presenceData);
+				} else {
+					std::unique_ptr<DiscordCoreAPI::OnPresenceUpdateData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnPresenceUpdateData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onPresenceUpdateEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Stage_Instance_Create: {
+				if (this->discordCoreClient->eventManager.onStageInstanceCreationEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnStageInstanceCreationData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnStageInstanceCreationData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onStageInstanceCreationEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Stage_Instance_Update: {
+				if (this->discordCoreClient->eventManager.onStageInstanceUpdateEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnStageInstanceUpdateData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnStageInstanceUpdateData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onStageInstanceUpdateEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Stage_Instance_Delete: {
+				if (this->discordCoreClient->eventManager.onStageInstanceDeletionEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnStageInstanceDeletionData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnStageInstanceDeletionData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onStageInstanceDeletionEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Typing_Start: {
+				if (this->discordCoreClient->eventManager.onTypingStartEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnTypingStartData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnTypingStartData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onTypingStartEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::User_Update: {
+				if (this->discordCoreClient->eventManager.onUserUpdateEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnUserUpdateData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnUserUpdateData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onUserUpdateEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Voice_State_Update: {
+				if (decodeMode == EventDecodeMode::Cache_Only) {
+					DiscordCoreAPI::VoiceStateData voiceState{ message.processJsonMessage<DiscordCoreAPI::VoiceStateData>(dValue, "d") };
+					DiscordCoreAPI::OnVoiceStateUpdateData::updateCache(voiceState, this);
+				} else {
+					std::unique_ptr<DiscordCoreAPI::OnVoiceStateUpdateData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnVoiceStateUpdateData>(message, dValue, this)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onVoiceStateUpdateEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Voice_Server_Update: {
+				if (decodeMode == EventDecodeMode::Cache_Only) {
+					DiscordCoreAPI::Snowflake guildId{ DiscordCoreAPI::getId(dValue["d"], "guild_id") };
+					std::string endpoint{ DiscordCoreAPI::getString(dValue["d"], "endpoint") };
+					std::string token{ DiscordCoreAPI::getString(dValue["d"], "token") };
+					DiscordCoreAPI::OnVoiceServerUpdateData::updateCache(guildId, endpoint, token, this);
+				} else {
+					std::unique_ptr<DiscordCoreAPI::OnVoiceServerUpdateData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnVoiceServerUpdateData>(message, dValue, this)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onVoiceServerUpdateEvent, dataPackage);
+				}
+				break;
+			}
+			case GatewayEventType::Webhooks_Update: {
+				if (this->discordCoreClient->eventManager.onWebhookUpdateEvent.functions.size() > 0) {
+					std::unique_ptr<DiscordCoreAPI::OnWebhookUpdateData> dataPackage{
+						std::make_unique<DiscordCoreAPI::OnWebhookUpdateData>(message, dValue)
+					};
+					this->dispatchEvent(eventType, decodeMode, this->discordCoreClient->eventManager.onWebhookUpdateEvent, dataPackage);
+				}
+				break;
+			}
+			default: {
+				break;
+			}
+		}
+	}
+
+	void WebSocketClient::onGuildMembersChunk(DiscordCoreAPI::GuildMembersChunkEventData&& chunk, EventDecodeMode decodeMode) {
+		DiscordCoreAPI::GuildMembersProgressData progress{};
+		progress.membersReceived = chunk.members.size();
+		progress.chunkCount = chunk.chunkCount;
+		progress.guildId = chunk.guildId;
+		if (DiscordCoreAPI::GuildMembers::doWeCacheGuildMembers()) {
+			// The subscribers still want the members, so only a chunk nobody is listening for gives them up to the cache.
+			if (decodeMode == EventDecodeMode::Full) {
+				DiscordCoreAPI::GuildMembers::insertGuildMembers(std::vector<DiscordCoreAPI::GuildMemberData>{ chunk.members });
+			} else {
+				DiscordCoreAPI::GuildMembers::insertGuildMembers(std::move(chunk.members));
+			}
 		}
-		DiscordCoreAPI::StopWatch<Milliseconds> stopWatch{ 5500ms };
-		while (this->areWeCollectingData) {
-			if (stopWatch.hasTimePassed()) {
-				break;
+		if (chunk.nonce.size() > 0) {
+			std::unique_lock lock{ this->memberRequestMutex };
+			if (this->memberRequestBuffersMap.contains(chunk.nonce)) {
+				this->memberRequestBuffersMap[chunk.nonce]->send(std::move(progress));
 			}
-			std::this_thread::sleep_for(1ms);
+		}
+		if (decodeMode == EventDecodeMode::Full) {
+			std::unique_ptr<DiscordCoreAPI::OnGuildMembersChunkData> dataPackage{ std::make_unique<DiscordCoreAPI::OnGuildMembersChunkData>(
+				std::move(chunk)) };
+			this->discordCoreClient->eventManager.onGuildMembersChunkEvent(*dataPackage);
 		}
 	}
 
 	bool WebSocketClient::onMessageReceived(std::string_view dataNew) noexcept {
 		try {
-			if (this->areWeStillConnected() && this->currentMessage.size() > 0 && dataNew.size() > 0) {
+			if ((this->areWeProxied || (this->areWeStillConnected() && this->currentMessage.size() > 0)) && dataNew.size() > 0) {
+				auto receivedTime = std::chrono::steady_clock::now();
 				std::string payload{};
 				simdjson::ondemand::value dValue{};
+				EventDecodeMode decodeMode{ EventDecodeMode::Full };
+				GatewayEventType eventType{};
+				DiscordCoreAPI::EtfValue etfValue{};
+				bool areWeDecodingEtfDirectly{};
+				bool areWeOffloading{};
 				WebSocketMessage message{};
 				if (this->configManager->getTextFormat() == DiscordCoreAPI::TextFormat::Etf) {
 					try {
-						payload = ErlParser::parseEtfToJson(dataNew);
-						payload.reserve(payload.size() + simdjson::SIMDJSON_PADDING);
-						if (auto result =
-								this->parser.iterate(simdjson::padded_string_view(payload.data(), payload.length(), payload.capacity())).get(dValue);
-							result == simdjson::error_code::SUCCESS) {
-							message = WebSocketMessage{ dValue };
+						if (static_cast<uint8_t>(dataNew[0]) != formatVersion) {
+							throw ErlParseError{ "WebSocketClient::onMessageReceived() Error: Incorrect format version specified." };
+						}
+						etfValue = DiscordCoreAPI::EtfValue{ dataNew, 1 };
+						message = WebSocketMessage{ etfValue };
+						if (message.op == 0) {
+							eventType = EventConverter{ message.t };
+							decodeMode = this->applyEventBudget(eventType, this->getEventDecodeMode(eventType));
+						}
+						areWeOffloading =
+							message.op == 0 && decodeMode != EventDecodeMode::Skip && this->doWeOffloadDispatch(eventType, dataNew.size());
+						areWeDecodingEtfDirectly = message.op == 0 && !this->configManager->doWePrintWebSocketSuccessMessages() &&
+							(decodeMode == EventDecodeMode::Skip || isItDecodableFromEtf(eventType));
+						if (!areWeDecodingEtfDirectly && !areWeOffloading) {
+							payload = ErlParser::parseEtfToJson(dataNew);
+							payload.reserve(payload.size() + simdjson::SIMDJSON_PADDING);
+							if (auto result =
+									this->parser.iterate(simdjson::padded_string_view(payload.data(), payload.length(), payload.capacity())).get(dValue);
+								result == simdjson::error_code::SUCCESS) {
+								message = WebSocketMessage{ dValue };
+							}
 						}
 					} catch (...) {
 						if (this->configManager->doWePrintGeneralErrorMessages()) {
@@ -487,12 +2020,26 @@ namespace DiscordCoreInternal {
 						return false;
 					}
 				} else {
-					payload = dataNew;
-					payload.reserve(payload.size() + simdjson::SIMDJSON_PADDING);
-					if (this->parser.iterate(simdjson::padded_string_view(payload.data(), payload.length(), payload.capacity())).get(dValue) ==
-						simdjson::error_code::SUCCESS) {
+					if (this->parser.iterate(simdjson::padded_string_view(dataNew.data(), dataNew.size(), dataNew.size() + StringBuffer::paddingSize))
+							.get(dValue) == simdjson::error_code::SUCCESS) {
 						message = WebSocketMessage{ dValue };
 					}
+					if (message.op == 0) {
+						eventType = EventConverter{ message.t };
+						decodeMode = this->applyEventBudget(eventType, this->getEventDecodeMode(eventType));
+						areWeOffloading = decodeMode != EventDecodeMode::Skip && this->doWeOffloadDispatch(eventType, dataNew.size());
+					}
+				}
+				this->frameParseTime.record(std::chrono::steady_clock::now() - receivedTime);
+				// Ready and Resumed only concern this shard's session, which neither the consumers nor a replay have any part in. Stand-ins only
+				// pass on what was journaled or published already, so they do neither again.
+				if (message.op == 0 && !this->areWeProxied && eventType != GatewayEventType::Ready && eventType != GatewayEventType::Resumed) {
+					if (this->eventJournal) {
+						this->eventJournal->append(static_cast<uint32_t>(message.s), dataNew);
+					}
+					if (this->discordCoreClient->gatewayProxyPublisher) {
+						this->discordCoreClient->gatewayProxyPublisher->publish(this->shard[0], dataNew, eventType);
+					}
 				}
 				if (message.s != 0) {
 					this->lastNumberReceived = message.s;
@@ -501,554 +2048,68 @@ namespace DiscordCoreInternal {
 					cout << DiscordCoreAPI::shiftToBrightGreen()
 						 << "Message received from WebSocket [" + std::to_string(this->shard[0]) + "," + std::to_string(this->shard[1]) + "]" +
 							std::string(": ")
-						 << payload << DiscordCoreAPI::reset() << endl
+						 << (payload.size() > 0 ? std::string_view{ payload } : dataNew) << DiscordCoreAPI::reset() << endl
 						 << endl;
 				}
+				if (decodeMode == EventDecodeMode::Skip) {
+					return true;
+				}
+				// Stand-ins have no timer wheel to flush from, and so they hand over every update.
+				if (eventType == GatewayEventType::Presence_Update && this->timerWheel && this->configManager->getPresenceCoalesceWindow() > 0ms) {
+					uint64_t guildId{};
+					uint64_t userId{};
+					if (this->configManager->getTextFormat() == DiscordCoreAPI::TextFormat::Etf) {
+						guildId = static_cast<uint64_t>(etfValue["d"]["guild_id"].getId());
+						userId = static_cast<uint64_t>(etfValue["d"]["user"]["id"].getId());
+					} else if (simdjson::ondemand::value object{}; DiscordCoreAPI::getObject(object, "d", dValue)) {
+						guildId = static_cast<uint64_t>(DiscordCoreAPI::getId(object, "guild_id"));
+						if (simdjson::ondemand::value user{}; DiscordCoreAPI::getObject(user, "user", object)) {
+							userId = static_cast<uint64_t>(DiscordCoreAPI::getId(user, "id"));
+						}
+					}
+					if (userId != 0) {
+						this->holdPresenceUpdate(dataNew, guildId, userId, decodeMode);
+						return true;
+					}
+					// The payload has been partly read already, so an update that cannot be told apart from others starts over from a copy,
+					// which goes the way of any other dispatch's.
+					if (!areWeOffloading) {
+						std::string payloadNew{};
+						payloadNew.reserve(dataNew.size() + simdjson::SIMDJSON_PADDING);
+						payloadNew.append(dataNew);
+						this->onOffloadedDispatch(payloadNew, eventType, decodeMode);
+						return true;
+					}
+				}
+				if (areWeOffloading) {
+					std::string payloadNew{};
+					payloadNew.reserve(dataNew.size() + simdjson::SIMDJSON_PADDING);
+					payloadNew.append(dataNew);
+					EventBudgetState* eventBudget{ this->eventBudgets.contains(eventType) ? &this->eventBudgets[eventType] : nullptr };
+					if (eventBudget) {
+						++eventBudget->pendingDispatches;
+					}
+					++this->pendingDispatches;
+					this->discordCoreClient->dispatchPool->submitTask(this->shard[0], [=, this, payloadNew = std::move(payloadNew)]() mutable {
+						this->onOffloadedDispatch(payloadNew, eventType, decodeMode);
+						this->dispatchLatency.record(std::chrono::steady_clock::now() - receivedTime);
+						if (eventBudget) {
+							--eventBudget->pendingDispatches;
+						}
+						--this->pendingDispatches;
+					});
+					return true;
+				}
+				if (areWeDecodingEtfDirectly) {
+					this->onEtfDispatch(eventType, decodeMode, etfValue["d"]);
+					this->dispatchLatency.record(std::chrono::steady_clock::now() - receivedTime);
+					return true;
+				}
 				switch (static_cast<WebSocketOpCodes>(message.op)) {
 					case WebSocketOpCodes::Dispatch: {
 						if (message.t != "") {
-							switch (EventConverter{ message.t }) {
-								case 1: {
-									ReadyData data{ message.processJsonMessage<ReadyData>(dValue, "d") };
-									this->currentState.store(WebSocketState::Authenticated);
-									this->sessionId = data.sessionId;
-									this->resumeUrl = data.resumeGatewayUrl;
-									this->discordCoreClient->currentUser = DiscordCoreAPI::BotUser{ data.user,
-										this->discordCoreClient
-											->baseSocketAgentsMap[static_cast<int32_t>(floor(static_cast<int32_t>(this->shard[0]) %
-												static_cast<int32_t>(this->discordCoreClient->configManager.getTotalShardCount())))]
-											.get() };
-									DiscordCoreAPI::Users::insertUser(std::move(data.user));
-									this->currentReconnectTries = 0;
-									break;
-								}
-								case 2: {
-									this->currentState.store(WebSocketState::Authenticated);
-									this->currentReconnectTries = 0;
-									break;
-								}
-								case 3: {
-									if (this->discordCoreClient->eventManager.onApplicationCommandPermissionsUpdateEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnApplicationCommandPermissionsUpdateData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnApplicationCommandPermissionsUpdateData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onApplicationCommandPermissionsUpdateEvent(*dataPackage);
-									}
-									break;
-								}
-								case 4: {
-									if (this->discordCoreClient->eventManager.onAutoModerationRuleCreationEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnAutoModerationRuleCreationData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnAutoModerationRuleCreationData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onAutoModerationRuleCreationEvent(*dataPackage);
-									}
-									break;
-								}
-								case 5: {
-									if (this->discordCoreClient->eventManager.onAutoModerationRuleUpdateEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnAutoModerationRuleUpdateData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnAutoModerationRuleUpdateData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onAutoModerationRuleUpdateEvent(*dataPackage);
-									}
-									break;
-								}
-								case 6: {
-									if (this->discordCoreClient->eventManager.onAutoModerationRuleDeletionEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnAutoModerationRuleDeletionData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnAutoModerationRuleDeletionData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onAutoModerationRuleDeletionEvent(*dataPackage);
-									}
-									break;
-								}
-								case 7: {
-									if (this->discordCoreClient->eventManager.onAutoModerationActionExecutionEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnAutoModerationActionExecutionData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnAutoModerationActionExecutionData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onAutoModerationActionExecutionEvent(*dataPackage);
-									}
-									break;
-								}
-								case 8: {
-									std::unique_ptr<DiscordCoreAPI::OnChannelCreationData> dataPackage{
-										std::make_unique<DiscordCoreAPI::OnChannelCreationData>(message, dValue)
-									};
-									if (this->discordCoreClient->eventManager.onChannelCreationEvent.functions.size() > 0) {
-										this->discordCoreClient->eventManager.onChannelCreationEvent(*dataPackage);
-									}
-									break;
-								}
-								case 9: {
-									std::unique_ptr<DiscordCoreAPI::OnChannelUpdateData> dataPackage{
-										std::make_unique<DiscordCoreAPI::OnChannelUpdateData>(message, dValue)
-									};
-									if (this->discordCoreClient->eventManager.onChannelUpdateEvent.functions.size() > 0) {
-										this->discordCoreClient->eventManager.onChannelUpdateEvent(*dataPackage);
-									}
-									break;
-								}
-								case 10: {
-									std::unique_ptr<DiscordCoreAPI::OnChannelDeletionData> dataPackage{
-										std::make_unique<DiscordCoreAPI::OnChannelDeletionData>(message, dValue)
-									};
-									if (this->discordCoreClient->eventManager.onChannelDeletionEvent.functions.size() > 0) {
-										this->discordCoreClient->eventManager.onChannelDeletionEvent(*dataPackage);
-									}
-									break;
-								}
-								case 11: {
-									if (this->discordCoreClient->eventManager.onChannelPinsUpdateEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnChannelPinsUpdateData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnChannelPinsUpdateData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onChannelPinsUpdateEvent(*dataPackage);
-									}
-									break;
-								}
-								case 12: {
-									if (this->discordCoreClient->eventManager.onThreadCreationEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnThreadCreationData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnThreadCreationData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onThreadCreationEvent(*dataPackage);
-									}
-									break;
-								}
-								case 13: {
-									if (this->discordCoreClient->eventManager.onThreadUpdateEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnThreadUpdateData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnThreadUpdateData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onThreadUpdateEvent(*dataPackage);
-									}
-									break;
-								}
-								case 14: {
-									if (this->discordCoreClient->eventManager.onThreadDeletionEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnThreadDeletionData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnThreadDeletionData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onThreadDeletionEvent(*dataPackage);
-									}
-									break;
-								}
-								case 15: {
-									if (this->discordCoreClient->eventManager.onThreadListSyncEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnThreadListSyncData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnThreadListSyncData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onThreadListSyncEvent(*dataPackage);
-									}
-									break;
-								}
-								case 16: {
-									if (this->discordCoreClient->eventManager.onThreadMemberUpdateEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnThreadMemberUpdateData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnThreadMemberUpdateData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onThreadMemberUpdateEvent(*dataPackage);
-									}
-									break;
-								}
-								case 17: {
-									if (this->discordCoreClient->eventManager.onThreadMembersUpdateEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnThreadMembersUpdateData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnThreadMembersUpdateData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onThreadMembersUpdateEvent(*dataPackage);
-									}
-									break;
-								}
-								case 18: {
-									std::unique_ptr<DiscordCoreAPI::OnGuildCreationData> dataPackage{
-										std::make_unique<DiscordCoreAPI::OnGuildCreationData>(message, dValue, this->discordCoreClient)
-									};
-									if (this->discordCoreClient->eventManager.onGuildCreationEvent.functions.size() > 0) {
-										this->discordCoreClient->eventManager.onGuildCreationEvent(*dataPackage);
-									}
-									break;
-								}
-								case 19: {
-									std::unique_ptr<DiscordCoreAPI::OnGuildUpdateData> dataPackage{
-										std::make_unique<DiscordCoreAPI::OnGuildUpdateData>(message, dValue, this->discordCoreClient)
-									};
-									if (this->discordCoreClient->eventManager.onGuildUpdateEvent.functions.size() > 0) {
-										this->discordCoreClient->eventManager.onGuildUpdateEvent(*dataPackage);
-									}
-									break;
-								}
-								case 20: {
-									std::unique_ptr<DiscordCoreAPI::OnGuildDeletionData> dataPackage{
-										std::make_unique<DiscordCoreAPI::OnGuildDeletionData>(message, dValue, this->discordCoreClient)
-									};
-									if (this->discordCoreClient->eventManager.onGuildDeletionEvent.functions.size() > 0) {
-										this->discordCoreClient->eventManager.onGuildDeletionEvent(*dataPackage);
-									}
-									break;
-								}
-								case 21: {
-									if (this->discordCoreClient->eventManager.onGuildBanAddEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnGuildBanAddData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnGuildBanAddData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onGuildBanAddEvent(*dataPackage);
-									}
-									break;
-								}
-								case 22: {
-									if (this->discordCoreClient->eventManager.onGuildBanRemoveEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnGuildBanRemoveData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnGuildBanRemoveData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onGuildBanRemoveEvent(*dataPackage);
-									}
-									break;
-								}
-								case 23: {
-									if (this->discordCoreClient->eventManager.onGuildEmojisUpdateEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnGuildEmojisUpdateData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnGuildEmojisUpdateData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onGuildEmojisUpdateEvent(*dataPackage);
-									}
-									break;
-								}
-								case 24: {
-									if (this->discordCoreClient->eventManager.onGuildStickersUpdateEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnGuildStickersUpdateData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnGuildStickersUpdateData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onGuildStickersUpdateEvent(*dataPackage);
-									}
-									break;
-								}
-								case 25: {
-									if (this->discordCoreClient->eventManager.onGuildIntegrationsUpdateEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnGuildIntegrationsUpdateData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnGuildIntegrationsUpdateData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onGuildIntegrationsUpdateEvent(*dataPackage);
-									}
-									break;
-								}
-								case 26: {
-									std::unique_ptr<DiscordCoreAPI::OnGuildMemberAddData> dataPackage{
-										std::make_unique<DiscordCoreAPI::OnGuildMemberAddData>(message, dValue, this->discordCoreClient)
-									};
-									if (this->discordCoreClient->eventManager.onGuildMemberAddEvent.functions.size() > 0) {
-										this->discordCoreClient->eventManager.onGuildMemberAddEvent(*dataPackage);
-									}
-									break;
-								}
-								case 27: {
-									std::unique_ptr<DiscordCoreAPI::OnGuildMemberRemoveData> dataPackage{
-										std::make_unique<DiscordCoreAPI::OnGuildMemberRemoveData>(message, dValue, this->discordCoreClient)
-									};
-									if (this->discordCoreClient->eventManager.onGuildMemberRemoveEvent.functions.size() > 0) {
-										this->discordCoreClient->eventManager.onGuildMemberRemoveEvent(*dataPackage);
-									}
-									break;
-								}
-								case 28: {
-									std::unique_ptr<DiscordCoreAPI::OnGuildMemberUpdateData> dataPackage{
-										std::make_unique<DiscordCoreAPI::OnGuildMemberUpdateData>(message, dValue, this->discordCoreClient)
-									};
-									if (this->discordCoreClient->eventManager.onGuildMemberUpdateEvent.functions.size() > 0) {
-										this->discordCoreClient->eventManager.onGuildMemberUpdateEvent(*dataPackage);
-									}
-									break;
-								}
-								case 29: {
-									if (this->discordCoreClient->eventManager.onGuildMembersChunkEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnGuildMembersChunkData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnGuildMembersChunkData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onGuildMembersChunkEvent(*dataPackage);
-									}
-									break;
-								}
-								case 30: {
-									std::unique_ptr<DiscordCoreAPI::OnRoleCreationData> dataPackage{
-										std::make_unique<DiscordCoreAPI::OnRoleCreationData>(message, dValue)
-									};
-									if (this->discordCoreClient->eventManager.onRoleCreationEvent.functions.size() > 0) {
-										this->discordCoreClient->eventManager.onRoleCreationEvent(*dataPackage);
-									}
-									break;
-								}
-								case 31: {
-									std::unique_ptr<DiscordCoreAPI::OnRoleUpdateData> dataPackage{ std::make_unique<DiscordCoreAPI::OnRoleUpdateData>(
-										message, dValue) };
-									if (this->discordCoreClient->eventManager.onRoleUpdateEvent.functions.size() > 0) {
-										this->discordCoreClient->eventManager.onRoleUpdateEvent(*dataPackage);
-									}
-									break;
-								}
-								case 32: {
-									std::unique_ptr<DiscordCoreAPI::OnRoleDeletionData> dataPackage{
-										std::make_unique<DiscordCoreAPI::OnRoleDeletionData>(message, dValue)
-									};
-									if (this->discordCoreClient->eventManager.onRoleDeletionEvent.functions.size() > 0) {
-										this->discordCoreClient->eventManager.onRoleDeletionEvent(*dataPackage);
-									}
-									break;
-								}
-								case 33: {
-									if (this->discordCoreClient->eventManager.onGuildScheduledEventCreationEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnGuildScheduledEventCreationData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnGuildScheduledEventCreationData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onGuildScheduledEventCreationEvent(*dataPackage);
-									}
-									break;
-								}
-								case 34: {
-									if (this->discordCoreClient->eventManager.onGuildScheduledEventUpdateEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnGuildScheduledEventUpdateData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnGuildScheduledEventUpdateData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onGuildScheduledEventUpdateEvent(*dataPackage);
-									}
-									break;
-								}
-								case 35: {
-									if (this->discordCoreClient->eventManager.onGuildScheduledEventDeletionEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnGuildScheduledEventDeletionData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnGuildScheduledEventDeletionData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onGuildScheduledEventDeletionEvent(*dataPackage);
-									}
-									break;
-								}
-								case 36: {
-									if (this->discordCoreClient->eventManager.onGuildScheduledEventUserAddEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnGuildScheduledEventUserAddData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnGuildScheduledEventUserAddData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onGuildScheduledEventUserAddEvent(*dataPackage);
-									}
-									break;
-								}
-								case 37: {
-									if (this->discordCoreClient->eventManager.onGuildScheduledEventUserRemoveEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnGuildScheduledEventUserRemoveData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnGuildScheduledEventUserRemoveData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onGuildScheduledEventUserRemoveEvent(*dataPackage);
-									}
-									break;
-								}
-								case 38: {
-									if (this->discordCoreClient->eventManager.onIntegrationCreationEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnIntegrationCreationData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnIntegrationCreationData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onIntegrationCreationEvent(*dataPackage);
-									}
-									break;
-								}
-								case 39: {
-									if (this->discordCoreClient->eventManager.onIntegrationUpdateEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnIntegrationUpdateData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnIntegrationUpdateData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onIntegrationUpdateEvent(*dataPackage);
-									}
-									break;
-								}
-								case 40: {
-									if (this->discordCoreClient->eventManager.onIntegrationDeletionEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnIntegrationDeletionData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnIntegrationDeletionData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onIntegrationDeletionEvent(*dataPackage);
-									}
-									break;
-								}
-								case 41: {
-									std::unique_ptr<DiscordCoreAPI::OnInteractionCreationData> dataPackage{
-										std::make_unique<DiscordCoreAPI::OnInteractionCreationData>(message, dValue, this->discordCoreClient)
-									};
-									if (this->discordCoreClient->eventManager.onInteractionCreationEvent.functions.size() > 0) {
-										this->discordCoreClient->eventManager.onInteractionCreationEvent(*dataPackage);
-									}
-									break;
-								}
-								case 42: {
-									if (this->discordCoreClient->eventManager.onInviteCreationEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnInviteCreationData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnInviteCreationData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onInviteCreationEvent(*dataPackage);
-									}
-									break;
-								}
-								case 43: {
-									if (this->discordCoreClient->eventManager.onInviteDeletionEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnInviteDeletionData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnInviteDeletionData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onInviteDeletionEvent(*dataPackage);
-									}
-									break;
-								}
-								case 44: {
-									std::unique_ptr<DiscordCoreAPI::OnMessageCreationData> dataPackage{
-										std::make_unique<DiscordCoreAPI::OnMessageCreationData>(message, dValue)
-									};
-									if (this->discordCoreClient->eventManager.onMessageCreationEvent.functions.size() > 0) {
-										this->discordCoreClient->eventManager.onMessageCreationEvent(*dataPackage);
-									}
-									break;
-								}
-								case 45: {
-									std::unique_ptr<DiscordCoreAPI::OnMessageUpdateData> dataPackage{
-										std::make_unique<DiscordCoreAPI::OnMessageUpdateData>(message, dValue)
-									};
-									if (this->discordCoreClient->eventManager.onMessageUpdateEvent.functions.size() > 0) {
-										this->discordCoreClient->eventManager.onMessageUpdateEvent(*dataPackage);
-									}
-									break;
-								}
-								case 46: {
-									if (this->discordCoreClient->eventManager.onMessageDeletionEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnMessageDeletionData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnMessageDeletionData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onMessageDeletionEvent(*dataPackage);
-									}
-									break;
-								}
-								case 47: {
-									if (this->discordCoreClient->eventManager.onMessageDeleteBulkEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnMessageDeleteBulkData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnMessageDeleteBulkData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onMessageDeleteBulkEvent(*dataPackage);
-									}
-									break;
-								}
-								case 48: {
-									if (this->discordCoreClient->eventManager.onReactionAddEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnReactionAddData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnReactionAddData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onReactionAddEvent(*dataPackage);
-									}
-									break;
-								}
-								case 49: {
-									if (this->discordCoreClient->eventManager.onReactionRemoveEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnReactionRemoveData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnReactionRemoveData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onReactionRemoveEvent(*dataPackage);
-									}
-									break;
-								}
-								case 50: {
-									if (this->discordCoreClient->eventManager.onReactionRemoveAllEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnReactionRemoveAllData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnReactionRemoveAllData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onReactionRemoveAllEvent(*dataPackage);
-									}
-									break;
-								}
-								case 51: {
-									if (this->discordCoreClient->eventManager.onReactionRemoveEmojiEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnReactionRemoveEmojiData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnReactionRemoveEmojiData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onReactionRemoveEmojiEvent(*dataPackage);
-									}
-									break;
-								}
-								case 52: {
-									if (this->discordCoreClient->eventManager.onPresenceUpdateEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnPresenceUpdateData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnPresenceUpdateData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onPresenceUpdateEvent(*dataPackage);
-									}
-									break;
-								}
-								case 53: {
-									if (this->discordCoreClient->eventManager.onStageInstanceCreationEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnStageInstanceCreationData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnStageInstanceCreationData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onStageInstanceCreationEvent(*dataPackage);
-									}
-									break;
-								}
-								case 54: {
-									if (this->discordCoreClient->eventManager.onStageInstanceUpdateEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnStageInstanceUpdateData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnStageInstanceUpdateData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onStageInstanceUpdateEvent(*dataPackage);
-									}
-									break;
-								}
-								case 55: {
-									if (this->discordCoreClient->eventManager.onStageInstanceDeletionEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnStageInstanceDeletionData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnStageInstanceDeletionData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onStageInstanceDeletionEvent(*dataPackage);
-									}
-									break;
-								}
-								case 56: {
-									if (this->discordCoreClient->eventManager.onTypingStartEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnTypingStartData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnTypingStartData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onTypingStartEvent(*dataPackage);
-									}
-									break;
-								}
-								case 57: {
-									if (this->discordCoreClient->eventManager.onUserUpdateEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnUserUpdateData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnUserUpdateData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onUserUpdateEvent(*dataPackage);
-									}
-									break;
-								}
-								case 58: {
-									std::unique_ptr<DiscordCoreAPI::OnVoiceStateUpdateData> dataPackage{
-										std::make_unique<DiscordCoreAPI::OnVoiceStateUpdateData>(message, dValue, this)
-									};
-									if (this->discordCoreClient->eventManager.onVoiceStateUpdateEvent.functions.size() > 0) {
-										this->discordCoreClient->eventManager.onVoiceStateUpdateEvent(*dataPackage);
-									}
-									break;
-								}
-								case 59: {
-									std::unique_ptr<DiscordCoreAPI::OnVoiceServerUpdateData> dataPackage{
-										std::make_unique<DiscordCoreAPI::OnVoiceServerUpdateData>(message, dValue, this)
-									};
-									if (this->discordCoreClient->eventManager.onVoiceServerUpdateEvent.functions.size() > 0) {
-										this->discordCoreClient->eventManager.onVoiceServerUpdateEvent(*dataPackage);
-									}
-									break;
-								}
-								case 60: {
-									if (this->discordCoreClient->eventManager.onWebhookUpdateEvent.functions.size() > 0) {
-										std::unique_ptr<DiscordCoreAPI::OnWebhookUpdateData> dataPackage{
-											std::make_unique<DiscordCoreAPI::OnWebhookUpdateData>(message, dValue)
-										};
-										this->discordCoreClient->eventManager.onWebhookUpdateEvent(*dataPackage);
-									}
-									break;
-								}
-							}
+							this->onJsonDispatch(eventType, decodeMode, message, dValue);
+							this->dispatchLatency.record(std::chrono::steady_clock::now() - receivedTime);
 						}
 						break;
 					}
@@ -1098,6 +2159,10 @@ namespace DiscordCoreInternal {
 							this->heartBeatStopWatch = DiscordCoreAPI::StopWatch<Milliseconds>{ Milliseconds{ data.heartbeatInterval } };
 							this->heartBeatStopWatch.resetTimer();
 							this->haveWeReceivedHeartbeatAck = true;
+							if (this->timerWheel) {
+								this->timerWheel->schedule(this->shard[0], TimerType::Heartbeat, this->timerGeneration.load(),
+									Milliseconds{ data.heartbeatInterval });
+							}
 						}
 						if (this->areWeResuming) {
 							WebSocketResumeData data{};
@@ -1111,12 +2176,18 @@ namespace DiscordCoreInternal {
 								serializer.refreshString(DiscordCoreAPI::JsonifierSerializeType::Json);
 							}
 							std::string string = serializer.operator std::string();
-							this->createHeader(string, this->dataOpCode);
-							if (!this->sendMessage(string, true)) {
+							if (!this->sendMessage(string, this->dataOpCode, true)) {
 								return false;
 							}
 							this->currentState.store(WebSocketState::Sending_Identify);
 						} else {
+							// The window was taken when the shard connected, and now starts over from the identify itself.
+							IdentifyBucket& identifyBucket =
+								this->discordCoreClient->identifyBuckets[this->shard[0] % this->discordCoreClient->maxConcurrency];
+							std::unique_lock bucketLock{ identifyBucket.accessMutex };
+							identifyBucket.stopWatch.resetTimer();
+							identifyBucket.haveWeIdentified = true;
+							bucketLock.unlock();
 							WebSocketIdentifyData data{};
 							data.botToken = this->configManager->getBotToken();
 							data.currentShard = this->shard[0];
@@ -1130,8 +2201,7 @@ namespace DiscordCoreInternal {
 								serializer.refreshString(DiscordCoreAPI::JsonifierSerializeType::Json);
 							}
 							std::string string = serializer.operator std::string();
-							this->createHeader(string, this->dataOpCode);
-							if (!this->sendMessage(string, true)) {
+							if (!this->sendMessage(string, this->dataOpCode, true)) {
 								return false;
 							}
 							this->currentState.store(WebSocketState::Sending_Identify);
@@ -1139,6 +2209,9 @@ namespace DiscordCoreInternal {
 						break;
 					}
 					case WebSocketOpCodes::Heartbeat_ACK: {
+						if (!this->haveWeReceivedHeartbeatAck) {
+							this->heartbeatRoundTrip.record(std::chrono::steady_clock::now() - this->heartbeatSentTime);
+						}
 						this->haveWeReceivedHeartbeatAck = true;
 						break;
 					}
@@ -1159,19 +2232,216 @@ namespace DiscordCoreInternal {
 		return false;
 	}
 
+	bool WebSocketClient::sendMessage(std::string_view dataToSend, WebSocketOpCode opCode, bool priority) noexcept {
+		if (opCode != this->dataOpCode) {
+			return WebSocketCore::sendMessage(dataToSend, opCode, priority);
+		}
+		return this->sendMessage(dataToSend, priority ? SendLane::Control : SendLane::State_Update);
+	}
+
+	bool WebSocketClient::sendMessage(std::string_view dataToSend, SendLane lane) noexcept {
+		if (dataToSend.size() == 0 || !this->areWeStillConnected()) {
+			return false;
+		}
+		{
+			std::unique_lock lock{ this->sendMutex };
+			auto& queue = this->sendLanes[std::to_underlying(lane)];
+			if (queue.size() >= laneCapacities[std::to_underlying(lane)]) {
+				++this->sendQueueDrops;
+				return false;
+			}
+			char header[maxFrameHeaderSize]{};
+			uint64_t headerSize{ WebSocketCore::createHeader(header, dataToSend.size(), this->dataOpCode) };
+			std::string frame{};
+			frame.reserve(headerSize + dataToSend.size());
+			frame.append(header, headerSize);
+			frame.append(dataToSend);
+			queue.emplace_back(std::move(frame));
+			++this->sendQueueDepth;
+		}
+		if (lane == SendLane::Control) {
+			return this->flushSendQueue();
+		}
+		// The other lanes are mostly fed from outside of the agent's thread, so leave the writing to it.
+#ifdef __linux__
+		if (this->epoll) {
+			this->epoll->wakeUp();
+		}
+	#ifdef DCA_IO_URING
+		if (this->ioUring) {
+			this->ioUring->wakeUp();
+		}
+	#endif
+#endif
+		return true;
+	}
+
+	bool WebSocketClient::flushSendQueue() noexcept {
+		if (this->sendQueueDepth.load() == 0) {
+			return true;
+		}
+		std::unique_lock lock{ this->sendMutex };
+		auto timeNow = std::chrono::steady_clock::now();
+		std::chrono::duration<double> timeElapsed{ timeNow - this->lastTokenRefill };
+		this->sendTokens = std::min(sendTokenCapacity, this->sendTokens + timeElapsed.count() * sendTokensPerSecond);
+		this->lastTokenRefill = timeNow;
+		// Discord drops anything but an identify or a resume until the session is up.
+		uint64_t laneCount{ this->currentState.load() == WebSocketState::Authenticated ? this->sendLanes.size() : 1 };
+		bool doWePrint{ this->configManager->doWePrintWebSocketSuccessMessages() };
+		std::vector<std::string> bufferedFrames{};///< Only kept for printing, once they have been written.
+		std::string writeBuffer{};
+		uint64_t framesInBuffer{};
+		uint64_t writeCount{};
+		auto writeBufferedFrames = [&]() {
+			if (this->writeData(writeBuffer, false) == ProcessIOResult::Error) {
+				// They have already left their lanes, and so go down with the connection.
+				this->sendQueueDrops += framesInBuffer;
+				return false;
+			}
+			for (auto& value: bufferedFrames) {
+				uint8_t payloadLength = static_cast<uint8_t>(value[1]) & ~webSocketMaskBit;
+				uint64_t headerSize{ 2 + webSocketMaskKeySize };
+				headerSize += payloadLength == webSocketPayloadLengthMagicLarge ? 2 : payloadLength == webSocketPayloadLengthMagicHuge ? 8 : 0;
+				cout << DiscordCoreAPI::shiftToBrightBlue()
+					 << "Sending WebSocket [" + std::to_string(this->shard[0]) + "," + std::to_string(this->shard[1]) + "]" +
+						std::string("'s Message: ")
+					 << std::string_view{ value }.substr(headerSize) << DiscordCoreAPI::reset() << endl
+					 << endl;
+			}
+			this->framesSent += framesInBuffer;
+			bufferedFrames.clear();
+			writeBuffer.clear();
+			framesInBuffer = 0;
+			++writeCount;
+			return true;
+		};
+		for (uint64_t x = 0; x < laneCount; ++x) {
+			// The lower lanes leave a few tokens spare, so that a backlog of them can never hold up a heartbeat.
+			double tokenFloor{ x == 0 ? 1.0 : 1.0 + controlTokenReserve };
+			auto& queue = this->sendLanes[x];
+			while (!queue.empty() && this->sendTokens >= tokenFloor) {
+				if (writeBuffer.size() > 0 && writeBuffer.size() + queue.front().size() >= this->maxBufferSize) {
+					if (!writeBufferedFrames()) {
+						return false;
+					}
+				}
+				writeBuffer.append(queue.front());
+				if (doWePrint) {
+					bufferedFrames.emplace_back(std::move(queue.front()));
+				}
+				queue.pop_front();
+				this->sendTokens -= 1.0;
+				--this->sendQueueDepth;
+				++framesInBuffer;
+			}
+		}
+		if (writeBuffer.size() > 0 && !writeBufferedFrames()) {
+			return false;
+		}
+		this->tlsWrites += writeCount;
+		return writeCount == 0 || this->processWriteData();
+	}
+
+	DiscordCoreAPI::GatewaySendQueueData WebSocketClient::getSendQueueData() noexcept {
+		DiscordCoreAPI::GatewaySendQueueData returnData{};
+		returnData.queuedFrames = this->sendQueueDepth.load();
+		// A discarded write buffer slot may have held several packed frames, but is counted as one.
+		returnData.droppedFrames = this->sendQueueDrops.load() + this->outputBufferDrops.load();
+		returnData.sentFrames = this->framesSent.load();
+		returnData.tlsWrites = this->tlsWrites.load();
+		returnData.shardId = this->shard[0];
+		return returnData;
+	}
+
+	DiscordCoreAPI::ShardLatencyData WebSocketClient::getLatencyData() noexcept {
+		DiscordCoreAPI::ShardLatencyData returnData{};
+		returnData.heartbeatRoundTrip = this->heartbeatRoundTrip.getSummary();
+		returnData.dispatchLatency = this->dispatchLatency.getSummary();
+		returnData.frameParseTime = this->frameParseTime.getSummary();
+		returnData.shardId = this->shard[0];
+		return returnData;
+	}
+
+	DiscordCoreAPI::ShardLoadData WebSocketClient::getLoadData() noexcept {
+		DiscordCoreAPI::ShardLoadData returnData{};
+		returnData.processingTime = Nanoseconds{ static_cast<int64_t>(this->processingTime.load()) };
+		returnData.messageCount = this->messagesProcessed.load();
+		returnData.shardId = this->shard[0];
+		return returnData;
+	}
+
+	std::vector<DiscordCoreAPI::EventShedData> WebSocketClient::getEventShedData() noexcept {
+		std::vector<DiscordCoreAPI::EventShedData> returnData{};
+		uint64_t presenceUpdatesCoalescedNew{ this->presenceUpdatesCoalesced.load() };
+		for (auto& [key, value]: this->eventBudgets) {
+			DiscordCoreAPI::EventShedData eventShedData{};
+			eventShedData.droppedForQueueDepth = value.droppedForQueueDepth.load();
+			eventShedData.droppedForRate = value.droppedForRate.load();
+			eventShedData.coalesced = value.coalesced.load();
+			eventShedData.eventType = value.eventName;
+			eventShedData.shardId = this->shard[0];
+			// Those that the presence coalescing window folded away are counted alongside those that the budget did.
+			if (key == GatewayEventType::Presence_Update) {
+				eventShedData.coalesced += presenceUpdatesCoalescedNew;
+				presenceUpdatesCoalescedNew = 0;
+			}
+			returnData.emplace_back(eventShedData);
+		}
+		if (presenceUpdatesCoalescedNew > 0) {
+			DiscordCoreAPI::EventShedData eventShedData{};
+			eventShedData.coalesced = presenceUpdatesCoalescedNew;
+			eventShedData.eventType = "PRESENCE_UPDATE";
+			eventShedData.shardId = this->shard[0];
+			returnData.emplace_back(eventShedData);
+		}
+		return returnData;
+	}
+
 	void WebSocketClient::disconnect() noexcept {
 		if (this->socket != SOCKET_ERROR) {
-			std::string payload = "\x03\xE8";
+			// A 1000 close invalidates the session on Discord's side, so use 4000 when we intend to resume it.
+			std::string payload = this->areWeResuming ? "\x0F\xA0" : "\x03\xE8";
 			this->createHeader(payload, WebSocketOpCode::Op_Close);
 			this->writeData(payload, true);
+			// processWriteData() writes one slot at a time, and the close frame may be queued behind others, so keep on while they get through.
+			auto usedSpace = this->outputBuffer.getUsedSpace();
+			while (usedSpace > 0 && this->processWriteData() && this->outputBuffer.getUsedSpace() < usedSpace) {
+				usedSpace = this->outputBuffer.getUsedSpace();
+			}
+#ifdef __linux__
+			if (this->epoll) {
+				auto epollOld = this->epoll;
+				this->epoll = nullptr;
+				epollOld->removeSocket(this->socket, this);
+				epollOld->wakeUp();
+			}
+	#ifdef DCA_IO_URING
+			if (this->ioUring) {
+				this->ioUring->removeSocket(this);
+				this->ioUring = nullptr;
+			}
+	#endif
+#endif
 			this->socket = SOCKET_ERROR;
 			this->ssl = nullptr;
 			this->currentState.store(WebSocketState::Disconnected);
 			this->areWeConnecting.store(true);
+			this->outputBufferDrops += this->outputBuffer.getUsedSpace();
 			this->outputBuffer.clear();
 			this->inputBuffer.clear();
+			{
+				// The rate limit is per connection, and nothing queued for this one means anything to the next.
+				std::unique_lock lock{ this->sendMutex };
+				for (auto& value: this->sendLanes) {
+					this->sendQueueDrops += value.size();
+					value.clear();
+				}
+				this->sendQueueDepth.store(0);
+				this->sendTokens = sendTokenCapacity;
+			}
 			this->closeCode = 0;
 			this->areWeHeartBeating = false;
+			++this->timerGeneration;
 			this->connections = std::make_unique<DiscordCoreAPI::ConnectionPackage>();
 			this->connections->currentReconnectTries = this->currentReconnectTries;
 			this->connections->areWeResuming = this->areWeResuming;
@@ -1199,31 +2469,64 @@ namespace DiscordCoreInternal {
 		this->currentBaseSocketAgent = currentBaseSocketAgentNew;
 		this->discordCoreClient = discordCoreClientNew;
 		this->doWeQuit = doWeQuitNew;
+#if defined(__linux__) && defined(DCA_IO_URING)
+		uint32_t totalShardCount{ this->configManager->getTotalShardCount() };
+		uint32_t workerCount{ std::max(std::min(totalShardCount, std::thread::hardware_concurrency()), 1u) };
+		this->ioUring.initialize((totalShardCount + workerCount - 1) / workerCount);
+#endif
 		this->taskThread = std::make_unique<std::jthread>([this](std::stop_token token) {
 			this->run(token);
 		});
 	}
 
-	void BaseSocketAgent::connect(DiscordCoreAPI::ConnectionPackage packageNew) noexcept {
-		while (!this->discordCoreClient->isItSafeToConnect.load()) {
-			std::this_thread::sleep_for(1ms);
+	Milliseconds IdentifyBucket::tryTakeWindow() noexcept {
+		std::unique_lock lock{ this->accessMutex };
+		if (this->haveWeIdentified && !this->stopWatch.hasTimePassed()) {
+			return std::max(this->stopWatch.getTotalWaitTime() - this->stopWatch.totalTimePassed(), 1ms);
 		}
-		this->discordCoreClient->isItSafeToConnect.store(false);
+		this->stopWatch.resetTimer();
+		this->haveWeIdentified = true;
+		return 0ms;
+	}
+
+	void BaseSocketAgent::connect(DiscordCoreAPI::ConnectionPackage packageNew) noexcept {
 		if (packageNew.currentShard != -1) {
+			DiscordCoreAPI::ShardStartupData startupData{};
+			startupData.shardId = packageNew.currentShard;
+			startupData.identifyBucket = packageNew.currentShard % this->discordCoreClient->maxConcurrency;
+			IdentifyBucket& identifyBucket = this->discordCoreClient->identifyBuckets[startupData.identifyBucket];
+			// Only identifies count against max_concurrency, so resumes go straight ahead. The others wait out their bucket's window on the
+			// timer wheel, so that the agent's other shards carry on meanwhile. In a cluster the coordinator's buckets, which space out the
+			// identifies of every worker, stand in for this process's own, and their grants are waited for the same way.
+			ClusterClient* clusterClient{ packageNew.areWeResuming ? nullptr : this->discordCoreClient->clusterClient.get() };
+			Milliseconds timeRemaining{ 0ms };
+			if (!packageNew.areWeResuming && !clusterClient) {
+				timeRemaining = identifyBucket.tryTakeWindow();
+			}
+			ClusterIdentifyLock clusterLock{ clusterClient, static_cast<uint32_t>(packageNew.currentShard) };
+			if (!clusterLock) {
+				timeRemaining = clusterGrantPollInterval;
+			}
+			if (timeRemaining > 0ms) {
+				this->identifyQueueStopWatches.try_emplace(packageNew.currentShard, 0ms);
+				this->pendingConnections[packageNew.currentShard] = packageNew;
+				this->timerWheel.schedule(packageNew.currentShard, TimerType::Reconnect, 0, timeRemaining);
+				return;
+			}
+			if (this->identifyQueueStopWatches.contains(packageNew.currentShard)) {
+				startupData.timeSpentQueued = this->identifyQueueStopWatches.at(packageNew.currentShard).totalTimePassed();
+				this->identifyQueueStopWatches.erase(packageNew.currentShard);
+			}
 			if (!this->shardMap.contains(packageNew.currentShard)) {
+				std::unique_lock shardMapLock{ this->shardMapMutex };
 				this->shardMap[packageNew.currentShard] =
 					std::make_unique<WebSocketClient>(this->discordCoreClient, packageNew.currentShard, this->doWeQuit);
 			}
-			this->shardMap[packageNew.currentShard]->currentReconnectTries = packageNew.currentReconnectTries;
-			++this->shardMap[packageNew.currentShard]->currentReconnectTries;
-			std::string connectionUrl =
-				packageNew.areWeResuming ? this->shardMap[packageNew.currentShard]->resumeUrl : this->configManager->getConnectionAddress();
-			bool didWeConnect{};
-			DiscordCoreAPI::StopWatch stopWatch{ 5s };
-			if (stopWatch.hasTimePassed()) {
-				shardMap[packageNew.currentShard]->onClosed();
-				return;
-			}
+			WebSocketClient* shard = this->shardMap[packageNew.currentShard].get();
+			shard->timerWheel = &this->timerWheel;
+			shard->currentReconnectTries = packageNew.currentReconnectTries;
+			++shard->currentReconnectTries;
+			std::string connectionUrl = packageNew.areWeResuming ? shard->resumeUrl : this->configManager->getConnectionAddress();
 			if (this->configManager->doWePrintGeneralSuccessMessages()) {
 				cout << DiscordCoreAPI::shiftToBrightBlue() << "Connecting Shard " + std::to_string(packageNew.currentShard + 1) << " of "
 					 << this->configManager->getShardCountForThisProcess()
@@ -1232,70 +2535,326 @@ namespace DiscordCoreInternal {
 					 << DiscordCoreAPI::reset() << endl
 					 << endl;
 			}
-			this->shardMap[packageNew.currentShard]->currentState.store(WebSocketState::Upgrading);
+			ShardHandshake handshake{};
+			handshake.startupData = startupData;
+			shard->currentState.store(WebSocketState::Upgrading);
 			std::string relativePath{};
 			relativePath = "/?v=10&encoding=";
 			relativePath += this->configManager->getTextFormat() == DiscordCoreAPI::TextFormat::Etf ? "etf" : "json";
-			didWeConnect = this->shardMap[packageNew.currentShard]->connect(connectionUrl, relativePath, this->configManager->getConnectionPort(),
-				this->configManager->doWePrintWebSocketErrorMessages(), false);
-			if (didWeConnect == false) {
+			if (this->configManager->getGatewayCompression() == DiscordCoreAPI::GatewayCompression::Zlib_Stream) {
+				relativePath += "&compress=zlib-stream";
+				shard->zlibDecompressor.initialize();
+			}
+			if (!shard->startConnecting(connectionUrl, relativePath, this->configManager->getConnectionPort(),
+					this->configManager->doWePrintWebSocketErrorMessages(), false)) {
 				if (this->configManager->doWePrintWebSocketErrorMessages()) {
 					cout << DiscordCoreAPI::shiftToBrightRed() << "Connection failed for WebSocket [" << packageNew.currentShard << ","
-						 << this->configManager->getTotalShardCount() << "]"
-						 << " reconnecting in 5 seconds." << DiscordCoreAPI::reset() << endl
+						 << this->configManager->getTotalShardCount() << "]... reconnecting." << DiscordCoreAPI::reset() << endl
 						 << endl;
 				}
-			}
-			stopWatch.resetTimer();
-			while (!this->doWeQuit->load()) {
-				auto result = this->shardMap[packageNew.currentShard]->processIO(10);
-				if (this->shardMap[packageNew.currentShard]->currentState.load() != WebSocketState::Collecting_Hello) {
-					break;
-				}
-				if (result == ProcessIOResult::Error) {
-					if (this->configManager->doWePrintWebSocketErrorMessages()) {
-						cout << DiscordCoreAPI::shiftToBrightRed() << "Connection lost for WebSocket [" + packageNew.currentShard << ","
-							 << this->configManager->getTotalShardCount() << "]... reconnecting.0101" << DiscordCoreAPI::reset() << endl
-							 << endl;
-					}
-					this->shardMap[packageNew.currentShard]->onClosed();
-					this->discordCoreClient->isItSafeToConnect.store(true);
-					return;
+				shard->onClosed();
+				// A connection that never got as far as a socket leaves onClosed() nothing to close, and so nothing to reconnect.
+				if (!shard->connections && shard->maxReconnectTries > shard->currentReconnectTries) {
+					shard->connections = std::make_unique<DiscordCoreAPI::ConnectionPackage>(packageNew);
+					shard->connections->currentReconnectTries = shard->currentReconnectTries;
 				}
-				std::this_thread::sleep_for(1ms);
+				return;
 			}
-			stopWatch.resetTimer();
-			while (!this->doWeQuit->load()) {
-				auto result = this->shardMap[packageNew.currentShard]->processIO(10);
-				if (this->shardMap[packageNew.currentShard]->currentState.load() != WebSocketState::Sending_Identify) {
-					break;
-				}
-				if (result == ProcessIOResult::Error || stopWatch.hasTimePassed()) {
-					if (this->configManager->doWePrintWebSocketErrorMessages()) {
-						cout << DiscordCoreAPI::shiftToBrightRed() << "Connection lost for WebSocket [" + packageNew.currentShard << ","
-							 << this->configManager->getTotalShardCount() << "]... reconnecting. 0202" << DiscordCoreAPI::reset() << endl
-							 << endl;
-					}
-					this->shardMap[packageNew.currentShard]->onClosed();
-					this->discordCoreClient->isItSafeToConnect.store(true);
-					return;
+			// The rest of the handshake is read by the agent's loop along with everything else, and followed by processHandshakes().
+			shard->areWeConnecting.store(false);
+#ifdef __linux__
+	#ifdef DCA_IO_URING
+			if (!shard->setIoUring(&this->ioUring)) {
+				shard->setEpoll(&this->epoll);
+			}
+	#else
+			shard->setEpoll(&this->epoll);
+	#endif
+			shard->updateWriteInterest();
+#endif
+			// The identify goes out with the Hello, and until then the next shard in the cluster's bucket has to wait.
+			handshake.clusterClient = clusterLock.release();
+			this->timerWheel.schedule(packageNew.currentShard, TimerType::Handshake_Timeout, shard->timerGeneration.load(),
+				handshake.timeoutStopWatch.getTotalWaitTime());
+			if (auto handshakeOld = this->handshakes.find(packageNew.currentShard); handshakeOld != this->handshakes.end()) {
+				this->eraseHandshake(handshakeOld);
+			}
+			this->handshakes.emplace(packageNew.currentShard, std::move(handshake));
+		}
+	}
+
+	void BaseSocketAgent::processHandshakes() noexcept {
+		for (auto iterator = this->handshakes.begin(); iterator != this->handshakes.end();) {
+			auto shardIterator = this->shardMap.find(iterator->first);
+			if (shardIterator == this->shardMap.end() || !shardIterator->second->areWeStillConnected()) {
+				iterator = this->eraseHandshake(iterator);
+				continue;
+			}
+			WebSocketClient* shard = shardIterator->second.get();
+			ShardHandshake& handshake = iterator->second;
+			auto currentState = shard->currentState.load();
+			if (!handshake.haveWeReceivedHello && currentState != WebSocketState::Upgrading && currentState != WebSocketState::Collecting_Hello) {
+				handshake.startupData.timeToHello = handshake.startupStopWatch.totalTimePassed();
+				handshake.startupStopWatch.resetTimer();
+				handshake.timeoutStopWatch.resetTimer();
+				handshake.haveWeReceivedHello = true;
+				if (handshake.clusterClient) {
+					handshake.clusterClient->releaseIdentifyWindow(iterator->first);
+					handshake.clusterClient = nullptr;
 				}
-				std::this_thread::sleep_for(1ms);
+				this->timerWheel.schedule(iterator->first, TimerType::Handshake_Timeout, shard->timerGeneration.load(),
+					handshake.timeoutStopWatch.getTotalWaitTime());
+			}
+			if (currentState != WebSocketState::Authenticated) {
+				++iterator;
+				continue;
+			}
+			DiscordCoreAPI::ShardStartupData& startupData = handshake.startupData;
+			startupData.timeToReady = handshake.startupStopWatch.totalTimePassed();
+			startupData.isKernelTlsSendActive = shard->isKernelTlsSendActive();
+			startupData.isKernelTlsReceiveActive = shard->isKernelTlsReceiveActive();
+			if (this->configManager->doWePrintGeneralSuccessMessages()) {
+				cout << DiscordCoreAPI::shiftToBrightGreen() << "Shard " + std::to_string(startupData.shardId + 1) << " came online in "
+					 << (startupData.timeToHello + startupData.timeToReady).count() << "ms, after " << startupData.timeSpentQueued.count()
+					 << "ms queued in identify bucket " << startupData.identifyBucket
+					 << (startupData.isKernelTlsSendActive || startupData.isKernelTlsReceiveActive ? ", with kernel TLS." : ".")
+					 << DiscordCoreAPI::reset() << endl
+					 << endl;
 			}
-			this->shardMap[packageNew.currentShard]->areWeConnecting.store(false);
-			this->discordCoreClient->isItSafeToConnect.store(true);
+			std::unique_lock lock{ this->discordCoreClient->shardStartupMutex };
+			this->discordCoreClient->shardStartupData[startupData.shardId] = startupData;
+			lock.unlock();
+			iterator = this->eraseHandshake(iterator);
+		}
+	}
+
+	std::unordered_map<uint32_t, ShardHandshake>::iterator BaseSocketAgent::eraseHandshake(
+		std::unordered_map<uint32_t, ShardHandshake>::iterator iterator) noexcept {
+		if (iterator->second.clusterClient) {
+			iterator->second.clusterClient->releaseIdentifyWindow(iterator->first);
 		}
+		return this->handshakes.erase(iterator);
 	}
 
 	std::jthread* BaseSocketAgent::getTheTask() noexcept {
 		return this->taskThread.get();
 	}
 
+	std::vector<DiscordCoreAPI::ShardLatencyData> BaseSocketAgent::getLatencyData() noexcept {
+		std::shared_lock lock{ this->shardMapMutex };
+		std::vector<DiscordCoreAPI::ShardLatencyData> returnData{};
+		for (auto& [key, value]: this->shardMap) {
+			returnData.emplace_back(value->getLatencyData());
+			returnData.back().baseSocketAgent = this->currentBaseSocketAgent;
+		}
+		return returnData;
+	}
+
+	std::vector<DiscordCoreAPI::ShardLoadData> BaseSocketAgent::getLoadData() noexcept {
+		std::shared_lock lock{ this->shardMapMutex };
+		std::vector<DiscordCoreAPI::ShardLoadData> returnData{};
+		for (auto& [key, value]: this->shardMap) {
+			returnData.emplace_back(value->getLoadData());
+			returnData.back().baseSocketAgent = this->currentBaseSocketAgent;
+		}
+		return returnData;
+	}
+
+	void BaseSocketAgent::migrateShard(uint32_t shardId, BaseSocketAgent* targetAgent) noexcept {
+		if (!targetAgent || targetAgent == this) {
+			return;
+		}
+		std::unique_lock lock{ this->migrationMutex };
+		this->outgoingShards.emplace_back(shardId, targetAgent);
+		lock.unlock();
+		this->wakeUp();
+	}
+
+	void BaseSocketAgent::processMigrations() noexcept {
+		std::unique_lock lock{ this->migrationMutex };
+		if (this->outgoingShards.size() == 0 && this->incomingShards.size() == 0) {
+			return;
+		}
+		auto outgoingShardsNew = std::move(this->outgoingShards);
+		auto incomingShardsNew = std::move(this->incomingShards);
+		this->outgoingShards.clear();
+		this->incomingShards.clear();
+		lock.unlock();
+		for (auto& [shardId, targetAgent]: outgoingShardsNew) {
+			if (!this->shardMap.contains(shardId)) {
+				continue;
+			}
+			WebSocketClient* shard = this->shardMap[shardId].get();
+			if (shard->currentState.load() != WebSocketState::Authenticated || shard->connections || this->pendingConnections.contains(shardId) ||
+				this->handshakes.contains(shardId)) {
+				continue;
+			}
+#if defined(__linux__) && defined(DCA_IO_URING)
+			// A cancelled read on the ring may already have taken bytes off the socket, which the TLS stream would then be missing.
+			if (shard->ioUring) {
+				continue;
+			}
+#endif
+#ifdef __linux__
+			if (shard->epoll) {
+				shard->epoll->removeSocket(shard->socket, shard);
+				shard->epoll = nullptr;
+			}
+#endif
+			std::unique_lock shardMapLock{ this->shardMapMutex };
+			std::unique_ptr<WebSocketClient> shardNew = std::move(this->shardMap[shardId]);
+			this->shardMap.erase(shardId);
+			shardMapLock.unlock();
+			std::unique_lock targetLock{ targetAgent->migrationMutex };
+			targetAgent->incomingShards.emplace_back(std::move(shardNew));
+			targetLock.unlock();
+			targetAgent->wakeUp();
+		}
+		for (auto& value: incomingShardsNew) {
+			WebSocketClient* shard = value.get();
+			uint32_t shardId{ shard->shard[0] };
+			std::unique_lock shardMapLock{ this->shardMapMutex };
+			this->shardMap[shardId] = std::move(value);
+			shardMapLock.unlock();
+			// Whatever the shard left on its previous agent's wheel is stale now, so its next heartbeat has to be scheduled on this one.
+			shard->timerWheel = &this->timerWheel;
+			uint64_t generation{ ++shard->timerGeneration };
+			if (shard->areWeHeartBeating) {
+				auto timeRemaining = shard->heartBeatStopWatch.getTotalWaitTime() - shard->heartBeatStopWatch.totalTimePassed();
+				this->timerWheel.schedule(shardId, TimerType::Heartbeat, generation, std::max(timeRemaining, 0ms));
+			}
+			if (shard->isItFlushScheduled) {
+				this->timerWheel.schedule(shardId, TimerType::Event_Flush, generation, 0ms);
+			}
+			if (shard->isItPresenceFlushScheduled) {
+				this->timerWheel.schedule(shardId, TimerType::Presence_Flush, generation, 0ms);
+			}
+#ifdef __linux__
+			shard->setEpoll(&this->epoll);
+#endif
+		}
+	}
+
+	void BaseSocketAgent::wakeUp() noexcept {
+#ifdef __linux__
+		this->epoll.wakeUp();
+	#ifdef DCA_IO_URING
+		if (this->ioUring.isItAvailable()) {
+			this->ioUring.wakeUp();
+		}
+	#endif
+#endif
+	}
+
+	int32_t BaseSocketAgent::getMsUntilNextDeadline() noexcept {
+		Milliseconds timeToWait{ this->timerWheel.getTimeUntilNextDeadline(1000ms) };
+		for (auto& [key, value]: this->shardMap) {
+			if (value->connections) {
+				return 0;
+			}
+			if (value->sendQueueDepth.load() > 0) {
+				timeToWait = std::min(timeToWait, Milliseconds{ static_cast<int64_t>(1000.0 / WebSocketClient::sendTokensPerSecond) });
+			}
+		}
+		return static_cast<int32_t>(timeToWait.count());
+	}
+
+	void BaseSocketAgent::onTimerExpired(const TimerEntry& entry) noexcept {
+		// Held events outlive a reconnect, so a flush ignores the generation; only a shard that has moved on leaves its flushes behind.
+		if (entry.type == TimerType::Event_Flush) {
+			if (this->shardMap.contains(entry.shardId)) {
+				this->shardMap[entry.shardId]->flushHeldEvents();
+			}
+			return;
+		}
+		if (entry.type == TimerType::Presence_Flush) {
+			if (this->shardMap.contains(entry.shardId)) {
+				this->shardMap[entry.shardId]->flushHeldPresenceUpdates();
+			}
+			return;
+		}
+		if (entry.type == TimerType::Handshake_Timeout) {
+			auto handshake = this->handshakes.find(entry.shardId);
+			// The timer of the Hello is left to run out after the Hello arrives, and then finds the Ready's deadline still ahead of it.
+			if (handshake == this->handshakes.end() || !handshake->second.timeoutStopWatch.hasTimePassed() ||
+				!this->shardMap.contains(entry.shardId)) {
+				return;
+			}
+			WebSocketClient* shard = this->shardMap[entry.shardId].get();
+			if (entry.generation != shard->timerGeneration.load()) {
+				return;
+			}
+			if (this->configManager->doWePrintWebSocketErrorMessages()) {
+				cout << DiscordCoreAPI::shiftToBrightRed() << "Handshake timed out for WebSocket [" << entry.shardId << ","
+					 << this->configManager->getTotalShardCount() << "]... reconnecting." << DiscordCoreAPI::reset() << endl
+					 << endl;
+			}
+			this->eraseHandshake(handshake);
+			shard->onClosed();
+			return;
+		}
+		if (entry.type == TimerType::Reconnect) {
+			if (this->pendingConnections.contains(entry.shardId)) {
+				DiscordCoreAPI::ConnectionPackage connectionData = this->pendingConnections[entry.shardId];
+				this->pendingConnections.erase(entry.shardId);
+				this->connect(connectionData);
+			}
+			return;
+		}
+		if (!this->shardMap.contains(entry.shardId)) {
+			return;
+		}
+		WebSocketClient* shard = this->shardMap[entry.shardId].get();
+		if (entry.generation != shard->timerGeneration.load() || !shard->areWeStillConnected() || !shard->areWeHeartBeating) {
+			return;
+		}
+		if (!shard->haveWeReceivedHeartbeatAck) {
+			// A whole interval without an acknowledgement means a zombied connection, which is to be dropped and resumed.
+			if (this->configManager->doWePrintWebSocketErrorMessages()) {
+				cout << DiscordCoreAPI::shiftToBrightRed() << "Heartbeat went unacknowledged for WebSocket [" << entry.shardId << ","
+					 << this->configManager->getTotalShardCount() << "]... reconnecting." << DiscordCoreAPI::reset() << endl
+					 << endl;
+			}
+			shard->areWeResuming = true;
+			shard->onClosed();
+			return;
+		}
+		if (!shard->checkForAndSendHeartBeat(true)) {
+			shard->onClosed();
+			return;
+		}
+		DiscordCoreAPI::OnGatewayPingData dataNew{};
+		dataNew.timeUntilNextPing = shard->heartBeatStopWatch.getTotalWaitTime().count();
+		this->discordCoreClient->eventManager.onGatewayPingEvent(dataNew);
+		this->timerWheel.schedule(entry.shardId, TimerType::Heartbeat, entry.generation, shard->heartBeatStopWatch.getTotalWaitTime());
+	}
+
 	void BaseSocketAgent::run(std::stop_token token) noexcept {
 		while (!token.stop_requested() && !this->doWeQuit->load()) {
 			try {
+				// The lock is released for as long as the wait lasts, so that addShards(), saveGatewaySessions() and the like get their turn.
 				std::unique_lock lock{ this->accessMutex };
+#if defined(__linux__) && defined(DCA_IO_URING)
+				std::vector<TCPSSLClient*> result{};
+				if (this->ioUring.isItAvailable()) {
+					// Shards that did not fit on the ring stay on epoll, in which case neither of the two may block for long.
+					auto msToWait = this->getMsUntilNextDeadline();
+					if (this->epoll.getSocketCount() > 0) {
+						msToWait = std::min(msToWait, 1);
+					}
+					result = TCPSSLClient::processIO(this->ioUring, msToWait, &lock);
+					if (this->epoll.getSocketCount() > 0) {
+						auto resultNew = TCPSSLClient::processIO(this->epoll, 0);
+						result.insert(result.end(), resultNew.begin(), resultNew.end());
+					}
+				} else {
+					result = TCPSSLClient::processIO(this->epoll, this->getMsUntilNextDeadline(), &lock);
+				}
+#elif __linux__
+				auto result = TCPSSLClient::processIO(this->epoll, this->getMsUntilNextDeadline(), &lock);
+#else
 				auto result = TCPSSLClient::processIO(this->shardMap);
+#endif
 				for (auto& valueNew: result) {
 					if (this->configManager->doWePrintWebSocketErrorMessages()) {
 						cout << DiscordCoreAPI::shiftToBrightRed() << "Connection lost for WebSocket ["
@@ -1305,37 +2864,64 @@ namespace DiscordCoreInternal {
 					}
 					static_cast<WebSocketClient*>(valueNew)->onClosed();
 				}
+				this->processHandshakes();
+				this->processMigrations();
+				for (auto& value: this->timerWheel.collectExpired()) {
+					this->onTimerExpired(value);
+				}
+#ifndef __linux__
 				bool areWeConnected{};
+#endif
 				for (auto& [key, dValue]: this->shardMap) {
 					if (dValue->connections) {
 						DiscordCoreAPI::ConnectionPackage connectionData = *dValue->connections;
 						dValue->connections.reset(nullptr);
-						this->connect(connectionData);
+						if (connectionData.currentReconnectTries == 0) {
+							this->connect(connectionData);
+						} else {
+							// Back off exponentially between the attempts, so that an outage does not turn into a reconnect storm.
+							Milliseconds backoff{ std::min(1000ll << std::min(connectionData.currentReconnectTries - 1, 5), 30000ll) };
+							this->pendingConnections[key] = connectionData;
+							this->timerWheel.schedule(key, TimerType::Reconnect, 0, backoff);
+						}
 					}
 					if (dValue->areWeStillConnected()) {
-						if (dValue->checkForAndSendHeartBeat()) {
-							DiscordCoreAPI::OnGatewayPingData dataNew{};
-							dataNew.timeUntilNextPing = dValue->heartBeatStopWatch.getTotalWaitTime().count();
-							this->discordCoreClient->eventManager.onGatewayPingEvent(dataNew);
+						if (!dValue->flushSendQueue()) {
+							dValue->onClosed();
+							continue;
 						}
+#ifndef __linux__
 						areWeConnected = true;
+#endif
 					}
 				}
+#ifndef __linux__
 				if (!areWeConnected) {
 					std::this_thread::sleep_for(1ms);
 				}
+#endif
 			} catch (...) {
 				DiscordCoreAPI::reportException("BaseSocketAgent::run()");
 			}
 		}
 	}
 
-	BaseSocketAgent::~BaseSocketAgent() {
+	void BaseSocketAgent::stop() noexcept {
 		if (this->taskThread) {
 			this->taskThread->request_stop();
+#ifdef __linux__
+			this->epoll.wakeUp();
+	#ifdef DCA_IO_URING
+			this->ioUring.wakeUp();
+	#endif
+#endif
 			if (this->taskThread->joinable()) {
 				this->taskThread->join();
 			}
 		}
 	}
+
+	BaseSocketAgent::~BaseSocketAgent() {
+		this->stop();
+	}
 };
\ No newline at end of file